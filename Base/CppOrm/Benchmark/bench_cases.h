@@ -0,0 +1,37 @@
+// cpporm/Benchmark/bench_cases.h
+#ifndef cpporm_BENCH_CASES_H
+#define cpporm_BENCH_CASES_H
+
+#include "bench_harness.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace cpporm {
+class Session;
+
+namespace bench {
+
+// 读用例共用的数据规模
+inline constexpr size_t kSeedUsers = 10'000;
+inline constexpr size_t kPostsPerUser = 10;
+inline constexpr size_t kPreloadUsers = 200;
+inline constexpr size_t kFindRows = 1'000;
+inline constexpr size_t kCreateBatchRows = 100'000;
+
+// 建表并写入 kSeedUsers 个用户及各自的 kPostsPerUser 篇文章
+Error seedReadFixture(Session &session);
+
+// RowMapper 逐行映射，以及只做 next() 的对照组
+std::vector<BenchCase> mappingCases(Session &session);
+// 典型构建器的 buildSelectSQL，分别在 SQL 缓存开启和关闭时测量
+std::vector<BenchCase> sqlBuildCases(Session &session);
+// Find（含 Preload）与 Count
+std::vector<BenchCase> readCases(Session &session);
+// CreateBatch kCreateBatchRows 行
+std::vector<BenchCase> writeCases(Session &session);
+
+} // namespace bench
+} // namespace cpporm
+
+#endif // cpporm_BENCH_CASES_H
@@ -0,0 +1,55 @@
+// cpporm/Benchmark/bench_fixture.cpp
+#include "bench_cases.h"
+#include "bench_models.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+Error seedReadFixture(Session &session) {
+  Error err = session.AutoMigrate({&BenchUser::getModelMeta(),
+                                   &BenchPost::getModelMeta(),
+                                   &BenchEvent::getModelMeta()},
+                                  /*force=*/true);
+  if (err)
+    return err;
+
+  // 内存库每次启动都是空表，自增主键从 1 开始
+  std::vector<std::unique_ptr<BenchUser>> users;
+  users.reserve(kSeedUsers);
+  for (size_t i = 0; i < kSeedUsers; ++i) {
+    auto user = std::make_unique<BenchUser>();
+    user->name = "user_" + std::to_string(i);
+    user->email = "user_" + std::to_string(i) + "@example.com";
+    user->age = static_cast<int>(18 + i % 60);
+    user->score = static_cast<double>(i % 1000) / 10.0;
+    user->active = i % 3 != 0;
+    users.push_back(std::move(user));
+  }
+  auto users_result = session.CreateBatch(users);
+  if (!users_result)
+    return users_result.error();
+
+  std::vector<std::unique_ptr<BenchPost>> posts;
+  posts.reserve(kSeedUsers * kPostsPerUser);
+  for (size_t i = 0; i < kSeedUsers; ++i) {
+    for (size_t j = 0; j < kPostsPerUser; ++j) {
+      auto post = std::make_unique<BenchPost>();
+      post->user_id = static_cast<long long>(i + 1);
+      post->title = "post " + std::to_string(j) + " of user " +
+                    std::to_string(i);
+      post->body = std::string(200, static_cast<char>('a' + j % 26));
+      posts.push_back(std::move(post));
+    }
+  }
+  auto posts_result = session.CreateBatch(posts);
+  if (!posts_result)
+    return posts_result.error();
+  return make_ok();
+}
+
+} // namespace bench
+} // namespace cpporm
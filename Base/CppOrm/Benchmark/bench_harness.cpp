@@ -0,0 +1,128 @@
+// cpporm/Benchmark/bench_harness.cpp
+#include "bench_harness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> g_alloc_count{0};
+std::atomic<uint64_t> g_alloc_bytes{0};
+
+} // namespace
+
+// 替换全局 operator new 以统计分配；数组与 nothrow 版本的默认实现都会
+// 转调这里，对齐版本不计入。
+void *operator new(std::size_t size) {
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+  g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace cpporm {
+namespace bench {
+
+uint64_t allocationCount() {
+  return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+uint64_t allocationBytes() {
+  return g_alloc_bytes.load(std::memory_order_relaxed);
+}
+
+BenchState::BenchState(uint64_t ops) : ops_(ops) {}
+
+void BenchState::pause() {
+  if (!running_)
+    return;
+  elapsed_ns_ += (Clock::now() - started_).count();
+  alloc_count_ += allocationCount() - alloc_count_started_;
+  alloc_bytes_ += allocationBytes() - alloc_bytes_started_;
+  running_ = false;
+}
+
+void BenchState::resume() {
+  if (running_)
+    return;
+  alloc_count_started_ = allocationCount();
+  alloc_bytes_started_ = allocationBytes();
+  running_ = true;
+  started_ = Clock::now();
+}
+
+void BenchState::start() { resume(); }
+
+void BenchState::stop() { pause(); }
+
+BenchResult BenchRunner::run(const BenchCase &bench_case,
+                             const BenchOptions &options) {
+  constexpr uint64_t kMaxOps = 1'000'000'000;
+  const int64_t min_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(options.min_time)
+          .count();
+
+  BenchResult result;
+  result.name = bench_case.name;
+
+  uint64_t ops = 1;
+  while (true) {
+    BenchState state(ops);
+    state.start();
+    Error err = bench_case.body(state);
+    state.stop();
+    if (err) {
+      result.error = std::move(err);
+      return result;
+    }
+
+    if (state.elapsed_ns_ >= min_ns || ops >= kMaxOps) {
+      const double n = static_cast<double>(ops);
+      result.ops = ops;
+      result.ns_per_op = static_cast<double>(state.elapsed_ns_) / n;
+      if (state.items_per_op_ > 0)
+        result.ns_per_item =
+            result.ns_per_op / static_cast<double>(state.items_per_op_);
+      result.allocs_per_op = static_cast<double>(state.alloc_count_) / n;
+      result.bytes_per_op = static_cast<double>(state.alloc_bytes_) / n;
+      return result;
+    }
+
+    // 按目标时间的 1.2 倍估算，单轮最多放大 100 倍
+    const int64_t per_op_ns =
+        std::max<int64_t>(1, state.elapsed_ns_ / static_cast<int64_t>(ops));
+    uint64_t next = static_cast<uint64_t>(min_ns * 6 / 5 / per_op_ns);
+    next = std::clamp(next, ops + 1, ops * 100);
+    ops = std::min(next, kMaxOps);
+  }
+}
+
+void printHeader() {
+  std::printf("%-40s %12s %14s %12s %12s %14s\n", "benchmark", "ops", "ns/op",
+              "ns/row", "allocs/op", "bytes/op");
+}
+
+void printResult(const BenchResult &result) {
+  if (result.error) {
+    std::printf("%-40s FAILED: %s\n", result.name.c_str(),
+                result.error.toString().c_str());
+    return;
+  }
+  char per_item[32] = "-";
+  if (result.ns_per_item > 0)
+    std::snprintf(per_item, sizeof(per_item), "%.1f", result.ns_per_item);
+  std::printf("%-40s %12llu %14.1f %12s %12.1f %14.1f\n", result.name.c_str(),
+              static_cast<unsigned long long>(result.ops), result.ns_per_op,
+              per_item, result.allocs_per_op, result.bytes_per_op);
+}
+
+} // namespace bench
+} // namespace cpporm
@@ -0,0 +1,91 @@
+// cpporm/Benchmark/bench_harness.h
+#ifndef cpporm_BENCH_HARNESS_H
+#define cpporm_BENCH_HARNESS_H
+
+#include "cpporm/error.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+// 每个用例的 body 执行 state.ops() 次操作；准备数据等不应计入的部分
+// 用 pause()/resume() 包起来（分配计数同样暂停）。
+class BenchState {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit BenchState(uint64_t ops);
+
+  uint64_t ops() const { return ops_; }
+
+  void pause();
+  void resume();
+
+  // 每次操作处理的行数，用于额外输出 ns/row（默认 0 表示不输出）
+  void setItemsPerOp(uint64_t items) { items_per_op_ = items; }
+
+private:
+  friend struct BenchRunner;
+
+  void start();
+  void stop();
+
+  const uint64_t ops_;
+  uint64_t items_per_op_ = 0;
+  bool running_ = false;
+  Clock::time_point started_;
+  int64_t elapsed_ns_ = 0;
+  uint64_t alloc_count_started_ = 0;
+  uint64_t alloc_bytes_started_ = 0;
+  uint64_t alloc_count_ = 0;
+  uint64_t alloc_bytes_ = 0;
+};
+
+using BenchBody = std::function<Error(BenchState &)>;
+
+struct BenchCase {
+  std::string name;
+  BenchBody body;
+};
+
+struct BenchResult {
+  std::string name;
+  uint64_t ops = 0;
+  double ns_per_op = 0;
+  double ns_per_item = 0; // items_per_op 为 0 时不输出
+  double allocs_per_op = 0;
+  double bytes_per_op = 0;
+  Error error;
+};
+
+struct BenchOptions {
+  // 总计时达到该值后停止加大 ops
+  std::chrono::milliseconds min_time{500};
+  // 名称包含该子串的用例才运行；空表示全部
+  std::string filter;
+};
+
+// 以 ops = 1 起步，按上一轮的单次耗时估算下一轮次数，直到总计时不少于
+// min_time（同 Go testing.B 的做法）。
+struct BenchRunner {
+  static BenchResult run(const BenchCase &bench_case,
+                         const BenchOptions &options);
+};
+
+// 进程内 operator new 的累计次数与字节数。QString/QVariant 等 Qt 容器的
+// 数据块直接走 malloc，不在统计之内。
+uint64_t allocationCount();
+uint64_t allocationBytes();
+
+void printHeader();
+void printResult(const BenchResult &result);
+
+} // namespace bench
+} // namespace cpporm
+
+#endif // cpporm_BENCH_HARNESS_H
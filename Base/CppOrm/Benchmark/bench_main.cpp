@@ -0,0 +1,99 @@
+// cpporm/Benchmark/bench_main.cpp
+//
+// 用法: cpporm_bench [--filter <子串>] [--min-time-ms <毫秒>]
+//
+// 全部用例跑在 QSQLITE 内存库上，不依赖外部服务。数值只用于同一台机器上
+// 的前后对比；请用 Release 构建，并去掉顶层 CMakeLists 中的 ASan 选项。
+#include "bench_cases.h"
+#include "bench_harness.h"
+#include "cpporm/qt_db_manager.h"
+#include "cpporm/session.h"
+
+#include <QCoreApplication>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool parseArgs(int argc, char **argv, cpporm::bench::BenchOptions &options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--filter" && i + 1 < argc) {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time-ms" && i + 1 < argc) {
+      options.min_time = std::chrono::milliseconds(std::atoll(argv[++i]));
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--filter <substring>] [--min-time-ms <ms>]\n",
+                   argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace cpporm;
+
+  QCoreApplication app(argc, argv);
+  bench::BenchOptions options;
+  if (!parseArgs(argc, argv, options))
+    return 2;
+
+#ifndef NDEBUG
+  std::fprintf(stderr, "warning: benchmarks built without NDEBUG\n");
+#endif
+
+  QtDBConfig config;
+  config.driver_name = "QSQLITE";
+  config.database_name = ":memory:";
+  config.host_name.clear();
+  config.user_name.clear();
+  config.port = -1;
+  config.connection_name = "cpporm_bench";
+  auto conn_name = QtDbManager::openDatabase(config);
+  if (!conn_name) {
+    std::fprintf(stderr, "failed to open database: %s\n",
+                 conn_name.error().toString().c_str());
+    return 1;
+  }
+
+  int exit_code = 0;
+  {
+    Session session(*conn_name);
+    if (Error err = bench::seedReadFixture(session)) {
+      std::fprintf(stderr, "failed to seed fixture: %s\n",
+                   err.toString().c_str());
+      exit_code = 1;
+    } else {
+      std::vector<bench::BenchCase> cases;
+      for (auto group : {bench::mappingCases(session),
+                         bench::sqlBuildCases(session),
+                         bench::readCases(session),
+                         bench::writeCases(session)}) {
+        for (bench::BenchCase &bench_case : group)
+          cases.push_back(std::move(bench_case));
+      }
+
+      bench::printHeader();
+      for (const bench::BenchCase &bench_case : cases) {
+        if (!options.filter.empty() &&
+            bench_case.name.find(options.filter) == std::string::npos)
+          continue;
+        bench::BenchResult result =
+            bench::BenchRunner::run(bench_case, options);
+        bench::printResult(result);
+        if (result.error)
+          exit_code = 1;
+      }
+    }
+  }
+
+  QtDbManager::closeDatabase(*conn_name);
+  return exit_code;
+}
@@ -0,0 +1,63 @@
+// cpporm/Benchmark/bench_models.h
+#ifndef cpporm_BENCH_MODELS_H
+#define cpporm_BENCH_MODELS_H
+
+#include "cpporm/model_definition_macros.h"
+#include "cpporm/session.h"
+
+#include <QDateTime>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+class BenchPost;
+
+class BenchUser : public cpporm::Model<BenchUser> {
+public:
+  cpporm_DEFINE_MODEL_CLASS_NAME(BenchUser)
+  cpporm_MODEL_BEGIN(BenchUser, "bench_users")
+  cpporm_AUTO_INCREMENT_PRIMARY_KEY(long long, id, "id")
+  cpporm_FIELD(std::string, name, "name")
+  cpporm_FIELD(std::string, email, "email")
+  cpporm_FIELD(int, age, "age")
+  cpporm_FIELD(double, score, "score")
+  cpporm_FIELD(bool, active, "active")
+  cpporm_TIMESTAMPS(QDateTime)
+  cpporm_ASSOCIATION_FIELD(std::vector<std::shared_ptr<BenchPost>>, posts)
+  cpporm_HAS_MANY(posts, BenchPost, "user_id")
+  cpporm_MODEL_END()
+};
+
+class BenchPost : public cpporm::Model<BenchPost> {
+public:
+  cpporm_DEFINE_MODEL_CLASS_NAME(BenchPost)
+  cpporm_MODEL_BEGIN(BenchPost, "bench_posts")
+  cpporm_AUTO_INCREMENT_PRIMARY_KEY(long long, id, "id")
+  cpporm_FIELD(long long, user_id, "user_id")
+  cpporm_FIELD(std::string, title, "title")
+  cpporm_FIELD(std::string, body, "body")
+  cpporm_INDEX("idx_bench_posts_user_id", "user_id")
+  cpporm_MODEL_END()
+};
+
+// CreateBatch 用例专用，每轮清空，不影响读用例的数据
+class BenchEvent : public cpporm::Model<BenchEvent> {
+public:
+  cpporm_DEFINE_MODEL_CLASS_NAME(BenchEvent)
+  cpporm_MODEL_BEGIN(BenchEvent, "bench_events")
+  cpporm_AUTO_INCREMENT_PRIMARY_KEY(long long, id, "id")
+  cpporm_FIELD(long long, user_id, "user_id")
+  cpporm_FIELD(std::string, kind, "kind")
+  cpporm_FIELD(std::string, payload, "payload")
+  cpporm_FIELD(double, amount, "amount")
+  cpporm_MODEL_END()
+};
+
+} // namespace bench
+} // namespace cpporm
+
+#endif // cpporm_BENCH_MODELS_H
@@ -0,0 +1,141 @@
+// cpporm/Benchmark/bench_read_cases.cpp
+#include "bench_cases.h"
+#include "bench_models.h"
+#include "cpporm/row_mapper.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+#include <memory>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+namespace {
+
+const QString kSelectAllUsers = "SELECT * FROM bench_users";
+
+Error execSelectAllUsers(QSqlQuery &query) {
+  query.setForwardOnly(true);
+  if (!query.exec(kSelectAllUsers))
+    return Error(ErrorCode::QueryExecutionError,
+                 "bench: " + query.lastError().text().toStdString());
+  return make_ok();
+}
+
+// 读到结果集末尾时（暂停计时）重新执行查询，保证能取满 ops 行
+Error nextRow(QSqlQuery &query, BenchState &state) {
+  if (query.next())
+    return make_ok();
+  state.pause();
+  Error err = execSelectAllUsers(query);
+  state.resume();
+  if (err)
+    return err;
+  if (!query.next())
+    return Error(ErrorCode::RecordNotFound, "bench: bench_users is empty");
+  return make_ok();
+}
+
+// 只推进结果集，作为 row_mapping 的对照组：两者之差即映射本身的开销
+Error benchFetchOnly(Session &session, BenchState &state) {
+  state.pause();
+  QSqlQuery query(session.getDbHandle());
+  Error err = execSelectAllUsers(query);
+  state.resume();
+  if (err)
+    return err;
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    if (Error row_err = nextRow(query, state))
+      return row_err;
+  }
+  return make_ok();
+}
+
+Error benchRowMapping(Session &session, BenchState &state) {
+  state.pause();
+  QSqlQuery query(session.getDbHandle());
+  Error err = execSelectAllUsers(query);
+  if (err)
+    return err;
+  const internal::RowMapper mapper(BenchUser::getModelMeta(), query.record());
+  BenchUser user;
+  state.resume();
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    if (Error row_err = nextRow(query, state))
+      return row_err;
+    mapper.mapRow(query, user);
+  }
+  return make_ok();
+}
+
+Error benchFind(Session &session, BenchState &state) {
+  state.setItemsPerOp(kFindRows);
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    std::vector<BenchUser> users;
+    if (Error err = session.Model<BenchUser>()
+                        .Order("id")
+                        .Limit(static_cast<int>(kFindRows))
+                        .Find(&users))
+      return err;
+  }
+  return make_ok();
+}
+
+Error benchFindWithPreload(Session &session, BenchState &state) {
+  state.setItemsPerOp(kPreloadUsers);
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    std::vector<BenchUser> users;
+    if (Error err = session.Model<BenchUser>()
+                        .Where("id <= ?", static_cast<long long>(kPreloadUsers))
+                        .Preload("posts")
+                        .Find(&users))
+      return err;
+  }
+  return make_ok();
+}
+
+Error benchCount(Session &session, BenchState &state) {
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    auto count = session.Model<BenchUser>()
+                     .Where("age > ?", 40)
+                     .Where("active = ?", true)
+                     .Count();
+    if (!count)
+      return count.error();
+  }
+  return make_ok();
+}
+
+} // namespace
+
+std::vector<BenchCase> mappingCases(Session &session) {
+  return {
+      {"mapping/fetch_only",
+       [&session](BenchState &state) {
+         return benchFetchOnly(session, state);
+       }},
+      {"mapping/row_mapper",
+       [&session](BenchState &state) {
+         return benchRowMapping(session, state);
+       }},
+  };
+}
+
+std::vector<BenchCase> readCases(Session &session) {
+  return {
+      {"find/1000_rows",
+       [&session](BenchState &state) { return benchFind(session, state); }},
+      {"find/preload_has_many",
+       [&session](BenchState &state) {
+         return benchFindWithPreload(session, state);
+       }},
+      {"count/where",
+       [&session](BenchState &state) { return benchCount(session, state); }},
+  };
+}
+
+} // namespace bench
+} // namespace cpporm
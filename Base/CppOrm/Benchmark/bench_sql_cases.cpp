@@ -0,0 +1,97 @@
+// cpporm/Benchmark/bench_sql_cases.cpp
+#include "bench_cases.h"
+#include "bench_models.h"
+#include "cpporm/compiled_sql_cache.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+namespace {
+
+using BuilderFactory = std::function<QueryBuilder(Session &)>;
+
+QueryBuilder whereOrderLimit(Session &session) {
+  QueryBuilder qb = session.Model<BenchUser>();
+  qb.Where("age > ?", 30)
+      .Where("name LIKE ?", std::string("user_1%"))
+      .Order("id DESC")
+      .Limit(20)
+      .Offset(40);
+  return qb;
+}
+
+QueryBuilder joinGroupHaving(Session &session) {
+  QueryBuilder qb = session.Model<BenchUser>();
+  qb.Select("bench_users.id, bench_users.name, COUNT(bench_posts.id) AS n")
+      .LeftJoin("bench_posts", "bench_posts.user_id = bench_users.id")
+      .Where("bench_users.active = ?", true)
+      .Group("bench_users.id, bench_users.name")
+      .Having("COUNT(bench_posts.id) > ?", 5)
+      .Order("n DESC");
+  return qb;
+}
+
+QueryBuilder inList200(Session &session) {
+  static const std::vector<long long> ids = [] {
+    std::vector<long long> values;
+    for (long long id = 1; id <= 200; ++id)
+      values.push_back(id);
+    return values;
+  }();
+  QueryBuilder qb = session.Model<BenchUser>();
+  qb.In("id", ids).Order("id");
+  return qb;
+}
+
+// 构建器在计时内创建：实际调用方每次查询都会重新链式构建
+Error benchBuildSelect(Session &session, const BuilderFactory &factory,
+                       bool use_sql_cache, BenchState &state) {
+  state.pause();
+  internal::CompiledSqlCache &cache = internal::CompiledSqlCache::instance();
+  const size_t saved_capacity = cache.capacity();
+  cache.setCapacity(use_sql_cache ? internal::CompiledSqlCache::kDefaultCapacity
+                                  : 0);
+  state.resume();
+
+  size_t total_length = 0;
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    QueryBuilder qb = factory(session);
+    auto [sql, bindings] = qb.buildSelectSQL();
+    total_length += static_cast<size_t>(sql.size() + bindings.size());
+  }
+
+  state.pause();
+  cache.setCapacity(saved_capacity);
+  if (total_length == 0)
+    return Error(ErrorCode::InternalError, "bench: empty SELECT SQL");
+  return make_ok();
+}
+
+void addSqlCase(std::vector<BenchCase> &cases, Session &session,
+                const std::string &name, BuilderFactory factory) {
+  cases.push_back({"sql/" + name + "/cached",
+                   [&session, factory](BenchState &state) {
+                     return benchBuildSelect(session, factory, true, state);
+                   }});
+  cases.push_back({"sql/" + name + "/uncached",
+                   [&session, factory](BenchState &state) {
+                     return benchBuildSelect(session, factory, false, state);
+                   }});
+}
+
+} // namespace
+
+std::vector<BenchCase> sqlBuildCases(Session &session) {
+  std::vector<BenchCase> cases;
+  addSqlCase(cases, session, "where_order_limit", whereOrderLimit);
+  addSqlCase(cases, session, "join_group_having", joinGroupHaving);
+  addSqlCase(cases, session, "in_200", inList200);
+  return cases;
+}
+
+} // namespace bench
+} // namespace cpporm
@@ -0,0 +1,69 @@
+// cpporm/Benchmark/bench_write_cases.cpp
+#include "bench_cases.h"
+#include "bench_models.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+namespace bench {
+
+namespace {
+
+std::vector<std::unique_ptr<BenchEvent>> makeEvents(size_t count) {
+  std::vector<std::unique_ptr<BenchEvent>> events;
+  events.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto event = std::make_unique<BenchEvent>();
+    event->user_id = static_cast<long long>(i % kSeedUsers + 1);
+    event->kind = i % 2 == 0 ? "click" : "view";
+    event->payload = "{\"seq\":" + std::to_string(i) + "}";
+    event->amount = static_cast<double>(i % 100) * 0.25;
+    events.push_back(std::move(event));
+  }
+  return events;
+}
+
+// 每次操作写入 kCreateBatchRows 行；建模型与清表不计时
+Error benchCreateBatch(Session &session, BenchState &state) {
+  state.setItemsPerOp(kCreateBatchRows);
+  for (uint64_t i = 0; i < state.ops(); ++i) {
+    state.pause();
+    auto cleared = session.ExecRaw("DELETE FROM bench_events");
+    if (!cleared)
+      return cleared.error();
+    std::vector<std::unique_ptr<BenchEvent>> events =
+        makeEvents(kCreateBatchRows);
+    state.resume();
+
+    auto created = session.CreateBatch(events);
+    if (!created)
+      return created.error();
+    if (created->size() != kCreateBatchRows)
+      return Error(ErrorCode::InternalError,
+                   "bench: CreateBatch inserted " +
+                       std::to_string(created->size()) + " rows");
+
+    // 模型的析构不属于 CreateBatch 本身
+    state.pause();
+    created->clear();
+    events.clear();
+    state.resume();
+  }
+  return make_ok();
+}
+
+} // namespace
+
+std::vector<BenchCase> writeCases(Session &session) {
+  return {
+      {"create_batch/100k_rows",
+       [&session](BenchState &state) {
+         return benchCreateBatch(session, state);
+       }},
+  };
+}
+
+} // namespace bench
+} // namespace cpporm
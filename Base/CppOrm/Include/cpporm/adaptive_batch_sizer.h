@@ -0,0 +1,56 @@
+// cpporm/adaptive_batch_sizer.h
+#ifndef cpporm_ADAPTIVE_BATCH_SIZER_H
+#define cpporm_ADAPTIVE_BATCH_SIZER_H
+
+#include <QString>
+#include <QVariant>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+
+namespace cpporm {
+namespace internal {
+
+// 单条语句的驱动上限
+struct DriverBatchLimits {
+  size_t max_placeholders;    // 每条语句最多的绑定参数
+  size_t max_statement_bytes; // 每条语句（含参数）的大致字节上限
+};
+
+DriverBatchLimits batchLimitsForDriver(const QString &driver_name_upper);
+
+// 估计一行绑定值序列化后的字节数（用于 MySQL max_allowed_packet 等上限）
+size_t estimateRowBytes(const std::map<QString, QVariant> &row_values);
+
+// 批量写（create/delete/update）共用的每语句行数计算器。
+// 硬上限由驱动的占位符与报文上限、每行占位符数、每行估计字节数求出；
+// 在此范围内按观测到的语句耗时调节：耗时远低于目标时加倍，
+// 超过目标时按比例缩小。
+class AdaptiveBatchSizer {
+public:
+  static constexpr size_t kInitialRows = 500;
+  static constexpr std::chrono::milliseconds kTargetStatementLatency{250};
+
+  // requested_max_rows 为 0 表示完全自动；否则作为额外上限。
+  // reserved_placeholders 为每条语句固定占用的参数（如 ON CONFLICT 子句）。
+  AdaptiveBatchSizer(const QString &driver_name_upper,
+                     size_t placeholders_per_row,
+                     size_t estimated_bytes_per_row = 0,
+                     size_t requested_max_rows = 0,
+                     size_t reserved_placeholders = 0);
+
+  size_t maxRowsPerStatement() const { return max_rows_; }
+  size_t nextBatchSize() const { return current_rows_; }
+
+  void recordBatch(size_t rows, std::chrono::nanoseconds elapsed);
+
+private:
+  size_t max_rows_;
+  size_t current_rows_;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_ADAPTIVE_BATCH_SIZER_H
@@ -0,0 +1,194 @@
+// cpporm/async_session.h
+#ifndef cpporm_ASYNC_SESSION_H
+#define cpporm_ASYNC_SESSION_H
+
+#include "cpporm/qt_db_pool.h"
+#include "cpporm/session.h"
+
+#include <QString>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cpporm {
+
+struct AsyncSessionOptions {
+  size_t worker_threads = 4;
+};
+
+// 在专用 DB 工作线程上执行 ORM 操作并返回 std::future。
+//
+// 每个任务在工作线程上以 Session(connection_name) 执行，该 Session 从
+// QtDbPool 借用该线程自己的 QSqlDatabase 克隆，因此多个任务（例如互不
+// 依赖的查询）可以在不同连接上并行执行，调用线程不再阻塞在 SQL 延迟上。
+//
+// 连接池必须由调用方事先以 QtDbPool::create(connection_name) 注册，
+// create 不会隐式创建：注册后进程内所有 Session(connection_name) 都改为
+// 借用线程克隆，而 SQLite 的 :memory: 库每个克隆都是一个独立的空库，
+// 这一影响应由调用方显式决定。连接池的 max_connections 应不少于
+// worker_threads，否则多出的工作线程需等待连接。
+//
+// 查询通过 Model<T>() 构建：返回的 QueryBuilder 不绑定执行器，提交后在
+// 工作线程上绑定到该线程的 Session。传入的模型在 future 就绪前不得被
+// 调用方访问。析构时执行完已提交的任务后再退出工作线程；关闭后提交的
+// 任务不会执行，其 future 的 get() 抛出 std::future_error（broken_promise）。
+class AsyncSession {
+public:
+  // connection_name 尚未注册 QtDbPool 时返回 InvalidConfiguration。
+  static std::expected<std::unique_ptr<AsyncSession>, Error>
+  create(const QString &connection_name,
+         const AsyncSessionOptions &options = {});
+
+  ~AsyncSession();
+  AsyncSession(const AsyncSession &) = delete;
+  AsyncSession &operator=(const AsyncSession &) = delete;
+
+  // 在工作线程上以该线程的 Session 调用 fn(Session&)，返回其结果的 future。
+  template <typename F>
+  auto Submit(F &&fn)
+      -> std::future<std::invoke_result_t<std::decay_t<F> &, Session &>>;
+
+  QueryBuilder Model(const ModelMeta &meta) const;
+  template <typename T> QueryBuilder Model() const {
+    static_assert(std::is_base_of<ModelBase, T>::value,
+                  "T must be a descendant of cpporm::ModelBase");
+    return Model(T::getModelMeta());
+  }
+
+  template <typename T>
+  std::future<std::expected<T, Error>> First(QueryBuilder qb);
+  template <typename T>
+  std::future<std::expected<std::vector<T>, Error>> Find(QueryBuilder qb);
+  template <typename T>
+  std::future<std::expected<std::vector<T>, Error>>
+  Pluck(QueryBuilder qb, std::string column);
+  std::future<std::expected<int64_t, Error>> Count(QueryBuilder qb);
+  std::future<std::expected<long long, Error>>
+  Updates(QueryBuilder qb, std::map<std::string, QueryValue> updates);
+  std::future<std::expected<long long, Error>> Delete(QueryBuilder qb);
+
+  // 返回写入（并回填自增主键）后的模型
+  template <typename TModel>
+  std::future<std::expected<TModel, Error>> Create(TModel model);
+  template <typename TModel>
+  std::future<std::expected<std::vector<std::shared_ptr<TModel>>, Error>>
+  CreateBatch(std::vector<std::shared_ptr<TModel>> models,
+              size_t internal_db_batch_size = 0);
+
+  const QString &connectionName() const { return connection_name_; }
+  size_t workerCount() const { return workers_.size(); }
+  size_t pendingTasks() const;
+
+private:
+  using Task = std::function<void(Session &)>;
+
+  AsyncSession(QString connection_name, std::shared_ptr<QtDbPool> pool);
+
+  void start(size_t worker_threads);
+  void enqueue(Task task);
+  void workerLoop();
+
+  const QString connection_name_;
+  std::shared_ptr<QtDbPool> pool_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::deque<Task> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// --- 模板实现 ---
+
+template <typename F>
+auto AsyncSession::Submit(F &&fn)
+    -> std::future<std::invoke_result_t<std::decay_t<F> &, Session &>> {
+  using Result = std::invoke_result_t<std::decay_t<F> &, Session &>;
+  // packaged_task 只能移动，而 Task 需要可复制
+  auto task =
+      std::make_shared<std::packaged_task<Result(Session &)>>(
+          std::forward<F>(fn));
+  std::future<Result> future = task->get_future();
+  enqueue([task](Session &session) { (*task)(session); });
+  return future;
+}
+
+template <typename T>
+std::future<std::expected<T, Error>> AsyncSession::First(QueryBuilder qb) {
+  static_assert(std::is_base_of<ModelBase, T>::value,
+                "T must be a descendant of cpporm::ModelBase");
+  return Submit([qb = std::move(qb)](
+                    Session &session) mutable -> std::expected<T, Error> {
+    qb.BindExecutor(&session, session.getConnectionName());
+    T result;
+    if (Error err = qb.First(&result))
+      return std::unexpected(err);
+    return result;
+  });
+}
+
+template <typename T>
+std::future<std::expected<std::vector<T>, Error>>
+AsyncSession::Find(QueryBuilder qb) {
+  static_assert(std::is_base_of<ModelBase, T>::value,
+                "T must be a descendant of cpporm::ModelBase");
+  return Submit(
+      [qb = std::move(qb)](
+          Session &session) mutable -> std::expected<std::vector<T>, Error> {
+        qb.BindExecutor(&session, session.getConnectionName());
+        std::vector<T> results;
+        if (Error err = qb.Find(&results))
+          return std::unexpected(err);
+        return results;
+      });
+}
+
+template <typename T>
+std::future<std::expected<std::vector<T>, Error>>
+AsyncSession::Pluck(QueryBuilder qb, std::string column) {
+  return Submit([qb = std::move(qb), column = std::move(column)](
+                    Session &session) mutable {
+    qb.BindExecutor(&session, session.getConnectionName());
+    return qb.Pluck<T>(column);
+  });
+}
+
+template <typename TModel>
+std::future<std::expected<TModel, Error>> AsyncSession::Create(TModel model) {
+  static_assert(std::is_base_of<ModelBase, TModel>::value,
+                "TModel must be a descendant of cpporm::ModelBase");
+  return Submit([model = std::move(model)](
+                    Session &session) mutable -> std::expected<TModel, Error> {
+    auto created = session.Create(model);
+    if (!created)
+      return std::unexpected(created.error());
+    return std::move(model);
+  });
+}
+
+template <typename TModel>
+std::future<std::expected<std::vector<std::shared_ptr<TModel>>, Error>>
+AsyncSession::CreateBatch(std::vector<std::shared_ptr<TModel>> models,
+                          size_t internal_db_batch_size) {
+  static_assert(std::is_base_of<ModelBase, TModel>::value,
+                "TModel must be a descendant of cpporm::ModelBase");
+  return Submit([models = std::move(models), internal_db_batch_size](
+                    Session &session) {
+    return session.CreateBatch(models, internal_db_batch_size);
+  });
+}
+
+} // namespace cpporm
+
+#endif // cpporm_ASYNC_SESSION_H
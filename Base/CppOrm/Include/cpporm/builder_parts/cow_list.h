@@ -0,0 +1,73 @@
+#ifndef cpporm_COW_LIST_H
+#define cpporm_COW_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cpporm {
+
+// 写时复制的子句列表。拷贝只增加引用计数；第一次修改时若仍与其他
+// QueryBuilder 共享则先复制出私有副本。读接口与 const std::vector 一致，
+// 并可隐式转换为 const std::vector<T>&。
+template <typename T> class CowList {
+public:
+  using value_type = T;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  CowList() = default;
+  CowList(std::initializer_list<T> il)
+      : items_(std::make_shared<std::vector<T>>(il)) {}
+
+  // --- 读 ---
+  const std::vector<T> &items() const { return items_ ? *items_ : empty_(); }
+  operator const std::vector<T> &() const { return items(); }
+
+  bool empty() const { return !items_ || items_->empty(); }
+  size_t size() const { return items_ ? items_->size() : 0; }
+  const T &operator[](size_t idx) const { return (*items_)[idx]; }
+  const T &back() const { return items_->back(); }
+  const_iterator begin() const { return items().begin(); }
+  const_iterator end() const { return items().end(); }
+
+  // --- 写 ---
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    return mutate_().emplace_back(std::forward<Args>(args)...);
+  }
+  void push_back(const T &value) { mutate_().push_back(value); }
+  void push_back(T &&value) { mutate_().push_back(std::move(value)); }
+  template <typename InputIt> void append(InputIt first, InputIt last) {
+    std::vector<T> &items = mutate_();
+    items.insert(items.end(), first, last);
+  }
+  void clear() {
+    // 共享时直接放弃引用即可，无需复制
+    if (items_ && items_.use_count() == 1)
+      items_->clear();
+    else
+      items_.reset();
+  }
+
+private:
+  std::vector<T> &mutate_() {
+    if (!items_)
+      items_ = std::make_shared<std::vector<T>>();
+    else if (items_.use_count() > 1)
+      items_ = std::make_shared<std::vector<T>>(*items_);
+    return *items_;
+  }
+
+  static const std::vector<T> &empty_() {
+    static const std::vector<T> empty_items;
+    return empty_items;
+  }
+
+  std::shared_ptr<std::vector<T>> items_;
+};
+
+} // namespace cpporm
+
+#endif // cpporm_COW_LIST_H
@@ -103,8 +103,7 @@ public:
   }
   Derived &Where(const std::map<std::string, QueryValue> &conditions) {
     auto mc = mapToConditions(conditions);
-    _state().where_conditions_.insert(_state().where_conditions_.end(),
-                                      std::make_move_iterator(mc.begin()),
+    _state().where_conditions_.append(std::make_move_iterator(mc.begin()),
                                       std::make_move_iterator(mc.end()));
     return static_cast<Derived &>(*this);
   }
@@ -172,8 +171,7 @@ public:
   }
   Derived &Or(const std::map<std::string, QueryValue> &conditions) {
     auto mc = mapToConditions(conditions);
-    _state().or_conditions_.insert(_state().or_conditions_.end(),
-                                   std::make_move_iterator(mc.begin()),
+    _state().or_conditions_.append(std::make_move_iterator(mc.begin()),
                                    std::make_move_iterator(mc.end()));
     return static_cast<Derived &>(*this);
   }
@@ -240,8 +238,7 @@ public:
   }
   Derived &Not(const std::map<std::string, QueryValue> &conditions) {
     auto mc = mapToConditions(conditions);
-    _state().not_conditions_.insert(_state().not_conditions_.end(),
-                                    std::make_move_iterator(mc.begin()),
+    _state().not_conditions_.append(std::make_move_iterator(mc.begin()),
                                     std::make_move_iterator(mc.end()));
     return static_cast<Derived &>(*this);
   }
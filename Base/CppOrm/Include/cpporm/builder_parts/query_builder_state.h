@@ -1,6 +1,7 @@
 #ifndef cpporm_QUERY_BUILDER_STATE_H
 #define cpporm_QUERY_BUILDER_STATE_H
 
+#include "cpporm/builder_parts/cow_list.h"
 #include "cpporm/model_base.h"
 #include <QByteArray>
 #include <QDate>
@@ -160,12 +161,13 @@ struct QueryBuilderState {
       std::string("")}; // Default to empty table name string
 
   // 条件子句
-  std::vector<Condition> where_conditions_; // WHERE 条件列表
-  std::vector<Condition> or_conditions_;    // OR 条件列表
-  std::vector<Condition> not_conditions_; // NOT 条件列表 (通常包装一组AND条件)
+  // 子句列表均为写时复制：从同一原型派生多个 QueryBuilder 时拷贝为 O(1)
+  CowList<Condition> where_conditions_; // WHERE 条件列表
+  CowList<Condition> or_conditions_;    // OR 条件列表
+  CowList<Condition> not_conditions_; // NOT 条件列表 (通常包装一组AND条件)
 
   // SELECT 子句相关
-  std::vector<SelectField> select_fields_{
+  CowList<SelectField> select_fields_{
       std::string("*")};        // 要选择的字段列表 (默认 "*")
   bool apply_distinct_ = false; // 新增: 是否在 SELECT 后应用 DISTINCT
 
@@ -176,10 +178,10 @@ struct QueryBuilderState {
   std::unique_ptr<Condition> having_condition_; // HAVING 条件
 
   // JOIN 子句
-  std::vector<JoinClause> join_clauses_; // JOIN 子句列表
+  CowList<JoinClause> join_clauses_; // JOIN 子句列表
 
   // 预加载
-  std::vector<PreloadRequest> preload_requests_; // 预加载请求列表
+  CowList<PreloadRequest> preload_requests_; // 预加载请求列表
 
   // 作用域控制
   bool apply_soft_delete_scope_ = true; // 是否应用软删除作用域 (默认是)
@@ -188,12 +190,12 @@ struct QueryBuilderState {
   std::unique_ptr<OnConflictClause> on_conflict_clause_; // ON CONFLICT 子句状态
 
   // Common Table Expressions (CTEs)
-  std::vector<CTEState> ctes_; // WITH 子句列表
+  CowList<CTEState> ctes_; // WITH 子句列表
 
   // 默认构造函数
   QueryBuilderState() = default;
 
-  // 拷贝构造函数 (深拷贝)
+  // 拷贝构造函数 (子句列表共享，having/on_conflict 深拷贝)
   QueryBuilderState(const QueryBuilderState &other)
       : model_meta_(other.model_meta_),
         from_clause_source_(other.from_clause_source_),
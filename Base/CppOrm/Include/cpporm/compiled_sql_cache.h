@@ -0,0 +1,54 @@
+// cpporm/compiled_sql_cache.h
+#ifndef cpporm_COMPILED_SQL_CACHE_H
+#define cpporm_COMPILED_SQL_CACHE_H
+
+#include <QString>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace cpporm {
+namespace internal {
+
+// QueryBuilder::buildSelectSQL 生成的 SQL 文本缓存，键为构建器的结构形状
+// （表、选择列、条件字符串、JOIN、ORDER、是否有 LIMIT/OFFSET 等，不含绑定值）。
+// 命中时只需按顺序收集绑定参数，省去字符串拼接、SELECT * 展开与标识符引用。
+// 进程级 LRU，线程安全。
+class CompiledSqlCache {
+public:
+  static constexpr size_t kDefaultCapacity = 512;
+
+  static CompiledSqlCache &instance();
+
+  std::optional<QString> lookup(const std::string &shape_key);
+  void store(const std::string &shape_key, const QString &sql);
+  void clear();
+
+  // 0 表示禁用缓存
+  void setCapacity(size_t capacity);
+  size_t capacity() const;
+  size_t size() const;
+
+private:
+  CompiledSqlCache() = default;
+
+  void trimLocked();
+
+  mutable std::mutex mutex_;
+  size_t capacity_ = kDefaultCapacity;
+  // 最近使用的在前
+  std::list<std::pair<std::string, QString>> lru_;
+  std::unordered_map<std::string,
+                     std::list<std::pair<std::string, QString>>::iterator>
+      index_;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_COMPILED_SQL_CACHE_H
@@ -0,0 +1,122 @@
+// cpporm/field_variant_conversion.h
+#ifndef cpporm_FIELD_VARIANT_CONVERSION_H
+#define cpporm_FIELD_VARIANT_CONVERSION_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+#include <QTime>
+#include <QVariant>
+
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace cpporm {
+namespace internal {
+
+// 可由结果集 QVariant 直接写入的字段类型（与 Session::mapRowToModel
+// 支持的类型一致）。其他类型的字段仍走 std::any 通用路径。
+template <typename T>
+inline constexpr bool is_variant_mappable_v =
+    std::is_same_v<T, int> || std::is_same_v<T, long long> ||
+    std::is_same_v<T, unsigned int> ||
+    std::is_same_v<T, unsigned long long> || std::is_same_v<T, double> ||
+    std::is_same_v<T, float> || std::is_same_v<T, bool> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, QByteArray> ||
+    std::is_same_v<T, QDateTime> || std::is_same_v<T, QDate> ||
+    std::is_same_v<T, QTime>;
+
+// 把一个非 NULL 的 QVariant 转换到 out；转换失败返回 false 且 out 不确定。
+template <typename T>
+bool assignFromVariant(const QVariant &value, T &out) {
+  static_assert(is_variant_mappable_v<T>,
+                "assignFromVariant: unsupported field type");
+  bool ok = false;
+  if constexpr (std::is_same_v<T, int>) {
+    out = value.toInt(&ok);
+  } else if constexpr (std::is_same_v<T, long long>) {
+    out = value.toLongLong(&ok);
+  } else if constexpr (std::is_same_v<T, unsigned int>) {
+    out = value.toUInt(&ok);
+  } else if constexpr (std::is_same_v<T, unsigned long long>) {
+    out = value.toULongLong(&ok);
+  } else if constexpr (std::is_same_v<T, double>) {
+    out = value.toDouble(&ok);
+  } else if constexpr (std::is_same_v<T, float>) {
+    out = value.toFloat(&ok);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    out = value.toBool();
+    ok = true;
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    if (value.typeId() == QMetaType::QByteArray) {
+      // TEXT/BLOB 以字节返回时按 UTF-8 处理
+      const QByteArray ba = value.toByteArray();
+      out.assign(ba.constData(), static_cast<size_t>(ba.size()));
+      ok = true;
+    } else if (value.canConvert<QString>()) {
+      const QByteArray ba = value.toString().toUtf8();
+      out.assign(ba.constData(), static_cast<size_t>(ba.size()));
+      ok = true;
+    }
+  } else if constexpr (std::is_same_v<T, QByteArray>) {
+    out = value.toByteArray();
+    ok = true;
+  } else if constexpr (std::is_same_v<T, QDateTime>) {
+    if (value.canConvert<QDateTime>()) {
+      out = value.toDateTime();
+      ok = true;
+    }
+  } else if constexpr (std::is_same_v<T, QDate>) {
+    if (value.canConvert<QDate>()) {
+      out = value.toDate();
+      ok = true;
+    }
+  } else if constexpr (std::is_same_v<T, QTime>) {
+    if (value.canConvert<QTime>()) {
+      out = value.toTime();
+      ok = true;
+    }
+  }
+  return ok;
+}
+
+template <typename T> struct is_std_optional : std::false_type {};
+template <typename T>
+struct is_std_optional<std::optional<T>> : std::true_type {};
+
+// 投影（Pluck）结果的列类型：可映射类型或其 std::optional
+template <typename T>
+struct is_projectable : std::bool_constant<is_variant_mappable_v<T>> {};
+template <typename T>
+struct is_projectable<std::optional<T>>
+    : std::bool_constant<is_variant_mappable_v<T>> {};
+template <typename T>
+inline constexpr bool is_projectable_v = is_projectable<T>::value;
+
+// 投影列解码：NULL 写为 std::nullopt（std::optional<T>）或 T{}。
+template <typename T>
+bool assignProjectedValue(const QVariant &value, T &out) {
+  static_assert(is_projectable_v<T>,
+                "assignProjectedValue: unsupported column type");
+  if constexpr (is_std_optional<T>::value) {
+    if (value.isNull()) {
+      out.reset();
+      return true;
+    }
+    return assignFromVariant(value, out.emplace());
+  } else {
+    if (value.isNull()) {
+      out = T{};
+      return true;
+    }
+    return assignFromVariant(value, out);
+  }
+}
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_FIELD_VARIANT_CONVERSION_H
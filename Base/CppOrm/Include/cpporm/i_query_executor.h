@@ -7,6 +7,7 @@
 #include "cpporm/builder_parts/query_builder_state.h"
 #include "cpporm/model_base.h" // ModelBase, ModelMeta (ModelBase 也会包含 query_builder_state.h)
 
+#include <QSqlQuery>
 #include <QString>
 #include <QVariant>
 #include <QVariantList>
@@ -49,6 +50,27 @@ public:
                                                    ModelBase &model) = 0;
 
   virtual std::expected<int64_t, Error> CountImpl(const QueryBuilder &qb) = 0;
+
+  // 流式读取：逐行映射并回调，不保留已处理的行。回调返回错误时停止并返回该错误。
+  virtual Error FindEachImpl(
+      const QueryBuilder &qb,
+      std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+      std::function<Error(ModelBase &)> row_callback) = 0;
+
+  // 按主键做键集分页（WHERE pk > last ORDER BY pk LIMIT n），每批结果
+  // 处理 Preload 后交给回调。回调返回错误时停止并返回该错误。
+  virtual Error FindInBatchesImpl(
+      const QueryBuilder &qb, size_t batch_size,
+      std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+      std::function<Error(std::vector<std::unique_ptr<ModelBase>> &)>
+          batch_callback) = 0;
+
+  // 投影读取：按 qb 的 Select 列表执行 SELECT（forward-only），把每一行的
+  // QSqlQuery 直接交给回调，不构造模型、不调用钩子、不处理 Preload。
+  // 回调返回错误时停止并返回该错误。
+  virtual Error
+  ProjectImpl(const QueryBuilder &qb,
+              std::function<Error(const QSqlQuery &)> row_callback) = 0;
 };
 
 } // namespace cpporm
@@ -3,6 +3,7 @@
 #define cpporm_MODEL_BASE_H
 
 #include "cpporm/error.h"
+#include "cpporm/field_variant_conversion.h"
 #include <QDebug>
 #include <algorithm>
 #include <any>
@@ -13,12 +14,14 @@
 #include <mutex>
 #include <string>
 #include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 #include <QByteArray>
 #include <QDate>
 #include <QDateTime>
 #include <QTime>
+#include <QVariant>
 
 namespace cpporm {
 
@@ -59,6 +62,11 @@ struct AssociationMeta {
   std::string primary_key_db_name_on_current_model;
   std::string target_model_pk_db_name;
 
+  // ManyToMany：foreign_key_db_name 为连接表中指向当前模型的列，
+  // 以下为连接表名及其指向目标模型的列
+  std::string join_table_name;
+  std::string join_table_target_key_db_name;
+
   std::function<void(
       void * /* model_instance */,
       std::vector<std::shared_ptr<ModelBase>> & /* associated_models */)>
@@ -120,6 +128,14 @@ inline bool has_flag(FieldFlag flags, FieldFlag flag_to_check) {
           static_cast<uint32_t>(flag_to_check)) != 0;
 }
 
+// 字段在 ModelMeta::fields 中的下标，finalize 后稳定，可代替按名查找。
+using FieldId = size_t;
+inline constexpr FieldId kInvalidFieldId = static_cast<FieldId>(-1);
+
+// 结果集映射专用的类型化 setter：直接把 QVariant 写入成员，不经过 std::any。
+// NULL 写入默认值并返回 true；转换失败时成员被置为默认值并返回 false。
+using FieldVariantSetter = bool (*)(void *, const QVariant &);
+
 // --- Field Metadata ---
 struct FieldMeta {
   std::string db_name;
@@ -131,14 +147,20 @@ struct FieldMeta {
 
   std::function<std::any(const void *)> getter;
   std::function<void(void *, const std::any &)> setter;
+  // 由 cpporm_FIELD 等宏生成；类型不受支持或手工构造的 FieldMeta 为 nullptr，
+  // 此时行映射退回到 setter。
+  FieldVariantSetter variant_setter = nullptr;
+  FieldId field_id = kInvalidFieldId; // 由 ModelMeta::_buildLookupIndexes 填写
 
   FieldMeta(std::string dbName, std::string cppName, std::type_index cppType,
             std::string dbTypeHint = "", FieldFlag fieldFlags = FieldFlag::None,
             std::function<std::any(const void *)> g = nullptr,
-            std::function<void(void *, const std::any &)> s = nullptr)
+            std::function<void(void *, const std::any &)> s = nullptr,
+            FieldVariantSetter vs = nullptr)
       : db_name(std::move(dbName)), cpp_name(std::move(cppName)),
         cpp_type(cppType), db_type_hint(std::move(dbTypeHint)),
-        flags(fieldFlags), getter(std::move(g)), setter(std::move(s)) {}
+        flags(fieldFlags), getter(std::move(g)), setter(std::move(s)),
+        variant_setter(vs) {}
 };
 
 // --- ModelBase Definition ---
@@ -154,6 +176,33 @@ public:
 
   std::any getFieldValue(const std::string &cpp_field_name) const;
   Error setFieldValue(const std::string &cpp_field_name, const std::any &value);
+  // 按 FieldId（ModelMeta::fields 下标）访问，热点路径上免去名称查找
+  std::any getFieldValueById(FieldId field_id) const;
+  Error setFieldValueById(FieldId field_id, const std::any &value);
+
+  // 脏字段跟踪：从数据库加载或写入成功时各列的值，按 FieldId 下标；
+  // 无效 QVariant 表示该列未加载（例如 Select 未选中），isNull() 的
+  // QVariant 表示加载时为数据库 NULL，不与零值等同。为空表示未跟踪，
+  // Save 写入全部列；否则只写入与快照不同的列，全部相同时不发语句。
+  // setFieldValue/setFieldValueById 会把对应字段标记为已修改。
+  std::vector<QVariant> _loaded_values;
+  bool _isDirtyTracked() const { return !_loaded_values.empty(); }
+  void _recordLoadedValue(FieldId field_id, const QVariant &value) {
+    if (field_id >= _loaded_values.size())
+      return;
+    _loaded_values[field_id] = value;
+  }
+  // 直接修改了无法按值比较的内容，或需要强制整行写入时调用
+  void markFieldDirty(FieldId field_id) {
+    _recordLoadedValue(field_id, QVariant());
+  }
+  void markAllDirty() { _loaded_values.clear(); }
+
+private:
+  Error _invokeFieldSetter(const ModelMeta &meta, const FieldMeta &field,
+                           const std::any &value);
+
+public:
 
   virtual Error beforeCreate(Session & /*session*/) { return make_ok(); }
   virtual Error afterCreate(Session & /*session*/) { return make_ok(); }
@@ -175,13 +224,28 @@ struct ModelMeta {
   std::vector<IndexDefinition> indexes;
   bool _is_finalized = false;
 
+  // 名称 → 下标的哈希索引，由 _buildLookupIndexes 在 finalize 时建立。
+  // 未建立索引的 ModelMeta（例如手工构造且未调用该函数）退回线性查找。
+  // 建立索引后不应再增删 fields/associations。
+  void _buildLookupIndexes();
+  bool _hasLookupIndexes() const { return _lookup_indexes_built; }
+
   const FieldMeta *findFieldByDbName(const std::string &name) const {
+    if (_lookup_indexes_built) {
+      auto it = _field_id_by_db_name.find(name);
+      return it == _field_id_by_db_name.end() ? nullptr : &fields[it->second];
+    }
     for (const auto &f : fields)
       if (f.db_name == name && !f.db_name.empty())
         return &f;
     return nullptr;
   }
   const FieldMeta *findFieldByCppName(const std::string &name) const {
+    if (_lookup_indexes_built) {
+      auto it = _field_id_by_cpp_name.find(name);
+      return it == _field_id_by_cpp_name.end() ? nullptr
+                                               : &fields[it->second];
+    }
     for (const auto &f : fields)
       if (f.cpp_name == name)
         return &f;
@@ -189,11 +253,28 @@ struct ModelMeta {
   }
   const AssociationMeta *
   findAssociationByCppName(const std::string &cpp_assoc_field_name) const {
+    if (_lookup_indexes_built) {
+      auto it = _association_index_by_cpp_name.find(cpp_assoc_field_name);
+      return it == _association_index_by_cpp_name.end()
+                 ? nullptr
+                 : &associations[it->second];
+    }
     for (const auto &assoc : associations)
       if (assoc.cpp_field_name == cpp_assoc_field_name)
         return &assoc;
     return nullptr;
   }
+  const FieldMeta *fieldById(FieldId id) const {
+    return id < fields.size() ? &fields[id] : nullptr;
+  }
+  FieldId findFieldIdByDbName(const std::string &name) const {
+    const FieldMeta *f = findFieldByDbName(name);
+    return f ? static_cast<FieldId>(f - fields.data()) : kInvalidFieldId;
+  }
+  FieldId findFieldIdByCppName(const std::string &name) const {
+    const FieldMeta *f = findFieldByCppName(name);
+    return f ? static_cast<FieldId>(f - fields.data()) : kInvalidFieldId;
+  }
   const FieldMeta *getPrimaryField(size_t idx = 0) const {
     if (primary_keys_db_names.empty() || idx >= primary_keys_db_names.size())
       return nullptr;
@@ -215,6 +296,12 @@ struct ModelMeta {
                            });
     return (it == fields.end()) ? nullptr : &(*it);
   }
+
+private:
+  bool _lookup_indexes_built = false;
+  std::unordered_map<std::string, FieldId> _field_id_by_db_name;
+  std::unordered_map<std::string, FieldId> _field_id_by_cpp_name;
+  std::unordered_map<std::string, size_t> _association_index_by_cpp_name;
 };
 
 inline std::any
@@ -271,7 +358,14 @@ inline Error ModelBase::setFieldValue(const std::string &cpp_field_name,
     return Error(ErrorCode::MappingError, "Field or Association placeholder " +
                                               cpp_field_name + " not found.");
   }
-  if (!field->setter) {
+  return _invokeFieldSetter(meta, *field, value);
+}
+
+inline Error ModelBase::_invokeFieldSetter(const ModelMeta &meta,
+                                           const FieldMeta &field,
+                                           const std::any &value) {
+  const std::string &cpp_field_name = field.cpp_name;
+  if (!field.setter) {
     qWarning() << "cpporm ModelBase::setFieldValue: Setter not found or "
                   "not finalized for field '"
                << cpp_field_name.c_str() << "' in table "
@@ -279,13 +373,15 @@ inline Error ModelBase::setFieldValue(const std::string &cpp_field_name,
     return Error(ErrorCode::MappingError,
                  "Setter for " + cpp_field_name + " not found/finalized.");
   }
+  if (_isDirtyTracked())
+    markFieldDirty(static_cast<FieldId>(&field - meta.fields.data()));
   try {
-    field->setter(this, value);
+    field.setter(this, value);
   } catch (const std::bad_any_cast &e) {
     qWarning() << "cpporm ModelBase::setFieldValue: Bad_any_cast for field '"
                << cpp_field_name.c_str()
                << "' (table: " << QString::fromStdString(meta.table_name)
-               << ", expected C++ type: " << field->cpp_type.name()
+               << ", expected C++ type: " << field.cpp_type.name()
                << ", value provided type: "
                << (value.has_value() ? value.type().name() : "empty_any")
                << "): " << e.what();
@@ -303,6 +399,22 @@ inline Error ModelBase::setFieldValue(const std::string &cpp_field_name,
   return make_ok();
 }
 
+inline std::any ModelBase::getFieldValueById(FieldId field_id) const {
+  const FieldMeta *field = this->_getOwnModelMeta().fieldById(field_id);
+  if (!field || !field->getter)
+    return std::any{};
+  return field->getter(this);
+}
+
+inline Error ModelBase::setFieldValueById(FieldId field_id,
+                                          const std::any &value) {
+  const FieldMeta *field = this->_getOwnModelMeta().fieldById(field_id);
+  if (!field)
+    return Error(ErrorCode::MappingError,
+                 "Field id " + std::to_string(field_id) + " out of range.");
+  return _invokeFieldSetter(this->_getOwnModelMeta(), *field, value);
+}
+
 inline std::map<std::string, std::any> ModelBase::_getPrimaryKeys() const {
   std::map<std::string, std::any> pks;
   const auto &meta = this->_getOwnModelMeta();
@@ -492,6 +604,7 @@ public:
       delete Model<Derived>::_pending_index_definition_providers;
       Model<Derived>::_pending_index_definition_providers = nullptr;
     }
+    s_meta._buildLookupIndexes();
     s_meta._is_finalized = true;
   }
 
@@ -540,6 +653,31 @@ public:
     }
   }
 
+  template <typename FieldType, FieldType Derived::*MemberPtr>
+  static bool _cpporm_generated_variant_setter(void *obj_ptr,
+                                               const QVariant &value) {
+    FieldType &member = static_cast<Derived *>(obj_ptr)->*MemberPtr;
+    if (value.isNull() || !value.isValid() ||
+        value.typeId() == QMetaType::UnknownType) {
+      member = FieldType{};
+      return true;
+    }
+    if (internal::assignFromVariant(value, member))
+      return true;
+    member = FieldType{};
+    return false;
+  }
+
+  template <typename FieldType, FieldType Derived::*MemberPtr>
+  static constexpr FieldVariantSetter _cpporm_variant_setter_for() {
+    if constexpr (internal::is_variant_mappable_v<FieldType>) {
+      return &Model<Derived>::template _cpporm_generated_variant_setter<
+          FieldType, MemberPtr>;
+    } else {
+      return nullptr;
+    }
+  }
+
   template <typename AssociatedModel,
             std::vector<std::shared_ptr<AssociatedModel>> Derived::*MemberPtr>
   static void _cpporm_generated_association_vector_setter(
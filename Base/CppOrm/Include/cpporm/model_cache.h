@@ -0,0 +1,103 @@
+// cpporm/model_cache.h
+#ifndef cpporm_MODEL_CACHE_H
+#define cpporm_MODEL_CACHE_H
+
+#include "cpporm/preload_key.h"
+
+#include <QString>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpporm {
+
+class ModelBase;
+struct ModelMeta;
+
+namespace internal {
+
+// 按 (数据库, 模型, 主键) 定位一行。scope 取自连接的驱动/主机/端口/库名，
+// 同一数据库的不同连接（包括 QtDbPool 的克隆连接）共享缓存。
+struct ModelCacheKey {
+  QString scope;
+  const ModelMeta *meta = nullptr;
+  std::vector<PreloadKey> primary_key;
+
+  bool operator==(const ModelCacheKey &other) const = default;
+};
+
+struct ModelCacheKeyHash {
+  size_t operator()(const ModelCacheKey &key) const;
+};
+
+// 进程级二级缓存：Session::First 按主键读取的模型副本，LRU + TTL。
+//
+// 失效以表为单位：Session 对某表的 UPDATE/DELETE/upsert 会推进该表的
+// 代数，旧代数的条目在下次查找时丢弃。读库前先取得代数，写回缓存时
+// 代数已变化（期间有写入）则放弃写回，避免把读到的旧行放进缓存。
+// 只感知本进程内经 Session 的写入；ExecRaw 或其他进程的写入需调用
+// Session::InvalidateCache，或依赖 TTL。
+class ModelCache {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static ModelCache &instance();
+
+  // max_entries 为 0 时禁用（默认）；缩小时立即淘汰多余条目。
+  void setOptions(size_t max_entries, std::chrono::milliseconds ttl);
+  bool enabled() const;
+
+  std::shared_ptr<const ModelBase> lookup(const ModelCacheKey &key);
+  void store(const ModelCacheKey &key, std::shared_ptr<const ModelBase> model,
+             uint64_t generation);
+
+  uint64_t tableGeneration(const QString &scope,
+                           const std::string &table_name) const;
+  void invalidateTable(const QString &scope, const std::string &table_name);
+  void invalidateAll();
+
+  size_t size() const;
+
+private:
+  ModelCache() = default;
+
+  struct Entry {
+    ModelCacheKey key;
+    std::shared_ptr<const ModelBase> model;
+    uint64_t generation;
+    Clock::time_point expires_at;
+  };
+  using EntryList = std::list<Entry>;
+
+  uint64_t tableGenerationLocked(const QString &scope,
+                                 const std::string &table_name) const;
+  void eraseLocked(EntryList::iterator it);
+  void trimLocked();
+
+  mutable std::mutex mutex_;
+  size_t max_entries_ = 0;
+  std::chrono::milliseconds ttl_ = std::chrono::seconds(60);
+  // 最近使用的在前
+  EntryList lru_;
+  std::unordered_map<ModelCacheKey, EntryList::iterator, ModelCacheKeyHash>
+      index_;
+  // 代数取自单调递增的计数器：invalidateAll 推进 epoch_，
+  // 表的有效代数为 max(epoch_, 该表最后一次失效时的计数)。
+  uint64_t counter_ = 0;
+  uint64_t epoch_ = 0;
+  std::map<std::pair<QString, std::string>, uint64_t> table_generations_;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_MODEL_CACHE_H
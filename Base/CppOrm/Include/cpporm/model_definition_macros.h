@@ -87,11 +87,14 @@ private:                                                                       \
              auto s = &cpporm::Model<_cppormThisModelClass>::                \
                           template _cpporm_generated_setter<                  \
                               CppType, &_cppormThisModelClass::CppName>;      \
+             auto vs = cpporm::Model<_cppormThisModelClass>::                \
+                 template _cpporm_variant_setter_for<                          \
+                     CppType, &_cppormThisModelClass::CppName>();              \
              return cpporm::FieldMeta(                                        \
                  DbNameStr, cpporm_STRINGIFY(CppName), typeid(CppType), "",   \
                  cpporm::combine_flags_recursive(cpporm::FieldFlag::None,    \
                                                   ##__VA_ARGS__),              \
-                 g, s);                                                        \
+                 g, s, vs);                                                    \
            }),                                                                 \
        true);                                                                  \
                                                                                \
@@ -111,12 +114,15 @@ private:                                                                       \
              auto s = &cpporm::Model<_cppormThisModelClass>::                \
                           template _cpporm_generated_setter<                  \
                               CppType, &_cppormThisModelClass::CppName>;      \
+             auto vs = cpporm::Model<_cppormThisModelClass>::                \
+                 template _cpporm_variant_setter_for<                          \
+                     CppType, &_cppormThisModelClass::CppName>();              \
              return cpporm::FieldMeta(                                        \
                  DbNameStr, cpporm_STRINGIFY(CppName), typeid(CppType),       \
                  DbTypeHintStr,                                                \
                  cpporm::combine_flags_recursive(cpporm::FieldFlag::None,    \
                                                   ##__VA_ARGS__),              \
-                 g, s);                                                        \
+                 g, s, vs);                                                    \
            }),                                                                 \
        true);                                                                  \
                                                                                \
@@ -219,6 +225,42 @@ private:                                                                       \
                                                                                \
 public:
 
+// 多对多：JoinTable.JoinFkToCurrent 引用当前模型的主键（可由第 1 个可选参数
+// 指定其他列），JoinTable.JoinFkToTarget 引用目标模型的主键（第 2 个可选参数）。
+#define cpporm_MANY_TO_MANY(CppFieldName, TargetModelParamName, JoinTable,     \
+                             JoinFkToCurrent, JoinFkToTarget, ...)             \
+private:                                                                       \
+  inline static const bool cpporm_CONCAT(_assoc_m_prov_reg_mm_,                \
+                                          CppFieldName) =                      \
+      (cpporm::Model<_cppormThisModelClass>::_addPendingAssociationProvider(   \
+           []() -> cpporm::AssociationMeta {                                   \
+             auto d_setter_vec =                                               \
+                 &cpporm::Model<_cppormThisModelClass>::                       \
+                     template _cpporm_generated_association_vector_setter<     \
+                         TargetModelParamName,                                 \
+                         &_cppormThisModelClass::CppFieldName>;                \
+             std::string current_model_ref_key =                               \
+                 cpporm::internal::get_optional_arg_str<1>("",                 \
+                                                            ##__VA_ARGS__);    \
+             std::string target_model_ref_key =                                \
+                 cpporm::internal::get_optional_arg_str<2>("",                 \
+                                                            ##__VA_ARGS__);    \
+             cpporm::TargetTypeIndexProvider target_type_provider =            \
+                 &cpporm::Model<                                               \
+                     TargetModelParamName>::_get_static_type_index;            \
+             cpporm::AssociationMeta assoc(                                    \
+                 cpporm_STRINGIFY(CppFieldName),                               \
+                 cpporm::AssociationType::ManyToMany, target_type_provider,    \
+                 JoinFkToCurrent, current_model_ref_key,                       \
+                 target_model_ref_key, d_setter_vec, nullptr);                 \
+             assoc.join_table_name = JoinTable;                                \
+             assoc.join_table_target_key_db_name = JoinFkToTarget;             \
+             return assoc;                                                     \
+           }),                                                                 \
+       true);                                                                  \
+                                                                               \
+public:
+
 #define cpporm_INDEX_INTERNAL(IsUniqueParam, IndexNameOrFirstColParam, ...)   \
 private:                                                                       \
   inline static const bool cpporm_CONCAT(_idx_def_prov_reg_, __COUNTER__) =   \
@@ -292,11 +334,14 @@ private:                                                                       \
              auto s = &cpporm::Model<_cppormThisModelClass>::                \
                           template _cpporm_generated_setter<                  \
                               CppType, &_cppormThisModelClass::CppName>;      \
+             auto vs = cpporm::Model<_cppormThisModelClass>::                \
+                 template _cpporm_variant_setter_for<                          \
+                     CppType, &_cppormThisModelClass::CppName>();              \
              return cpporm::FieldMeta(                                        \
                  DbNameStr, cpporm_STRINGIFY(CppName), typeid(CppType), "",   \
                  cpporm::combine_flags_recursive(                             \
                      cpporm::FieldFlag::PrimaryKey, ##__VA_ARGS__),           \
-                 g, s);                                                        \
+                 g, s, vs);                                                    \
            }),                                                                 \
        true);                                                                  \
                                                                                \
@@ -0,0 +1,55 @@
+// cpporm/preload_key.h
+#ifndef cpporm_PRELOAD_KEY_H
+#define cpporm_PRELOAD_KEY_H
+
+#include <QVariant>
+
+#include <any>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace cpporm {
+
+class ModelBase;
+
+namespace internal {
+
+// 预加载时父子两侧连接键的规范化表示。
+// 所有整型统一为 long long（超出范围的 unsigned long long 保留原类型），
+// 因此父模型 int 主键与子模型 long long 外键能相互匹配；
+// 日期时间类键按 UTC ISO 字符串参与比较。
+using PreloadKey = std::variant<long long, unsigned long long, double,
+                                std::string>;
+
+struct PreloadKeyHash {
+  size_t operator()(const PreloadKey &key) const {
+    const size_t value_hash = std::visit(
+        [](const auto &v) {
+          return std::hash<std::decay_t<decltype(v)>>{}(v);
+        },
+        key);
+    return value_hash ^ (key.index() * 0x9e3779b97f4a7c15ULL);
+  }
+};
+
+// 按连接键分桶的已加载关联模型
+using PreloadBuckets =
+    std::unordered_map<PreloadKey, std::vector<std::shared_ptr<ModelBase>>,
+                       PreloadKeyHash>;
+
+// 空值或不支持的类型返回 nullopt，这类行不参与连接。
+std::optional<PreloadKey> makePreloadKey(const std::any &value);
+// 结果集中的原始列值（如 ManyToMany 连接表的父键），规则同上。
+std::optional<PreloadKey> makePreloadKeyFromVariant(const QVariant &value);
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_PRELOAD_KEY_H
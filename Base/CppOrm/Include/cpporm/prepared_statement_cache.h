@@ -0,0 +1,133 @@
+// cpporm/prepared_statement_cache.h
+#ifndef cpporm_PREPARED_STATEMENT_CACHE_H
+#define cpporm_PREPARED_STATEMENT_CACHE_H
+
+#include <QHash>
+#include <QSqlQuery>
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpporm {
+namespace internal {
+
+class PreparedStatementCache;
+
+// 一次调用内使用的语句：来自 PreparedStatementCache（所有权随租约转移）
+// 或新 prepare 的语句。析构或 release() 时 finish()，可缓存的语句随后
+// 放回当前线程的缓存。只能移动，必须在借出它的线程上使用和析构。
+class StatementLease {
+public:
+  StatementLease() = default;
+  // 不进入缓存的语句（流式读取、打开连接失败等）
+  explicit StatementLease(std::unique_ptr<QSqlQuery> query);
+  ~StatementLease() { release(); }
+  StatementLease(StatementLease &&other) noexcept = default;
+  StatementLease &operator=(StatementLease &&other) noexcept;
+  StatementLease(const StatementLease &) = delete;
+  StatementLease &operator=(const StatementLease &) = delete;
+
+  QSqlQuery &operator*() const { return *query_; }
+  QSqlQuery *operator->() const { return query_.get(); }
+  explicit operator bool() const { return query_ != nullptr; }
+
+  // 执行失败的语句可能已处于异常状态，结束时直接销毁而不放回缓存
+  void discard() { cacheable_ = false; }
+  void release();
+
+private:
+  friend class PreparedStatementCache;
+
+  std::unique_ptr<QSqlQuery> query_;
+  bool cacheable_ = false;
+  QString connection_name_;
+  QString sql_;
+  uint64_t generation_ = 0;
+};
+
+// 按 (连接名, 线程) 缓存已 prepare 的 QSqlQuery，每个键一个 LRU。
+// Session::execute_query_internal 对相同 SQL 复用语句，只重新绑定参数，
+// 省去 MySQL/PostgreSQL 上每次 prepare 的往返与解析。
+//
+// 缓存独占语句对象：acquire 把语句移出缓存借给一次调用，归还前同一 SQL
+// 的其他调用（例如嵌套查询）会未命中并自行 prepare，因此不会有两个调用
+// 方步进同一个结果集。QSqlQuery 只能在其连接所属的线程上使用和销毁，
+// 其他线程的条目在失效时不在调用线程上销毁，而是留到该线程下次访问
+// 缓存时销毁。
+//
+// 连接重连、关闭或表结构变更（AutoMigrate）后必须 invalidate，
+// 否则缓存的语句句柄可能已失效。
+class PreparedStatementCache {
+public:
+  static constexpr size_t kDefaultCapacityPerConnection = 64;
+
+  static PreparedStatementCache &instance();
+
+  // 命中时返回可直接绑定参数并 exec 的语句；未命中或 capacity 为 0 时
+  // 返回空租约。
+  StatementLease acquire(const QString &connection_name, const QString &sql);
+  // 包装新 prepare 的语句，租约结束时（未 discard）放入当前线程的缓存
+  StatementLease adopt(const QString &connection_name, const QString &sql,
+                       std::unique_ptr<QSqlQuery> prepared_query);
+
+  void invalidate(const QString &connection_name);
+  void invalidateAll();
+
+  // 每个连接最多缓存的语句数；0 表示禁用缓存。缩小时立即淘汰多余条目。
+  void setCapacity(size_t capacity_per_connection);
+  size_t capacity() const;
+  // 当前线程在该连接上缓存的语句数
+  size_t size(const QString &connection_name) const;
+
+private:
+  friend class StatementLease;
+
+  PreparedStatementCache() = default;
+
+  struct QStringHasher {
+    size_t operator()(const QString &s) const { return qHash(s); }
+  };
+
+  using Key = std::pair<QString, std::thread::id>;
+  using Entry = std::pair<QString, std::unique_ptr<QSqlQuery>>;
+  using Dropped = std::vector<std::unique_ptr<QSqlQuery>>;
+
+  struct ConnectionStatements {
+    uint64_t generation = 0; // 条目被清除后重建时变化，旧租约不再放回
+    // 最近使用的在前
+    std::list<Entry> lru;
+    std::unordered_map<QString, std::list<Entry>::iterator, QStringHasher>
+        index;
+  };
+
+  void giveBack(StatementLease &lease);
+  // 移除条目：当前线程的语句放入 dropped（由调用方在锁外销毁），
+  // 其他线程的放入 retired_ 等待其所属线程销毁
+  void dropLocked(std::thread::id owner, std::unique_ptr<QSqlQuery> query,
+                  Dropped &dropped);
+  void eraseLocked(std::map<Key, ConnectionStatements>::iterator it,
+                   Dropped &dropped);
+  void trimLocked(const Key &key, ConnectionStatements &statements,
+                  Dropped &dropped);
+  void takeRetiredLocked(Dropped &dropped);
+
+  mutable std::mutex mutex_;
+  size_t capacity_per_connection_ = kDefaultCapacityPerConnection;
+  uint64_t next_generation_ = 0;
+  std::map<Key, ConnectionStatements> connections_;
+  std::map<std::thread::id, Dropped> retired_;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_PREPARED_STATEMENT_CACHE_H
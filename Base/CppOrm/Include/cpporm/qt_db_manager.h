@@ -2,10 +2,14 @@
 #define cpporm_QT_DB_MANAGER_H
 
 #include "cpporm/error.h" // 我们自定义的错误处理机制
+#include "cpporm/query_profiler.h"
+#include <chrono>
+#include <cstddef>
 #include <expected>        // For std::expected (C++23)
 #include <memory> // For std::shared_ptr if managing QSqlDatabase instances
 #include <mutex>  // For thread-safe initialization if needed
 #include <string>
+#include <vector>
 
 // QtSql 相关头文件
 #include <QSqlDatabase> // Qt 数据库连接核心类
@@ -62,6 +66,12 @@ public:
   static QSqlDatabase
   getDatabase(const QString &connection_name = QSqlDatabase::defaultConnection);
 
+  // 以已注册连接 source_connection_name 的配置创建并在当前线程打开一个
+  // 名为 clone_connection_name 的新连接（QtDbPool 使用）。
+  static std::expected<QSqlDatabase, Error>
+  openClone(const QString &source_connection_name,
+            const QString &clone_connection_name);
+
   // 关闭并移除一个数据库连接
   // connection_name: 要关闭的连接名
   static void closeDatabase(const QString &connection_name);
@@ -69,6 +79,27 @@ public:
   // 检查特定名称的连接是否存在且有效
   static bool isConnectionValid(const QString &connection_name);
 
+  // Session 按连接缓存已 prepare 的语句（LRU）。
+  // capacity: 每个连接最多缓存的语句数，0 表示禁用。
+  static void setPreparedStatementCacheCapacity(size_t capacity);
+  // 应用自行 close()/open() 连接或在 cpporm 之外修改表结构后调用，
+  // 丢弃该连接上缓存的语句。closeDatabase 与 AutoMigrate 会自动调用。
+  static void clearPreparedStatementCache(const QString &connection_name);
+
+  // Session::First(model, 主键) 的进程级二级缓存（按模型与主键，LRU + TTL）。
+  // max_entries 为 0 时禁用（默认）。本进程内经 Session 的写入会使对应表的
+  // 条目失效；其他进程或 ExecRaw 的写入只能等待 TTL 过期或手动失效。
+  static void setModelCacheOptions(size_t max_entries,
+                                   std::chrono::milliseconds ttl);
+  static void clearModelCache();
+
+  // 语句级耗时统计（prepare/exec/fetch/map/preload 直方图，按语句指纹
+  // 聚合）与慢查询日志，默认关闭。
+  static void setQueryProfilingOptions(QueryProfilingOptions options);
+  // 按累计耗时降序
+  static std::vector<QueryStatsSnapshot> queryStatsSnapshot();
+  static void resetQueryStats();
+
 private:
   // 用于确保 addDatabase 等操作的线程安全（如果从多线程调用）
   // static std::mutex db_mutex_;
@@ -0,0 +1,139 @@
+// cpporm/qt_db_pool.h
+#ifndef cpporm_QT_DB_POOL_H
+#define cpporm_QT_DB_POOL_H
+
+#include "cpporm/error.h"
+
+#include <QSqlDatabase>
+#include <QString>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpporm {
+
+struct QtDbPoolOptions {
+  // 每个线程在空闲回收时至少保留的连接数
+  size_t min_idle_per_thread = 1;
+  // 池中（含借出的）连接总数上限
+  size_t max_connections = 32;
+  // 空闲超过该时长且超出 min_idle_per_thread 的连接会被关闭
+  std::chrono::milliseconds idle_timeout = std::chrono::minutes(5);
+  // 全部连接都已借出时 acquire 的最长等待时间
+  std::chrono::milliseconds acquire_timeout = std::chrono::seconds(10);
+  // 空闲超过该时长的连接在借出前先执行 SELECT 1 校验
+  std::chrono::milliseconds validate_after_idle = std::chrono::seconds(30);
+};
+
+// 基于 QtDbManager 已注册连接的多线程连接池。
+//
+// QSqlDatabase 连接只能在创建它的线程中使用（包括关闭），因此池中每个
+// 连接都记录其所属线程：acquire 只会复用当前线程之前打开的空闲连接，
+// 否则以源连接的配置（QSqlDatabase::cloneDatabase）在当前线程新开一个。
+// 连接只由所属线程关闭：其他线程的空闲连接过期或需要为等待者腾出名额
+// 时只被标记为 stale，由所属线程下一次 acquire 或
+// releaseThreadConnections() 关闭。池满且没有可用名额时等待，超过
+// acquire_timeout 返回错误。
+// 池按源连接名注册；注册后 Session(connection_name) 会自动从池中借用
+// 本线程的连接，Session 析构时归还。
+//
+// 工作线程退出前应调用 releaseThreadConnections()，关闭本线程的空闲连接；
+// 连接池析构时只关闭析构线程自己的空闲连接。
+class QtDbPool : public std::enable_shared_from_this<QtDbPool> {
+public:
+  // 借出的连接；析构或 release() 时归还连接池。只能移动。
+  class Lease {
+  public:
+    Lease() = default;
+    ~Lease();
+    Lease(Lease &&other) noexcept;
+    Lease &operator=(Lease &&other) noexcept;
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    const QString &connectionName() const { return connection_name_; }
+    QSqlDatabase database() const { return db_; }
+    explicit operator bool() const { return pool_ != nullptr; }
+    void release();
+
+  private:
+    friend class QtDbPool;
+    Lease(std::shared_ptr<QtDbPool> pool, QString connection_name,
+          QSqlDatabase db);
+
+    std::shared_ptr<QtDbPool> pool_;
+    QString connection_name_;
+    QSqlDatabase db_;
+    std::thread::id owner_; // 打开该连接的线程
+  };
+
+  // 为已通过 QtDbManager::openDatabase 打开的连接创建并注册连接池。
+  // 同名连接池已存在时返回 InvalidConfiguration。
+  static std::expected<std::shared_ptr<QtDbPool>, Error>
+  create(const QString &source_connection_name,
+         const QtDbPoolOptions &options = {});
+  static std::shared_ptr<QtDbPool> find(const QString &source_connection_name);
+  // 注销连接池；已借出的连接仍可使用，归还时关闭。
+  static void remove(const QString &source_connection_name);
+
+  ~QtDbPool();
+  QtDbPool(const QtDbPool &) = delete;
+  QtDbPool &operator=(const QtDbPool &) = delete;
+
+  // 借出一个属于当前线程的连接；全部借出时最多等待 acquire_timeout。
+  std::expected<Lease, Error> acquire();
+  // 关闭当前线程的全部空闲连接（工作线程退出前调用）。
+  void releaseThreadConnections();
+
+  size_t totalConnections() const;
+  size_t idleConnections() const;
+  const QString &sourceConnectionName() const {
+    return source_connection_name_;
+  }
+  const QtDbPoolOptions &options() const { return options_; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct PooledConnection {
+    QString name;
+    QSqlDatabase db;
+    std::thread::id owner;
+    Clock::time_point idle_since;
+    bool stale = false; // 待所属线程关闭
+  };
+
+  QtDbPool(QString source_connection_name, const QtDbPoolOptions &options);
+
+  void giveBack(const QString &connection_name, QSqlDatabase db,
+                std::thread::id owner);
+  // 取出 owner 线程已过期（超出 min_idle_per_thread 的部分）或被标记为
+  // stale 的空闲连接；其他线程的过期连接只标记为 stale
+  std::vector<PooledConnection> takeExpiredLocked(Clock::time_point now,
+                                                  std::thread::id owner);
+  bool hasOwnIdleLocked(std::thread::id owner) const;
+  // 调用方不得持有 mutex_，且必须是这些连接的所属线程
+  void closeConnections(std::vector<PooledConnection> &connections);
+  static bool validate(QSqlDatabase &db);
+
+  const QString source_connection_name_;
+  const QtDbPoolOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable available_;
+  std::vector<PooledConnection> idle_; // 最近归还的在后
+  size_t total_ = 0;
+  size_t waiters_ = 0;
+  size_t next_id_ = 0;
+  bool detached_ = false; // 已从注册表移除
+};
+
+} // namespace cpporm
+
+#endif // cpporm_QT_DB_POOL_H
@@ -24,6 +24,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -131,6 +132,9 @@ public:
   }
   const QString &getConnectionName() const { return connection_name_; }
   IQueryExecutor *getExecutor() const { return executor_; }
+  // 改由另一个执行器（及其连接）执行，例如 AsyncSession 的工作线程 Session
+  QueryBuilder &BindExecutor(IQueryExecutor *executor,
+                             QString connection_name);
 
   const std::vector<Condition> &getWhereConditions() const {
     return QueryBuilderConditionsMixin<
@@ -217,6 +221,25 @@ public:
              const std::string &query_string,
              const std::vector<QueryValue> &args = {});
 
+  // 流式逐行读取（forward-only 结果集），内存占用与结果行数无关。
+  // 不处理 Preload；需要 Preload 时请分批读取。
+  template <typename T> Error FindEach(std::function<Error(T &)> row_callback);
+  // 按主键键集分页逐批读取（不使用 OFFSET），每批都会处理 Preload。
+  // 已有的 Order 会被主键升序替换；Limit 视为总行数上限。
+  template <typename T>
+  Error FindInBatches(
+      size_t batch_size,
+      std::function<Error(std::vector<std::unique_ptr<T>> &)> batch_callback);
+
+  // 列投影：只取指定列并直接从结果集解码，不构造模型、不调用 afterFind、
+  // 不处理 Preload。当前的 Select 列表被替换，其余条件/排序/分页照常生效。
+  // T 为可映射字段类型；NULL 解码为 T{}，需要区分 NULL 时使用 std::optional<T>。
+  template <typename T>
+  std::expected<std::vector<T>, Error> Pluck(const std::string &column) const;
+  template <typename T1, typename T2, typename... Rest>
+  std::expected<std::vector<std::tuple<T1, T2, Rest...>>, Error>
+  Pluck(const std::vector<std::string> &columns) const;
+
   template <typename TModel>
   std::expected<QVariant, Error> Create(TModel &model);
 
@@ -227,6 +250,14 @@ public:
   Error First(ModelBase &result_model);
   Error Find(std::vector<std::unique_ptr<ModelBase>> &results_vector,
              std::function<std::unique_ptr<ModelBase>()> element_type_factory);
+  Error
+  FindEach(std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+           std::function<Error(ModelBase &)> row_callback);
+  Error FindInBatches(
+      size_t batch_size,
+      std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+      std::function<Error(std::vector<std::unique_ptr<ModelBase>> &)>
+          batch_callback);
   std::expected<QVariant, Error>
   Create(ModelBase &model,
          const OnConflictClause *conflict_options_override = nullptr);
@@ -235,6 +266,9 @@ public:
   std::expected<long long, Error> Delete();
   std::expected<long long, Error> Save(ModelBase &model);
   std::expected<int64_t, Error> Count();
+  // 以 columns 为 Select 列表执行查询（不修改本构建器），逐行回调结果集
+  Error Project(const std::vector<std::string> &columns,
+                std::function<Error(const QSqlQuery &)> row_callback) const;
 
 private:
   friend class QueryBuilderConditionsMixin<QueryBuilder>;
@@ -254,6 +288,15 @@ private:
   void build_ctes_sql_prefix(std::ostringstream &sql_stream,
                              QVariantList &bound_params_accumulator) const;
 
+  // buildSelectSQL 的 SQL 文本缓存：形状键不含绑定值；含子查询/CTE 的
+  // 构建器返回 false，不参与缓存。
+  std::pair<QString, QVariantList>
+  build_select_sql_uncached(bool for_subquery_generation) const;
+  bool build_select_shape_key(bool for_subquery_generation,
+                              std::string &shape_key) const;
+  void collect_select_bindings(bool for_subquery_generation,
+                               QVariantList &bound_params_accumulator) const;
+
   // Declaration of the static helper for building condition blocks
   static bool build_one_condition_block_internal_static_helper(
       std::ostringstream &to_stream, QVariantList &bindings_acc,
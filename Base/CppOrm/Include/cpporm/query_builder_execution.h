@@ -2,6 +2,7 @@
 #ifndef cpporm_QUERY_BUILDER_EXECUTION_H
 #define cpporm_QUERY_BUILDER_EXECUTION_H
 
+#include "cpporm/field_variant_conversion.h"
 #include "cpporm/query_builder_core.h"
 // Other necessary includes are transitively included
 
@@ -191,6 +192,126 @@ inline Error QueryBuilder::Find(std::vector<std::unique_ptr<T>> *results_vector,
   return this->Find(results_vector);
 }
 
+template <typename T>
+inline Error QueryBuilder::FindEach(std::function<Error(T &)> row_callback) {
+  static_assert(std::is_base_of<ModelBase, T>::value,
+                "T must be a descendant of cpporm::ModelBase");
+  if (!row_callback)
+    return Error(ErrorCode::InternalError,
+                 "Row callback is null for QueryBuilder::FindEach.");
+
+  if (!this->state_.model_meta_ ||
+      this->state_.model_meta_ != &(T::getModelMeta())) {
+    this->Model<T>();
+  }
+
+  auto factory = []() -> std::unique_ptr<ModelBase> {
+    return std::make_unique<T>();
+  };
+  return this->FindEach(factory, [&row_callback](ModelBase &model) {
+    return row_callback(static_cast<T &>(model));
+  });
+}
+
+template <typename T>
+inline Error QueryBuilder::FindInBatches(
+    size_t batch_size,
+    std::function<Error(std::vector<std::unique_ptr<T>> &)> batch_callback) {
+  static_assert(std::is_base_of<ModelBase, T>::value,
+                "T must be a descendant of cpporm::ModelBase");
+  if (!batch_callback)
+    return Error(ErrorCode::InternalError,
+                 "Batch callback is null for QueryBuilder::FindInBatches.");
+
+  if (!this->state_.model_meta_ ||
+      this->state_.model_meta_ != &(T::getModelMeta())) {
+    this->Model<T>();
+  }
+
+  auto factory = []() -> std::unique_ptr<ModelBase> {
+    return std::make_unique<T>();
+  };
+  std::vector<std::unique_ptr<T>> typed_batch;
+  return this->FindInBatches(
+      batch_size, factory,
+      [&batch_callback,
+       &typed_batch](std::vector<std::unique_ptr<ModelBase>> &batch) {
+        typed_batch.clear();
+        typed_batch.reserve(batch.size());
+        for (auto &base_ptr : batch) {
+          typed_batch.emplace_back(static_cast<T *>(base_ptr.release()));
+        }
+        batch.clear();
+        return batch_callback(typed_batch);
+      });
+}
+
+template <typename T>
+inline std::expected<std::vector<T>, Error>
+QueryBuilder::Pluck(const std::string &column) const {
+  static_assert(internal::is_projectable_v<T>,
+                "Pluck: T must be a mappable field type or std::optional of "
+                "one");
+  std::vector<T> results;
+  Error err = this->Project({column}, [&](const QSqlQuery &query) -> Error {
+    if (results.empty()) {
+      // 驱动已知结果行数时一次性分配
+      const int rows = query.size();
+      if (rows > 0)
+        results.reserve(static_cast<size_t>(rows));
+    }
+    T &value = results.emplace_back();
+    if (!internal::assignProjectedValue(query.value(0), value))
+      return Error(ErrorCode::MappingError,
+                   "Pluck: cannot convert column '" + column +
+                       "' to the requested type.");
+    return make_ok();
+  });
+  if (err)
+    return std::unexpected(err);
+  return results;
+}
+
+template <typename T1, typename T2, typename... Rest>
+inline std::expected<std::vector<std::tuple<T1, T2, Rest...>>, Error>
+QueryBuilder::Pluck(const std::vector<std::string> &columns) const {
+  using Row = std::tuple<T1, T2, Rest...>;
+  static_assert(internal::is_projectable_v<T1> &&
+                    internal::is_projectable_v<T2> &&
+                    (internal::is_projectable_v<Rest> && ...),
+                "Pluck: column types must be mappable field types or "
+                "std::optional of one");
+  if (columns.size() != std::tuple_size_v<Row>)
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "Pluck: number of columns does not match the tuple size."));
+
+  std::vector<Row> results;
+  Error err = this->Project(columns, [&](const QSqlQuery &query) -> Error {
+    if (results.empty()) {
+      const int rows = query.size();
+      if (rows > 0)
+        results.reserve(static_cast<size_t>(rows));
+    }
+    Row &row = results.emplace_back();
+    int index = 0;
+    const bool ok = std::apply(
+        [&](auto &...cells) {
+          return (internal::assignProjectedValue(query.value(index++), cells) &&
+                  ...);
+        },
+        row);
+    if (!ok)
+      return Error(ErrorCode::MappingError,
+                   "Pluck: cannot convert column '" + columns[index - 1] +
+                       "' to the requested type.");
+    return make_ok();
+  });
+  if (err)
+    return std::unexpected(err);
+  return results;
+}
+
 template <typename TModel>
 inline std::expected<QVariant, Error> QueryBuilder::Create(TModel &model) {
   static_assert(std::is_base_of<ModelBase, TModel>::value,
@@ -0,0 +1,220 @@
+// cpporm/query_profiler.h
+#ifndef cpporm_QUERY_PROFILER_H
+#define cpporm_QUERY_PROFILER_H
+
+#include <QHash>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cpporm {
+
+struct LatencyHistogramSnapshot {
+  uint64_t count = 0;
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds max{0};
+  // buckets[i]: 耗时落在 [2^i, 2^(i+1)) ns 的次数（buckets[0] 含 0 ns）
+  std::vector<uint64_t> buckets;
+
+  std::chrono::nanoseconds mean() const;
+  // 按桶上界估计的分位数，q 取 [0, 1]
+  std::chrono::nanoseconds percentile(double q) const;
+};
+
+// 同一语句指纹（字面量替换为 ?、IN 列表与多行 VALUES 折叠）的累计统计
+struct QueryStatsSnapshot {
+  QString fingerprint;
+  uint64_t calls = 0;
+  uint64_t errors = 0;
+  uint64_t rows = 0;
+  LatencyHistogramSnapshot prepare; // 复用已 prepare 的语句时不计
+  LatencyHistogramSnapshot exec;
+  LatencyHistogramSnapshot fetch;   // 逐行 next() 的耗时
+  LatencyHistogramSnapshot map;     // 构造模型、映射字段与 afterFind
+  LatencyHistogramSnapshot preload; // 以本语句为主查询的 Preload 总耗时
+
+  std::chrono::nanoseconds totalTime() const {
+    return prepare.total + exec.total + fetch.total + map.total;
+  }
+};
+
+struct SlowQueryRecord {
+  QString connection_name;
+  QString sql;
+  QString fingerprint;
+  int bound_params = 0; // 只记录个数，不记录参数值
+  uint64_t rows = 0;
+  bool failed = false;
+  std::chrono::nanoseconds prepare{0};
+  std::chrono::nanoseconds exec{0};
+  std::chrono::nanoseconds fetch{0};
+  std::chrono::nanoseconds map{0};
+  std::chrono::nanoseconds preload{0};
+
+  std::chrono::nanoseconds total() const {
+    return prepare + exec + fetch + map + preload;
+  }
+};
+
+struct QueryProfilingOptions {
+  // 关闭时（默认）执行路径上不读取时钟
+  bool enabled = false;
+  // 单条语句总耗时达到阈值时写慢查询日志；0 表示不记录
+  std::chrono::milliseconds slow_query_threshold{0};
+  // 超出后新的指纹计入 "<other>"
+  size_t max_fingerprints = 1024;
+  // 为空时以 qWarning 输出。在执行语句的线程上同步调用。
+  std::function<void(const SlowQueryRecord &)> slow_query_sink;
+};
+
+namespace internal {
+
+// 无锁直方图：以 2 的幂划分桶，记录只做 relaxed 原子加。
+class LatencyHistogram {
+public:
+  static constexpr size_t kBucketCount = 48;
+
+  void record(int64_t nanoseconds);
+  LatencyHistogramSnapshot snapshot() const;
+  void reset();
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<int64_t> total_ns_{0};
+  std::atomic<int64_t> max_ns_{0};
+};
+
+struct StatementStats {
+  explicit StatementStats(QString fp) : fingerprint(std::move(fp)) {}
+
+  const QString fingerprint;
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> rows{0};
+  LatencyHistogram prepare;
+  LatencyHistogram exec;
+  LatencyHistogram fetch;
+  LatencyHistogram map;
+  LatencyHistogram preload;
+};
+
+// execute_query_internal 的计时结果，供读取结果集的调用方续记 fetch/map
+struct StatementTimings {
+  StatementStats *stats = nullptr; // 未启用分析时为 nullptr
+  int64_t prepare_ns = 0;
+  int64_t exec_ns = 0;
+  int bound_params = 0;
+};
+
+class QueryProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static QueryProfiler &instance();
+
+  void setOptions(QueryProfilingOptions options);
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // 记录一次 prepare + exec。defer_slow_check 为 true 时由
+  // StatementProfile 在读取完结果集后按总耗时判断慢查询。
+  void recordExecution(const QString &connection_name, const QString &sql,
+                       StatementTimings &timings, bool succeeded,
+                       bool defer_slow_check);
+  // 总耗时是否达到慢查询阈值（未设置阈值时恒为 false）
+  bool isSlow(int64_t total_ns) const;
+  void reportSlowQuery(const SlowQueryRecord &record);
+
+  // 按 prepare+exec+fetch+map 总耗时降序；不含尚无调用的指纹
+  std::vector<QueryStatsSnapshot> snapshot() const;
+  void reset();
+
+  // 语句指纹：字符串/数字字面量替换为 ?，占位符列表与重复的 VALUES
+  // 元组折叠，空白归一
+  static QString fingerprint(const QString &sql);
+
+private:
+  struct QStringHasher {
+    size_t operator()(const QString &s) const { return qHash(s); }
+  };
+
+  QueryProfiler();
+
+  StatementStats *statsFor(const QString &sql);
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<int64_t> slow_threshold_ns_{0};
+
+  mutable std::shared_mutex stats_mutex_;
+  size_t max_fingerprints_ = 1024;
+  // 条目只增不删（reset 只清零），线程本地缓存中的指针始终有效
+  std::unordered_map<QString, std::unique_ptr<StatementStats>, QStringHasher>
+      stats_;
+  std::unique_ptr<StatementStats> overflow_stats_;
+
+  std::mutex sink_mutex_;
+  std::function<void(const SlowQueryRecord &)> slow_query_sink_;
+};
+
+// 读取结果集阶段的计时。未启用分析（timings.stats 为空）时不读取时钟。
+//
+//   internal::StatementProfile profile(connection, sql, timings);
+//   while (query.next()) {
+//     auto map_started = profile.beginRow();
+//     ... 构造并映射模型 ...
+//     profile.endRow(map_started);
+//   }
+//   profile.endFetch();
+//
+// 析构时提交统计，并按整条语句的总耗时判断慢查询。
+class StatementProfile {
+public:
+  using Clock = QueryProfiler::Clock;
+
+  StatementProfile(const QString &connection_name, const QString &sql,
+                   const StatementTimings &timings);
+  ~StatementProfile();
+  StatementProfile(const StatementProfile &) = delete;
+  StatementProfile &operator=(const StatementProfile &) = delete;
+
+  Clock::time_point beginRow() const {
+    return active() ? Clock::now() : Clock::time_point{};
+  }
+  void endRow(Clock::time_point map_started) {
+    ++rows_;
+    if (active())
+      map_ns_ += (Clock::now() - map_started).count();
+  }
+  // 结果集读取结束；之后的耗时（例如 Preload）不计入 fetch
+  void endFetch();
+
+  Clock::time_point beginPreload() const { return beginRow(); }
+  void endPreload(Clock::time_point preload_started);
+
+private:
+  bool active() const { return timings_.stats != nullptr; }
+
+  const QString connection_name_;
+  const QString sql_;
+  const StatementTimings timings_;
+  Clock::time_point fetch_started_;
+  int64_t fetch_ns_ = -1; // endFetch 之前为 -1
+  int64_t map_ns_ = 0;
+  int64_t preload_ns_ = 0;
+  uint64_t rows_ = 0;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_QUERY_PROFILER_H
@@ -0,0 +1,45 @@
+// cpporm/row_mapper.h
+#ifndef cpporm_ROW_MAPPER_H
+#define cpporm_ROW_MAPPER_H
+
+#include "cpporm/model_base.h"
+
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+#include <vector>
+
+namespace cpporm {
+namespace internal {
+
+// 针对一个 (ModelMeta, 结果集列布局) 预先解析好的列 → 字段映射。
+// 列名查找只在构造时做一次；mapRow 只是按列下标调用类型化 setter 的循环。
+// 对一次查询的结果集构造一次，随后逐行复用。
+class RowMapper {
+public:
+  RowMapper(const ModelMeta &meta, const QSqlRecord &record);
+
+  // 把 query 当前行写入 model（model 必须是 meta 描述的类型），
+  // 同时记录各列原值作为 Save 脏字段比较的快照。
+  void mapRow(const QSqlQuery &query, ModelBase &model) const;
+
+  size_t mappedColumnCount() const { return columns_.size(); }
+
+private:
+  struct Column {
+    int index;
+    const FieldMeta *field;
+    FieldId field_id;
+  };
+
+  void mapColumnViaAny(const Column &column, const QVariant &value,
+                       ModelBase &model) const;
+
+  const ModelMeta &meta_;
+  std::vector<Column> columns_;
+};
+
+} // namespace internal
+} // namespace cpporm
+
+#endif // cpporm_ROW_MAPPER_H
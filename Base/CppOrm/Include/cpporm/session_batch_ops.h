@@ -51,6 +51,11 @@ Session::CreateBatch(const std::vector<ModelType *> &models_raw_input,
   std::vector<std::shared_ptr<ModelType>> final_result_sptrs;
   Error overall_error_from_all_batches = make_ok();
 
+  // 0 表示不在此处分块，由 CreateBatchProviderInternal 按驱动上限拆分语句
+  const size_t provider_chunk_rows =
+      internal_db_batch_size_hint > 0
+          ? internal_db_batch_size_hint
+          : base_models_for_internal_provider.size();
   size_t current_idx_provider = 0;
   auto internal_data_provider =
       [&]() -> std::optional<std::vector<ModelBase *>> {
@@ -60,7 +65,7 @@ Session::CreateBatch(const std::vector<ModelType *> &models_raw_input,
     std::vector<ModelBase *> chunk_to_process;
     size_t end_idx =
         std::min(base_models_for_internal_provider.size(),
-                 current_idx_provider + internal_db_batch_size_hint);
+                 current_idx_provider + provider_chunk_rows);
     for (size_t i = current_idx_provider; i < end_idx; ++i) {
       chunk_to_process.push_back(base_models_for_internal_provider[i]);
     }
@@ -96,7 +101,7 @@ Session::CreateBatch(const std::vector<ModelType *> &models_raw_input,
 
   Error provider_loop_error = this->CreateBatchProviderInternal(
       qb_proto, internal_data_provider, internal_completion_callback,
-      conflict_options_override);
+      conflict_options_override, internal_db_batch_size_hint);
 
   if (provider_loop_error)
     return std::unexpected(provider_loop_error);
@@ -172,6 +177,11 @@ Session::CreateBatch(
   std::vector<std::shared_ptr<ModelType>> final_result_sptrs;
   Error overall_error_from_all_batches = make_ok();
 
+  // 0 表示不在此处分块，由 CreateBatchProviderInternal 按驱动上限拆分语句
+  const size_t provider_chunk_rows =
+      internal_db_batch_size_hint > 0
+          ? internal_db_batch_size_hint
+          : base_models_for_internal_provider.size();
   size_t current_idx_provider = 0;
   auto internal_data_provider =
       [&]() -> std::optional<std::vector<ModelBase *>> {
@@ -181,7 +191,7 @@ Session::CreateBatch(
     std::vector<ModelBase *> chunk_to_process;
     size_t end_idx =
         std::min(base_models_for_internal_provider.size(),
-                 current_idx_provider + internal_db_batch_size_hint);
+                 current_idx_provider + provider_chunk_rows);
     for (size_t i = current_idx_provider; i < end_idx; ++i) {
       chunk_to_process.push_back(base_models_for_internal_provider[i]);
     }
@@ -214,7 +224,7 @@ Session::CreateBatch(
 
   Error provider_loop_error = this->CreateBatchProviderInternal(
       qb_proto, internal_data_provider, internal_completion_callback,
-      conflict_options_override);
+      conflict_options_override, internal_db_batch_size_hint);
 
   if (provider_loop_error)
     return std::unexpected(provider_loop_error);
@@ -277,6 +287,11 @@ Session::CreateBatch(
   std::vector<std::shared_ptr<ModelType>> final_result_sptrs;
   Error overall_error_from_all_batches = make_ok();
 
+  // 0 表示不在此处分块，由 CreateBatchProviderInternal 按驱动上限拆分语句
+  const size_t provider_chunk_rows =
+      internal_db_batch_size_hint > 0
+          ? internal_db_batch_size_hint
+          : base_models_for_internal_provider.size();
   size_t current_idx_provider = 0;
   auto internal_data_provider =
       [&]() -> std::optional<std::vector<ModelBase *>> {
@@ -286,7 +301,7 @@ Session::CreateBatch(
     std::vector<ModelBase *> chunk_to_process;
     size_t end_idx =
         std::min(base_models_for_internal_provider.size(),
-                 current_idx_provider + internal_db_batch_size_hint);
+                 current_idx_provider + provider_chunk_rows);
     for (size_t i = current_idx_provider; i < end_idx; ++i) {
       chunk_to_process.push_back(base_models_for_internal_provider[i]);
     }
@@ -319,7 +334,7 @@ Session::CreateBatch(
 
   Error provider_loop_error = this->CreateBatchProviderInternal(
       qb_proto, internal_data_provider, internal_completion_callback,
-      conflict_options_override);
+      conflict_options_override, internal_db_batch_size_hint);
 
   if (provider_loop_error)
     return std::unexpected(provider_loop_error);
@@ -358,9 +373,7 @@ Session::CreateBatch(
     std::function<std::optional<std::vector<ModelType *>>()>
         data_batch_provider_typed,
     const OnConflictClause *conflict_options_override,
-    size_t /* internal_db_batch_processing_size_hint is for provider chunking,
-              not directly used by DB op here */
-) {
+    size_t internal_db_batch_processing_size_hint) {
   static_assert(std::is_base_of<ModelBase, ModelType>::value,
                 "ModelType must derive from ModelBase.");
 
@@ -421,7 +434,8 @@ Session::CreateBatch(
 
   Error provider_loop_error = this->CreateBatchProviderInternal(
       qb_proto, data_batch_provider_base_adapted,
-      internal_completion_callback_for_provider, conflict_options_override);
+      internal_completion_callback_for_provider, conflict_options_override,
+      internal_db_batch_processing_size_hint);
 
   if (provider_loop_error) { // Error from the loop/provider mechanism itself
     return std::unexpected(provider_loop_error);
@@ -450,6 +464,39 @@ Session::CreateBatch(
   return all_successfully_created_models_sptr;
 }
 
+template <typename ModelType>
+inline std::expected<size_t, Error>
+Session::BulkInsert(const std::vector<ModelType *> &models,
+                    size_t rows_per_statement) {
+  static_assert(std::is_base_of<ModelBase, ModelType>::value,
+                "ModelType must derive from ModelBase.");
+  std::vector<ModelBase *> base_models;
+  base_models.reserve(models.size());
+  for (ModelType *typed_ptr : models) {
+    if (typed_ptr)
+      base_models.push_back(static_cast<ModelBase *>(typed_ptr));
+  }
+  return this->BulkInsert(ModelType::getModelMeta(), base_models,
+                          rows_per_statement);
+}
+
+template <typename ModelType>
+inline std::expected<long long, Error>
+Session::UpdateBatch(const std::vector<ModelType *> &models,
+                     const std::vector<std::string> &columns,
+                     size_t batch_size) {
+  static_assert(std::is_base_of<ModelBase, ModelType>::value,
+                "ModelType must derive from ModelBase.");
+  std::vector<ModelBase *> base_models;
+  base_models.reserve(models.size());
+  for (ModelType *typed_ptr : models) {
+    if (typed_ptr)
+      base_models.push_back(static_cast<ModelBase *>(typed_ptr));
+  }
+  return this->UpdateBatch(ModelType::getModelMeta(), base_models, columns,
+                           batch_size);
+}
+
 } // namespace cpporm
 
 #endif // cpporm_SESSION_BATCH_OPS_H
\ No newline at end of file
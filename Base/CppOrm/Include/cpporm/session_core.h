@@ -5,7 +5,12 @@
 #include "cpporm/error.h"
 #include "cpporm/i_query_executor.h"
 #include "cpporm/model_base.h"
+#include "cpporm/model_cache.h"
+#include "cpporm/preload_key.h"
+#include "cpporm/prepared_statement_cache.h"
+#include "cpporm/qt_db_pool.h"
 #include "cpporm/query_builder.h"
+#include "cpporm/query_profiler.h"
 #include "cpporm/session_fwd.h"
 #include "cpporm/session_types.h" // 包含 internal::SessionModelDataForWrite 和 SessionOnConflictUpdateSetter
 // #include "cpporm/session_priv_batch_helpers_fwd.h" // FriendAccess
@@ -24,6 +29,7 @@
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 // FriendAccess 的前向声明，因为它的完整定义在 session_priv_batch_helpers.h 中，
@@ -77,6 +83,18 @@ public:
   std::expected<long long, Error> SaveImpl(const QueryBuilder &qb,
                                            ModelBase &model) override;
   std::expected<int64_t, Error> CountImpl(const QueryBuilder &qb) override;
+  Error FindEachImpl(
+      const QueryBuilder &qb,
+      std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+      std::function<Error(ModelBase &)> row_callback) override;
+  Error FindInBatchesImpl(
+      const QueryBuilder &qb, size_t batch_size,
+      std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+      std::function<Error(std::vector<std::unique_ptr<ModelBase>> &)>
+          batch_callback) override;
+  Error ProjectImpl(
+      const QueryBuilder &qb,
+      std::function<Error(const QSqlQuery &)> row_callback) override;
 
   std::expected<QVariant, Error>
   Create(ModelBase &model,
@@ -135,22 +153,24 @@ public:
              const std::string &query_string,
              const std::vector<QueryValue> &args = {});
 
+  // internal_db_batch_size 为单条 INSERT 的行数上限；0 表示自动：
+  // 按驱动占位符/语句长度上限与实测延迟自适应调整每条语句的行数。
   template <typename ModelType>
   std::expected<std::vector<std::shared_ptr<ModelType>>, Error>
   CreateBatch(const std::vector<ModelType *> &models,
-              size_t internal_db_batch_size = 100,
+              size_t internal_db_batch_size = 0,
               const OnConflictClause *conflict_options_override = nullptr);
 
   template <typename ModelType>
   std::expected<std::vector<std::shared_ptr<ModelType>>, Error>
   CreateBatch(std::vector<std::unique_ptr<ModelType>> &models,
-              size_t internal_db_batch_size = 100,
+              size_t internal_db_batch_size = 0,
               const OnConflictClause *conflict_options_override = nullptr);
 
   template <typename ModelType>
   std::expected<std::vector<std::shared_ptr<ModelType>>, Error>
   CreateBatch(const std::vector<std::shared_ptr<ModelType>> &models,
-              size_t internal_db_batch_size = 100,
+              size_t internal_db_batch_size = 0,
               const OnConflictClause *conflict_options_override = nullptr);
 
   template <typename ModelType>
@@ -158,13 +178,41 @@ public:
   CreateBatch(std::function<std::optional<std::vector<ModelType *>>()>
                   data_batch_provider_typed,
               const OnConflictClause *conflict_options_override = nullptr,
-              size_t internal_db_batch_processing_size_hint = 100);
+              size_t internal_db_batch_processing_size_hint = 0);
 
   std::expected<size_t, Error> CreateBatchWithMeta(
       const ModelMeta &meta, const std::vector<ModelBase *> &models,
-      size_t internal_batch_processing_size = 100,
+      size_t internal_batch_processing_size = 0,
       const OnConflictClause *conflict_options_override = nullptr);
 
+  // 大批量导入：PostgreSQL 上每轮以一个 JSON 参数经 json_populate_recordset
+  // 插入并经 RETURNING 回填自增主键；其他驱动使用预编译单行 INSERT +
+  // execBatch（不回填自增主键）。调用 beforeCreate/afterCreate 并设置时间戳，
+  // 不支持 OnConflict。返回写入的行数。
+  std::expected<size_t, Error>
+  BulkInsert(const ModelMeta &meta, const std::vector<ModelBase *> &models,
+             size_t rows_per_statement = 10000);
+  template <typename ModelType>
+  std::expected<size_t, Error>
+  BulkInsert(const std::vector<ModelType *> &models,
+             size_t rows_per_statement = 10000);
+
+  // 按主键批量更新多行，每行写入各自的值。columns 为要写入的列（数据库列名
+  // 或 C++ 字段名），为空时写入第一个模型的全部可写非主键列；模型带 UpdatedAt
+  // 时总会一并刷新。MySQL/SQLite 生成 CASE pk WHEN ? THEN ? 形式，PostgreSQL
+  // 生成 UPDATE ... FROM (VALUES ...) 连接。每个模型依次调用 beforeSave/
+  // beforeUpdate 与 afterUpdate/afterSave。batch_size 为 0 时按驱动上限与
+  // 耗时自动确定每条语句的行数。返回受影响的行数。
+  std::expected<long long, Error>
+  UpdateBatch(const ModelMeta &meta, const std::vector<ModelBase *> &models,
+              const std::vector<std::string> &columns = {},
+              size_t batch_size = 0);
+  template <typename ModelType>
+  std::expected<long long, Error>
+  UpdateBatch(const std::vector<ModelType *> &models,
+              const std::vector<std::string> &columns = {},
+              size_t batch_size = 0);
+
   Error CreateBatchProviderInternal(
       QueryBuilder qb_prototype,
       std::function<std::optional<std::vector<ModelBase *>>()>
@@ -173,7 +221,8 @@ public:
           void(const std::vector<ModelBase *> &processed_batch_models_with_ids,
                Error batch_error)>
           per_db_batch_completion_callback,
-      const OnConflictClause *conflict_options_override);
+      const OnConflictClause *conflict_options_override,
+      size_t max_rows_per_statement = 0);
 
   std::expected<long long, Error> Save(ModelBase &model);
   template <typename TModel>
@@ -199,19 +248,34 @@ public:
   std::expected<long long, Error> DeleteBatch(
       const ModelMeta &meta,
       const std::vector<std::map<std::string, QueryValue>> &primary_keys_list,
-      size_t batch_delete_size = 100);
+      size_t batch_delete_size = 0);
 
   std::expected<long long, Error> ExecRaw(const QString &sql,
                                           const QVariantList &args = {});
 
   Error AutoMigrate(const ModelMeta &meta);
-  Error AutoMigrate(const std::vector<const ModelMeta *> &metas);
+  // 一次读取所有表的结构快照后逐表比对，列变更按表合并为一条 ALTER。
+  // 模型结构的 hash 记录在 cpporm_schema_state 表中，与上次成功迁移时
+  // 一致则直接跳过；在 cpporm 之外修改了表结构时传 force = true。
+  Error AutoMigrate(const std::vector<const ModelMeta *> &metas,
+                    bool force = false);
 
   std::expected<std::unique_ptr<Session>, Error> Begin();
   Error Commit();
   Error Rollback();
   bool IsTransaction() const;
 
+  // 会话级标识映射：启用后 First(model, 主键) 对同一主键在本 Session 内
+  // 只读库一次，之后返回首次读取结果的副本。只感知本 Session 的写入。
+  // 进程级二级缓存见 QtDbManager::setModelCacheOptions。
+  void EnableIdentityMap(bool enabled = true);
+  // 丢弃二级缓存与本 Session 标识映射中该模型表的条目；
+  // 经 ExecRaw 或在 cpporm 之外写入该表后调用。
+  void InvalidateCache(const ModelMeta &meta);
+  template <typename T> void InvalidateCache() {
+    InvalidateCache(T::getModelMeta());
+  }
+
   QString getConnectionName() const;
   QSqlDatabase getDbHandle() const;
   const cpporm::OnConflictClause *getTempOnConflictClause() const;
@@ -225,9 +289,15 @@ public:
 
 private:
   // execute_query_internal 保持 private static，将通过 FriendAccess 调用
-  static std::pair<QSqlQuery, Error>
+  // forward_only: 供流式读取使用，不经过语句缓存，exec 前 setForwardOnly(true)
+  // timings: 调用方随后读取结果集时传入，由其 StatementProfile 续记
+  // fetch/map 并按整条语句判断慢查询
+  // 返回的租约在作用域结束时 finish() 语句并将其归还缓存
+  static std::pair<internal::StatementLease, Error>
   execute_query_internal(QSqlDatabase db_conn_val_copy, const QString &sql,
-                         const QVariantList &bound_params);
+                         const QVariantList &bound_params,
+                         bool forward_only = false,
+                         internal::StatementTimings *timings = nullptr);
 
   Error mapRowToModel(QSqlQuery &query, ModelBase &model,
                       const ModelMeta &meta);
@@ -236,25 +306,87 @@ private:
   extractModelData(const ModelBase &model_instance, const ModelMeta &meta,
                    bool for_update = false,
                    bool include_timestamps_even_if_null = false);
+  // 写入成功后把写入的列值记入模型的脏字段快照。replace 为 true 时
+  // 丢弃旧快照（整行写入），否则只覆盖写入的列。
+  // First(model, 主键) 经标识映射与二级缓存读取；未命中时调用 load 读库
+  template <typename T, typename Loader>
+  Error firstByPrimaryKeyCached(T *result_model,
+                                const std::vector<QueryValue> &pk_values,
+                                Loader &&load);
+  // 两级缓存都未启用或主键值无法规范化时返回 nullopt
+  std::optional<internal::ModelCacheKey>
+  modelCacheKeyFor(const ModelMeta &meta,
+                   const std::vector<QueryValue> &pk_values);
+  std::shared_ptr<const ModelBase>
+  lookupCachedModel(const internal::ModelCacheKey &key);
+  void storeCachedModel(const internal::ModelCacheKey &key,
+                        std::shared_ptr<const ModelBase> model,
+                        uint64_t generation);
+  // 写入某表后调用：推进二级缓存中该表的代数并清除标识映射中的条目。
+  // 事务内的写入在 Commit 时再失效一次，因为提交前其他连接仍可能读到
+  // 旧行并写回缓存。
+  void invalidateCachedTable(const std::string &table_name);
+  void invalidateCachedTable(const QueryBuilder &qb);
+  // 二级缓存键的库标识：driver://user@host:port/database。
+  // 不含 schema / search_path，同一库下不同 schema 的同名表会共用缓存条目。
+  const QString &cacheScope();
+
+  static void snapshotWrittenValues(ModelBase &model_instance,
+                                    const ModelMeta &meta,
+                                    const std::map<QString, QVariant> &written,
+                                    bool replace);
   // 授予 FriendAccess 访问权限
   friend class internal_batch_helpers::FriendAccess;
 
   void autoSetTimestamps(ModelBase &model_instance, const ModelMeta &meta,
                          bool is_create_op);
 
+  std::expected<size_t, Error> bulkInsertViaJsonRecordset(
+      const ModelMeta &meta, const std::vector<ModelBase *> &rows_models,
+      const std::vector<internal::SessionModelDataForWrite> &rows_data,
+      const std::vector<QString> &column_names, size_t rows_per_statement);
+  std::expected<size_t, Error> bulkInsertViaExecBatch(
+      const ModelMeta &meta, const std::vector<ModelBase *> &rows_models,
+      const std::vector<internal::SessionModelDataForWrite> &rows_data,
+      const std::vector<QString> &column_names, size_t rows_per_statement);
+
   Error processPreloadsInternal(const QueryBuilder &qb,
                                 std::vector<ModelBase *> &models_raw_ptr);
   Error processPreloads(const QueryBuilder &qb,
                         std::vector<std::unique_ptr<ModelBase>> &loaded_models);
+  // loaded_models_out 非空时输出本次加载到的全部关联模型（去重），
+  // 供嵌套预加载作为下一层的父集合
+  Error executePreloadForAssociation(
+      const AssociationMeta &assoc_meta, const ModelMeta &main_model_meta,
+      std::vector<ModelBase *> &parent_models_raw_ptr,
+      std::vector<std::shared_ptr<ModelBase>> *loaded_models_out = nullptr);
+  Error fetchDirectPreload(const AssociationMeta &assoc_meta,
+                           const ModelMeta &target_model_meta,
+                           const std::string &target_model_key_db_name,
+                           const internal::ModelFactory &target_model_factory,
+                           const std::vector<QueryValue> &unique_key_values,
+                           internal::PreloadBuckets &associated_by_link_key);
   Error
-  executePreloadForAssociation(const AssociationMeta &assoc_meta,
-                               const ModelMeta &main_model_meta,
-                               std::vector<ModelBase *> &parent_models_raw_ptr);
+  fetchManyToManyPreload(const AssociationMeta &assoc_meta,
+                         const ModelMeta &target_model_meta,
+                         const internal::ModelFactory &target_model_factory,
+                         const std::vector<QueryValue> &unique_key_values,
+                         internal::PreloadBuckets &associated_by_link_key);
 
   QString connection_name_;
   QSqlDatabase db_handle_;
   bool is_explicit_transaction_handle_;
   std::unique_ptr<OnConflictClause> temp_on_conflict_clause_;
+  // 连接名注册了 QtDbPool 时借用的本线程连接；Begin() 返回的事务 Session
+  // 共享同一租约，保证事务结束前连接不会被归还。
+  std::shared_ptr<QtDbPool::Lease> pool_lease_;
+  bool identity_map_enabled_ = false;
+  std::unordered_map<internal::ModelCacheKey,
+                     std::shared_ptr<const ModelBase>,
+                     internal::ModelCacheKeyHash>
+      identity_map_;
+  QString cache_scope_; // 由 cacheScope() 按需计算
+  std::vector<std::string> tx_written_tables_;
 
 public:
   static QueryValue anyToQueryValueForSessionConvenience(const std::any &val);
@@ -36,7 +36,10 @@ inline Error Session::First(T *result_model,
                             const QueryValue &primary_key_value) {
   static_assert(std::is_base_of<ModelBase, T>::value,
                 "T must be a descendant of cpporm::ModelBase");
-  return this->Model<T>().First(result_model, primary_key_value);
+  return this->firstByPrimaryKeyCached(
+      result_model, {primary_key_value}, [&]() {
+        return this->Model<T>().First(result_model, primary_key_value);
+      });
 }
 
 template <typename T>
@@ -44,7 +47,47 @@ inline Error Session::First(T *result_model,
                             const std::vector<QueryValue> &primary_key_values) {
   static_assert(std::is_base_of<ModelBase, T>::value,
                 "T must be a descendant of cpporm::ModelBase");
-  return this->Model<T>().First(result_model, primary_key_values);
+  return this->firstByPrimaryKeyCached(
+      result_model, primary_key_values, [&]() {
+        return this->Model<T>().First(result_model, primary_key_values);
+      });
+}
+
+// 缓存保存的是 afterFind 之后的副本，命中时不再调用 afterFind。
+// 不可复制的模型类型不经过缓存。
+template <typename T, typename Loader>
+inline Error
+Session::firstByPrimaryKeyCached(T *result_model,
+                                 const std::vector<QueryValue> &pk_values,
+                                 Loader &&load) {
+  if constexpr (!std::is_copy_constructible_v<T> ||
+                !std::is_copy_assignable_v<T>) {
+    return load();
+  } else {
+    if (!result_model)
+      return load();
+    std::optional<internal::ModelCacheKey> key =
+        this->modelCacheKeyFor(T::getModelMeta(), pk_values);
+    if (!key)
+      return load();
+
+    if (std::shared_ptr<const ModelBase> cached =
+            this->lookupCachedModel(*key)) {
+      if (const T *typed = dynamic_cast<const T *>(cached.get())) {
+        *result_model = *typed;
+        return make_ok();
+      }
+    }
+    const uint64_t generation =
+        internal::ModelCache::instance().tableGeneration(
+            key->scope, key->meta->table_name);
+    Error err = load();
+    if (!err) {
+      this->storeCachedModel(*key, std::make_shared<const T>(*result_model),
+                             generation);
+    }
+    return err;
+  }
 }
 
 template <typename T>
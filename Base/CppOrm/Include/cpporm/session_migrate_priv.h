@@ -5,8 +5,11 @@
 #include "cpporm/error.h"
 #include "cpporm/model_base.h"
 #include <QSqlDatabase>
+#include <QSqlQuery>
 #include <QString>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -16,6 +19,16 @@ class Session;
 
 namespace internal {
 
+struct SchemaSnapshot;
+
+// 单次迁移的上下文。snapshot 为空时各阶段逐表内省（原有行为）。
+// ddl_failed 记录是否有 DDL 失败（失败只告警不中断迁移），
+// 此时不写入 schema hash，下次启动会重新比对。
+struct MigrationContext {
+  const SchemaSnapshot *snapshot = nullptr;
+  bool ddl_failed = false;
+};
+
 // --- Table Operations ---
 Error migrateCreateTable(Session &session, const ModelMeta &meta,
                          const QString &driverNameUpper);
@@ -35,8 +48,13 @@ struct DbColumnInfo {
 std::map<std::string, DbColumnInfo>
 getTableColumnsInfo(Session &session, const QString &tableName,
                     const QString &driverNameUpper);
+// 按驱动解析一行列信息（SHOW FULL COLUMNS / information_schema.columns /
+// PRAGMA table_xinfo 的列名）
+DbColumnInfo readDbColumnInfo(const QSqlQuery &query,
+                              const QString &driverNameUpper);
 Error migrateModifyColumns(Session &session, const ModelMeta &meta,
-                           const QString &driverNameUpper);
+                           const QString &driverNameUpper,
+                           MigrationContext &context);
 
 // --- Index Operations ---
 struct DbIndexInfo {
@@ -46,11 +64,40 @@ struct DbIndexInfo {
   bool is_primary_key = false;
   std::string type_method;
 };
+
+// 一次读取的多表结构快照：AutoMigrate(vector) 先用 information_schema
+// （SQLite 用 pragma 表值函数）一次性读出所有模型表的列与索引，
+// 再逐表在内存中比对，省去每张表各自的内省查询。
+struct SchemaSnapshot {
+  std::set<std::string> tables;
+  std::map<std::string, std::map<std::string, DbColumnInfo>> columns;
+  std::map<std::string, std::map<std::string, DbIndexInfo>> indexes;
+};
+
 std::map<std::string, DbIndexInfo>
 getTableIndexesInfo(Session &session, const QString &tableName,
                     const QString &driverNameUpper);
 Error migrateManageIndexes(Session &session, const ModelMeta &meta,
-                           const QString &driverNameUpper);
+                           const QString &driverNameUpper,
+                           MigrationContext &context);
+
+// --- Schema Snapshot ---
+// 驱动不支持或查询失败时返回 std::nullopt，调用方退回逐表内省
+std::optional<SchemaSnapshot>
+loadSchemaSnapshot(Session &session, const std::vector<std::string> &tables,
+                   const QString &driverNameUpper);
+
+// --- Schema Hash ---
+// 模型期望结构（表、列类型与约束、索引）的摘要。与库中记录的一致时
+// AutoMigrate(vector) 直接跳过。
+QString computeSchemaHash(const std::vector<const ModelMeta *> &metas,
+                          const QString &driverNameUpper);
+// 同一数据库可被多组模型共享，按表名集合区分记录
+QString schemaStateKey(const std::vector<const ModelMeta *> &metas);
+std::optional<QString> readStoredSchemaHash(Session &session,
+                                            const QString &state_key);
+Error storeSchemaHash(Session &session, const QString &state_key,
+                      const QString &schema_hash);
 
 // Helper for executing DDL - now takes QSqlDatabase by value (copy)
 std::pair<QSqlQuery, Error> execute_ddl_query(QSqlDatabase db,
@@ -3,6 +3,7 @@
 #define cpporm_SESSION_PRIV_BATCH_HELPERS_H
 
 #include "cpporm/error.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/session_fwd.h"
 #include "cpporm/session_types.h" // <<<<<<<< 包含 internal::SessionModelDataForWrite 定义
 // #include "cpporm/builder_parts/query_builder_state_fwd.h" //
@@ -39,7 +40,7 @@ public:
                        const ModelMeta &meta, bool for_update,
                        bool include_timestamps_even_if_null);
 
-  static std::pair<QSqlQuery, Error> callExecuteQueryInternal(
+  static std::pair<internal::StatementLease, Error> callExecuteQueryInternal(
       // Session& s, // 不需要 Session 实例，因为 execute_query_internal
       // 是静态的
       QSqlDatabase db, // 直接传递 QSqlDatabase
@@ -61,7 +62,7 @@ struct BatchSqlParts {
 };
 
 struct ExecutionResult {
-  QSqlQuery query_object;
+  internal::StatementLease statement; // 作用域结束时 finish() 并归还缓存
   long long rows_affected = -1;
   Error db_error = make_ok();
   std::vector<ModelBase *> models_potentially_persisted;
@@ -0,0 +1,94 @@
+// cpporm/adaptive_batch_sizer.cpp
+#include "cpporm/adaptive_batch_sizer.h"
+
+#include <QByteArray>
+#include <QMetaType>
+#include <algorithm>
+
+namespace cpporm {
+namespace internal {
+
+DriverBatchLimits batchLimitsForDriver(const QString &driver_name_upper) {
+  // PostgreSQL / MySQL 协议以 16 位整数表示参数个数
+  if (driver_name_upper == "QPSQL")
+    return {65535, size_t(1) << 30};
+  if (driver_name_upper == "QMYSQL" || driver_name_upper == "QMARIADB")
+    // max_allowed_packet 在 5.7 的默认值为 4MB，按该值保守估计
+    return {65535, size_t(4) << 20};
+  if (driver_name_upper == "QSQLITE")
+    // SQLITE_MAX_VARIABLE_NUMBER（3.32 起默认 32766）
+    return {32766, size_t(1) << 30};
+  if (driver_name_upper == "QODBC")
+    // SQL Server 单条语句最多 2100 个参数
+    return {2100, size_t(64) << 20};
+  return {999, size_t(16) << 20};
+}
+
+size_t estimateRowBytes(const std::map<QString, QVariant> &row_values) {
+  size_t bytes = 0;
+  for (const auto &pair : row_values) {
+    const QVariant &value = pair.second;
+    switch (value.typeId()) {
+    case QMetaType::QString:
+      bytes += static_cast<size_t>(value.toString().size()) * 3;
+      break;
+    case QMetaType::QByteArray:
+      bytes += static_cast<size_t>(value.toByteArray().size());
+      break;
+    default:
+      bytes += 16;
+      break;
+    }
+    // 占位符、分隔符与协议开销
+    bytes += 4;
+  }
+  return bytes;
+}
+
+AdaptiveBatchSizer::AdaptiveBatchSizer(const QString &driver_name_upper,
+                                       size_t placeholders_per_row,
+                                       size_t estimated_bytes_per_row,
+                                       size_t requested_max_rows,
+                                       size_t reserved_placeholders) {
+  const DriverBatchLimits limits = batchLimitsForDriver(driver_name_upper);
+  size_t max_rows = static_cast<size_t>(-1);
+  if (placeholders_per_row > 0) {
+    const size_t available =
+        limits.max_placeholders > reserved_placeholders
+            ? limits.max_placeholders - reserved_placeholders
+            : 0;
+    max_rows = available / placeholders_per_row;
+  }
+  if (estimated_bytes_per_row > 0) {
+    // SQL 文本与报文头预留一半余量
+    max_rows = std::min(max_rows, limits.max_statement_bytes / 2 /
+                                      estimated_bytes_per_row);
+  }
+  if (requested_max_rows > 0)
+    max_rows = std::min(max_rows, requested_max_rows);
+  max_rows_ = std::max<size_t>(max_rows, 1);
+  current_rows_ = std::min(kInitialRows, max_rows_);
+}
+
+void AdaptiveBatchSizer::recordBatch(size_t rows,
+                                     std::chrono::nanoseconds elapsed) {
+  if (rows == 0 || elapsed.count() <= 0)
+    return;
+  const auto target =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          kTargetStatementLatency);
+  size_t next = current_rows_;
+  if (elapsed > target) {
+    // 按比例缩到目标耗时附近
+    const double scale = static_cast<double>(target.count()) /
+                         static_cast<double>(elapsed.count());
+    next = std::max<size_t>(1, static_cast<size_t>(rows * scale));
+  } else if (elapsed * 2 < target && rows >= current_rows_) {
+    // 只有满批且耗时充裕时才放大，避免尾批误导
+    next = current_rows_ * 2;
+  }
+  current_rows_ = std::clamp<size_t>(next, 1, max_rows_);
+}
+
+} // namespace internal
+} // namespace cpporm
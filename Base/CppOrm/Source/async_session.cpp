@@ -0,0 +1,133 @@
+// cpporm/async_session.cpp
+#include "cpporm/async_session.h"
+#include "cpporm/qt_db_manager.h"
+
+#include <QDebug>
+
+namespace cpporm {
+
+std::expected<std::unique_ptr<AsyncSession>, Error>
+AsyncSession::create(const QString &connection_name,
+                     const AsyncSessionOptions &options) {
+  if (options.worker_threads == 0) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "AsyncSession::create: worker_threads must be greater than 0."));
+  }
+
+  // 工作线程不能使用其他线程打开的连接，必须经连接池各自克隆。
+  // 连接池由调用方注册：它会改变进程内所有同名 Session 的连接来源
+  std::shared_ptr<QtDbPool> pool = QtDbPool::find(connection_name);
+  if (!pool) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "AsyncSession::create: no QtDbPool is registered for "
+              "connection '" +
+                  connection_name.toStdString() +
+                  "'. Call QtDbPool::create first."));
+  }
+  if (pool->options().max_connections < options.worker_threads) {
+    qWarning() << "cpporm AsyncSession: pool for" << connection_name
+               << "allows only" << pool->options().max_connections
+               << "connections for" << options.worker_threads
+               << "workers; extra workers will wait for a connection.";
+  }
+
+  std::unique_ptr<AsyncSession> session(
+      new AsyncSession(connection_name, std::move(pool)));
+  session->start(options.worker_threads);
+  return session;
+}
+
+AsyncSession::AsyncSession(QString connection_name,
+                           std::shared_ptr<QtDbPool> pool)
+    : connection_name_(std::move(connection_name)), pool_(std::move(pool)) {}
+
+AsyncSession::~AsyncSession() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_available_.notify_all();
+  for (std::thread &worker : workers_) {
+    if (worker.joinable())
+      worker.join();
+  }
+}
+
+void AsyncSession::start(size_t worker_threads) {
+  workers_.reserve(worker_threads);
+  for (size_t i = 0; i < worker_threads; ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+void AsyncSession::enqueue(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      qWarning() << "cpporm AsyncSession: task submitted after shutdown on"
+                 << connection_name_ << "was discarded.";
+      return;
+    }
+    tasks_.push_back(std::move(task));
+  }
+  task_available_.notify_one();
+}
+
+void AsyncSession::workerLoop() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock,
+                           [this]() { return stopping_ || !tasks_.empty(); });
+      // 停止时先执行完队列中剩余的任务
+      if (tasks_.empty())
+        break;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    // 每个任务一个 Session：借用本线程在池中的空闲连接，任务结束即归还
+    Session session(connection_name_);
+    task(session);
+  }
+  pool_->releaseThreadConnections();
+}
+
+size_t AsyncSession::pendingTasks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tasks_.size();
+}
+
+QueryBuilder AsyncSession::Model(const ModelMeta &meta) const {
+  return QueryBuilder(nullptr, connection_name_, &meta);
+}
+
+std::future<std::expected<int64_t, Error>>
+AsyncSession::Count(QueryBuilder qb) {
+  return Submit([qb = std::move(qb)](Session &session) mutable {
+    qb.BindExecutor(&session, session.getConnectionName());
+    return qb.Count();
+  });
+}
+
+std::future<std::expected<long long, Error>>
+AsyncSession::Updates(QueryBuilder qb,
+                      std::map<std::string, QueryValue> updates) {
+  return Submit([qb = std::move(qb), updates = std::move(updates)](
+                    Session &session) mutable {
+    qb.BindExecutor(&session, session.getConnectionName());
+    return qb.Updates(updates);
+  });
+}
+
+std::future<std::expected<long long, Error>>
+AsyncSession::Delete(QueryBuilder qb) {
+  return Submit([qb = std::move(qb)](Session &session) mutable {
+    qb.BindExecutor(&session, session.getConnectionName());
+    return qb.Delete();
+  });
+}
+
+} // namespace cpporm
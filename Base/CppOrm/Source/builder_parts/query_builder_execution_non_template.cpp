@@ -102,6 +102,48 @@ Error QueryBuilder::Find(
   return executor_->FindImpl(*this, results_vector, element_type_factory);
 }
 
+Error QueryBuilder::FindEach(
+    std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+    std::function<Error(ModelBase &)> row_callback) {
+  if (!executor_)
+    return Error(ErrorCode::InternalError, "QueryBuilder has no executor.");
+  if (!element_type_factory || !row_callback)
+    return Error(ErrorCode::InternalError,
+                 "FindEach requires an element factory and a row callback.");
+
+  if (!this->state_.model_meta_) {
+    auto temp_instance = element_type_factory();
+    if (!temp_instance)
+      return Error(ErrorCode::InternalError,
+                   "Model factory returned nullptr for FindEach.");
+    this->Model(temp_instance->_getOwnModelMeta());
+  }
+  return executor_->FindEachImpl(*this, element_type_factory, row_callback);
+}
+
+Error QueryBuilder::FindInBatches(
+    size_t batch_size,
+    std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+    std::function<Error(std::vector<std::unique_ptr<ModelBase>> &)>
+        batch_callback) {
+  if (!executor_)
+    return Error(ErrorCode::InternalError, "QueryBuilder has no executor.");
+  if (!element_type_factory || !batch_callback)
+    return Error(
+        ErrorCode::InternalError,
+        "FindInBatches requires an element factory and a batch callback.");
+
+  if (!this->state_.model_meta_) {
+    auto temp_instance = element_type_factory();
+    if (!temp_instance)
+      return Error(ErrorCode::InternalError,
+                   "Model factory returned nullptr for FindInBatches.");
+    this->Model(temp_instance->_getOwnModelMeta());
+  }
+  return executor_->FindInBatchesImpl(*this, batch_size, element_type_factory,
+                                      batch_callback);
+}
+
 std::expected<QVariant, Error>
 QueryBuilder::Create(ModelBase &model,
                      const OnConflictClause *conflict_options_override) {
@@ -174,4 +216,23 @@ std::expected<int64_t, Error> QueryBuilder::Count() {
   return executor_->CountImpl(*this);
 }
 
+Error QueryBuilder::Project(
+    const std::vector<std::string> &columns,
+    std::function<Error(const QSqlQuery &)> row_callback) const {
+  if (!executor_)
+    return Error(ErrorCode::InternalError, "QueryBuilder has no executor.");
+  if (columns.empty())
+    return Error(ErrorCode::InvalidConfiguration,
+                 "Projection requires at least one column.");
+  if (!this->state_.model_meta_ &&
+      (this->state_.from_clause_source_.index() == 0 &&
+       std::get<std::string>(this->state_.from_clause_source_).empty())) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "Projection requires a Model or Table to be set.");
+  }
+  QueryBuilder projected(*this);
+  projected.Select(columns);
+  return executor_->ProjectImpl(projected, std::move(row_callback));
+}
+
 } // namespace cpporm
\ No newline at end of file
@@ -47,4 +47,11 @@ QueryBuilder &QueryBuilder::operator=(QueryBuilder &&other) noexcept {
 
 QueryBuilder::~QueryBuilder() = default;
 
+QueryBuilder &QueryBuilder::BindExecutor(IQueryExecutor *executor,
+                                         QString connection_name) {
+  this->executor_ = executor;
+  this->connection_name_ = std::move(connection_name);
+  return *this;
+}
+
 } // namespace cpporm
\ No newline at end of file
@@ -1,15 +1,164 @@
+#include "cpporm/compiled_sql_cache.h"
 #include "cpporm/model_base.h"    // For ModelMeta, FieldMeta, FieldFlag
 #include "cpporm/query_builder.h" // Includes QueryBuilderState via query_builder.h -> query_builder_core.h -> ..._state.h
 
 #include <QDebug>
 #include <QMetaType>
+#include <cstdint>
 #include <sstream>
 #include <variant> // For std::visit
 
 namespace cpporm {
 
+namespace {
+
+constexpr char kShapeFieldSeparator = '\x1f';
+constexpr char kShapeSectionSeparator = '\x1e';
+
+// 条件组写入形状键；参数中含子查询（其 SQL 被内联）时不可缓存。
+bool appendConditionsShape(std::string &shape_key,
+                           const std::vector<Condition> &conditions) {
+  for (const Condition &cond : conditions) {
+    for (const QueryValue &arg : cond.args) {
+      if (std::holds_alternative<SubqueryExpression>(arg))
+        return false;
+    }
+    shape_key += cond.query_string;
+    shape_key += kShapeFieldSeparator;
+    shape_key += std::to_string(cond.args.size());
+    shape_key += kShapeFieldSeparator;
+  }
+  shape_key += kShapeSectionSeparator;
+  return true;
+}
+
+void appendConditionBindings(QVariantList &bound_params_accumulator,
+                             const std::vector<Condition> &conditions) {
+  for (const Condition &cond : conditions) {
+    for (const QueryValue &arg : cond.args) {
+      bound_params_accumulator.append(
+          QueryBuilder::toQVariant(arg, bound_params_accumulator));
+    }
+  }
+}
+
+} // namespace
+
 std::pair<QString, QVariantList>
 QueryBuilder::buildSelectSQL(bool for_subquery_generation) const {
+  std::string shape_key;
+  if (!build_select_shape_key(for_subquery_generation, shape_key)) {
+    return build_select_sql_uncached(for_subquery_generation);
+  }
+
+  auto &sql_cache = internal::CompiledSqlCache::instance();
+  if (std::optional<QString> cached_sql = sql_cache.lookup(shape_key)) {
+    QVariantList bound_params;
+    collect_select_bindings(for_subquery_generation, bound_params);
+    return {std::move(*cached_sql), std::move(bound_params)};
+  }
+
+  auto built = build_select_sql_uncached(for_subquery_generation);
+  // 占位符与参数个数不一致时（已有警告），完整构建只绑定部分参数，
+  // 与快速收集的结果不同，这类形状不缓存。
+  QVariantList collected_params;
+  collect_select_bindings(for_subquery_generation, collected_params);
+  if (collected_params.size() == built.second.size()) {
+    sql_cache.store(shape_key, built.first);
+  }
+  return built;
+}
+
+bool QueryBuilder::build_select_shape_key(bool for_subquery_generation,
+                                          std::string &shape_key) const {
+  if (!state_.ctes_.empty() ||
+      !std::holds_alternative<std::string>(state_.from_clause_source_)) {
+    return false;
+  }
+  const QString from_name = getFromSourceName();
+  if (from_name.isEmpty()) {
+    return false;
+  }
+
+  shape_key.reserve(256);
+  // 连接名决定 MySQL 方言分支（列表达式、OFFSET 写法）
+  shape_key += connection_name_.toStdString();
+  shape_key += kShapeSectionSeparator;
+  shape_key += from_name.toStdString();
+  shape_key += kShapeSectionSeparator;
+  shape_key +=
+      std::to_string(reinterpret_cast<std::uintptr_t>(state_.model_meta_));
+  shape_key += kShapeSectionSeparator;
+  shape_key += state_.apply_distinct_ ? 'D' : '-';
+  shape_key += state_.apply_soft_delete_scope_ ? 'S' : '-';
+  shape_key += for_subquery_generation ? 'Q' : '-';
+  shape_key += state_.limit_val_ > 0 ? 'L' : '-';
+  shape_key += state_.offset_val_ >= 0 ? 'O' : '-';
+  shape_key += kShapeSectionSeparator;
+
+  for (const SelectField &field : state_.select_fields_) {
+    if (!std::holds_alternative<std::string>(field)) {
+      return false;
+    }
+    shape_key += std::get<std::string>(field);
+    shape_key += kShapeFieldSeparator;
+  }
+  shape_key += kShapeSectionSeparator;
+
+  for (const JoinClause &join : state_.join_clauses_) {
+    shape_key += join.join_type;
+    shape_key += kShapeFieldSeparator;
+    shape_key += join.table_to_join;
+    shape_key += kShapeFieldSeparator;
+    shape_key += join.on_condition;
+    shape_key += kShapeFieldSeparator;
+  }
+  shape_key += kShapeSectionSeparator;
+
+  if (!appendConditionsShape(shape_key, state_.where_conditions_) ||
+      !appendConditionsShape(shape_key, state_.or_conditions_) ||
+      !appendConditionsShape(shape_key, state_.not_conditions_)) {
+    return false;
+  }
+
+  shape_key += state_.group_clause_;
+  shape_key += kShapeSectionSeparator;
+  if (!state_.group_clause_.empty() && state_.having_condition_) {
+    if (!appendConditionsShape(shape_key, {*state_.having_condition_})) {
+      return false;
+    }
+  }
+  shape_key += state_.order_clause_;
+  return true;
+}
+
+// 与 build_select_sql_uncached 的绑定顺序保持一致：
+// WHERE / OR / NOT 条件 → HAVING → LIMIT → OFFSET。
+void QueryBuilder::collect_select_bindings(
+    bool for_subquery_generation,
+    QVariantList &bound_params_accumulator) const {
+  appendConditionBindings(bound_params_accumulator, state_.where_conditions_);
+  appendConditionBindings(bound_params_accumulator, state_.or_conditions_);
+  appendConditionBindings(bound_params_accumulator, state_.not_conditions_);
+  if (!state_.group_clause_.empty() && state_.having_condition_) {
+    for (const QueryValue &arg : state_.having_condition_->args) {
+      bound_params_accumulator.append(
+          QueryBuilder::toQVariant(arg, bound_params_accumulator));
+    }
+  }
+  if (for_subquery_generation) {
+    return;
+  }
+  if (state_.limit_val_ > 0) {
+    bound_params_accumulator.append(state_.limit_val_);
+  }
+  if (state_.offset_val_ >= 0) {
+    bound_params_accumulator.append(state_.offset_val_);
+  }
+}
+
+std::pair<QString, QVariantList>
+QueryBuilder::build_select_sql_uncached(bool for_subquery_generation) const {
   std::ostringstream sql_stream;
   QVariantList bound_params_accumulator;
 
@@ -0,0 +1,66 @@
+// cpporm/compiled_sql_cache.cpp
+#include "cpporm/compiled_sql_cache.h"
+
+namespace cpporm {
+namespace internal {
+
+CompiledSqlCache &CompiledSqlCache::instance() {
+  static CompiledSqlCache *cache = new CompiledSqlCache();
+  return *cache;
+}
+
+std::optional<QString> CompiledSqlCache::lookup(const std::string &shape_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(shape_key);
+  if (it == index_.end())
+    return std::nullopt;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->second;
+}
+
+void CompiledSqlCache::store(const std::string &shape_key, const QString &sql) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0)
+    return;
+  auto it = index_.find(shape_key);
+  if (it != index_.end()) {
+    it->second->second = sql;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.emplace_front(shape_key, sql);
+  index_.emplace(shape_key, lru_.begin());
+  trimLocked();
+}
+
+void CompiledSqlCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  lru_.clear();
+}
+
+void CompiledSqlCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  trimLocked();
+}
+
+size_t CompiledSqlCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+size_t CompiledSqlCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lru_.size();
+}
+
+void CompiledSqlCache::trimLocked() {
+  while (lru_.size() > capacity_) {
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+}
+
+} // namespace internal
+} // namespace cpporm
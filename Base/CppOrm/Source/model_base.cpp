@@ -26,6 +26,28 @@ std::mutex &getGlobalModelFinalizersRegistryMutex() {
 
 } // namespace internal
 
+void ModelMeta::_buildLookupIndexes() {
+  _field_id_by_db_name.clear();
+  _field_id_by_cpp_name.clear();
+  _association_index_by_cpp_name.clear();
+  _field_id_by_db_name.reserve(fields.size());
+  _field_id_by_cpp_name.reserve(fields.size());
+  _association_index_by_cpp_name.reserve(associations.size());
+
+  // emplace 不覆盖已有键：与线性查找一样，重名时命中第一个
+  for (FieldId id = 0; id < fields.size(); ++id) {
+    FieldMeta &field = fields[id];
+    field.field_id = id;
+    if (!field.db_name.empty())
+      _field_id_by_db_name.emplace(field.db_name, id);
+    _field_id_by_cpp_name.emplace(field.cpp_name, id);
+  }
+  for (size_t i = 0; i < associations.size(); ++i) {
+    _association_index_by_cpp_name.emplace(associations[i].cpp_field_name, i);
+  }
+  _lookup_indexes_built = true;
+}
+
 // Definition for the user-callable global finalization function
 void finalize_all_model_meta() {
   // It's crucial that this function is called *after* all static initializers
@@ -41,6 +63,7 @@ void finalize_all_model_meta() {
     finalizers_copy = internal::getGlobalModelFinalizerFunctions();
   }
 
+  // 每个 finalizer 在完成时为其 ModelMeta 建立名称哈希索引与 field_id。
   // Sort finalizers? Not strictly necessary if _finalizeModelMeta is idempotent
   // and handles its dependencies gracefully (which it tries to, but typeid
   // makes it tricky). For now, call in registration order. A more robust system
@@ -0,0 +1,130 @@
+// cpporm/model_cache.cpp
+#include "cpporm/model_cache.h"
+#include "cpporm/model_base.h"
+
+#include <QHash>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace cpporm {
+namespace internal {
+
+size_t ModelCacheKeyHash::operator()(const ModelCacheKey &key) const {
+  size_t h = qHash(key.scope);
+  h ^= std::hash<const ModelMeta *>{}(key.meta) + 0x9e3779b97f4a7c15ULL +
+       (h << 6) + (h >> 2);
+  PreloadKeyHash value_hash;
+  for (const PreloadKey &value : key.primary_key) {
+    h ^= value_hash(value) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  }
+  return h;
+}
+
+ModelCache &ModelCache::instance() {
+  // 故意不析构：进程退出时模型的静态元数据可能已先行销毁
+  static ModelCache *cache = new ModelCache();
+  return *cache;
+}
+
+void ModelCache::setOptions(size_t max_entries,
+                            std::chrono::milliseconds ttl) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_entries_ = max_entries;
+  ttl_ = ttl;
+  trimLocked();
+}
+
+bool ModelCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_entries_ > 0;
+}
+
+std::shared_ptr<const ModelBase> ModelCache::lookup(const ModelCacheKey &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (max_entries_ == 0)
+    return nullptr;
+  auto it = index_.find(key);
+  if (it == index_.end())
+    return nullptr;
+  Entry &entry = *it->second;
+  if (Clock::now() >= entry.expires_at ||
+      entry.generation !=
+          tableGenerationLocked(key.scope, key.meta->table_name)) {
+    eraseLocked(it->second);
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return entry.model;
+}
+
+void ModelCache::store(const ModelCacheKey &key,
+                       std::shared_ptr<const ModelBase> model,
+                       uint64_t generation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (max_entries_ == 0 || !model)
+    return;
+  // 读库期间该表有写入，读到的行可能已过时
+  if (generation != tableGenerationLocked(key.scope, key.meta->table_name))
+    return;
+  const Clock::time_point expires_at = Clock::now() + ttl_;
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Entry &entry = *it->second;
+    entry.model = std::move(model);
+    entry.generation = generation;
+    entry.expires_at = expires_at;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.push_front({key, std::move(model), generation, expires_at});
+  index_.emplace(key, lru_.begin());
+  trimLocked();
+}
+
+uint64_t ModelCache::tableGeneration(const QString &scope,
+                                     const std::string &table_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tableGenerationLocked(scope, table_name);
+}
+
+uint64_t
+ModelCache::tableGenerationLocked(const QString &scope,
+                                  const std::string &table_name) const {
+  auto it = table_generations_.find({scope, table_name});
+  if (it == table_generations_.end())
+    return epoch_;
+  return std::max(epoch_, it->second);
+}
+
+void ModelCache::invalidateTable(const QString &scope,
+                                 const std::string &table_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  table_generations_[{scope, table_name}] = ++counter_;
+}
+
+void ModelCache::invalidateAll() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  epoch_ = ++counter_;
+  index_.clear();
+  lru_.clear();
+}
+
+size_t ModelCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lru_.size();
+}
+
+void ModelCache::eraseLocked(EntryList::iterator it) {
+  index_.erase(it->key);
+  lru_.erase(it);
+}
+
+void ModelCache::trimLocked() {
+  while (lru_.size() > max_entries_) {
+    eraseLocked(std::prev(lru_.end()));
+  }
+}
+
+} // namespace internal
+} // namespace cpporm
@@ -0,0 +1,94 @@
+// cpporm/preload_key.cpp
+#include "cpporm/preload_key.h"
+
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QDebug>
+#include <QMetaType>
+#include <QString>
+#include <limits>
+
+namespace cpporm {
+namespace internal {
+
+std::optional<PreloadKey> makePreloadKey(const std::any &value) {
+  if (!value.has_value())
+    return std::nullopt;
+
+  const auto &type = value.type();
+  if (type == typeid(int))
+    return PreloadKey(static_cast<long long>(std::any_cast<int>(value)));
+  if (type == typeid(long long))
+    return PreloadKey(std::any_cast<long long>(value));
+  if (type == typeid(unsigned int))
+    return PreloadKey(
+        static_cast<long long>(std::any_cast<unsigned int>(value)));
+  if (type == typeid(unsigned long long)) {
+    const unsigned long long v = std::any_cast<unsigned long long>(value);
+    if (v <= static_cast<unsigned long long>(
+                 std::numeric_limits<long long>::max()))
+      return PreloadKey(static_cast<long long>(v));
+    return PreloadKey(v);
+  }
+  if (type == typeid(bool))
+    return PreloadKey(static_cast<long long>(std::any_cast<bool>(value)));
+  if (type == typeid(std::string))
+    return PreloadKey(std::any_cast<std::string>(value));
+  if (type == typeid(const char *))
+    return PreloadKey(std::string(std::any_cast<const char *>(value)));
+  if (type == typeid(double))
+    return PreloadKey(std::any_cast<double>(value));
+  if (type == typeid(float))
+    return PreloadKey(static_cast<double>(std::any_cast<float>(value)));
+  if (type == typeid(QDateTime)) {
+    const QDateTime dt = std::any_cast<QDateTime>(value);
+    if (!dt.isValid())
+      return std::nullopt;
+    return PreloadKey(dt.toUTC().toString(Qt::ISODateWithMs).toStdString());
+  }
+  if (type == typeid(QDate)) {
+    const QDate d = std::any_cast<QDate>(value);
+    if (!d.isValid())
+      return std::nullopt;
+    return PreloadKey(d.toString(Qt::ISODate).toStdString());
+  }
+
+  qWarning() << "cpporm makePreloadKey: Unsupported key type"
+             << value.type().name() << "for preload join.";
+  return std::nullopt;
+}
+
+std::optional<PreloadKey> makePreloadKeyFromVariant(const QVariant &value) {
+  if (!value.isValid() || value.isNull())
+    return std::nullopt;
+
+  switch (value.typeId()) {
+  case QMetaType::Int:
+  case QMetaType::UInt:
+  case QMetaType::LongLong:
+  case QMetaType::Short:
+  case QMetaType::UShort:
+  case QMetaType::Bool:
+    return PreloadKey(value.toLongLong());
+  case QMetaType::ULongLong:
+    return makePreloadKey(std::any(value.toULongLong()));
+  case QMetaType::Double:
+  case QMetaType::Float:
+    return PreloadKey(value.toDouble());
+  case QMetaType::QByteArray: {
+    const QByteArray bytes = value.toByteArray();
+    return PreloadKey(
+        std::string(bytes.constData(), static_cast<size_t>(bytes.size())));
+  }
+  case QMetaType::QDateTime:
+    return makePreloadKey(std::any(value.toDateTime()));
+  case QMetaType::QDate:
+    return makePreloadKey(std::any(value.toDate()));
+  default:
+    return PreloadKey(value.toString().toStdString());
+  }
+}
+
+} // namespace internal
+} // namespace cpporm
@@ -0,0 +1,201 @@
+// cpporm/prepared_statement_cache.cpp
+#include "cpporm/prepared_statement_cache.h"
+
+namespace cpporm {
+namespace internal {
+
+// --- StatementLease ---
+
+StatementLease::StatementLease(std::unique_ptr<QSqlQuery> query)
+    : query_(std::move(query)) {}
+
+StatementLease &StatementLease::operator=(StatementLease &&other) noexcept {
+  if (this != &other) {
+    release();
+    query_ = std::move(other.query_);
+    cacheable_ = other.cacheable_;
+    connection_name_ = std::move(other.connection_name_);
+    sql_ = std::move(other.sql_);
+    generation_ = other.generation_;
+  }
+  return *this;
+}
+
+void StatementLease::release() {
+  if (!query_)
+    return;
+  // 结果集不能挂在缓存里，QSQLITE 上还会一直持有读锁
+  if (query_->isActive())
+    query_->finish();
+  if (cacheable_)
+    PreparedStatementCache::instance().giveBack(*this);
+  query_.reset();
+}
+
+// --- PreparedStatementCache ---
+
+PreparedStatementCache &PreparedStatementCache::instance() {
+  // 故意不析构：进程退出时 QSqlDatabase/驱动插件可能已先行卸载，
+  // 此时再销毁缓存的 QSqlQuery 并不安全。
+  static PreparedStatementCache *cache = new PreparedStatementCache();
+  return *cache;
+}
+
+StatementLease PreparedStatementCache::acquire(const QString &connection_name,
+                                               const QString &sql) {
+  Dropped dropped; // 在锁释放后销毁
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  StatementLease lease;
+  if (capacity_per_connection_ == 0)
+    return lease;
+  auto conn_it =
+      connections_.find(Key(connection_name, std::this_thread::get_id()));
+  if (conn_it == connections_.end())
+    return lease;
+  ConnectionStatements &statements = conn_it->second;
+  auto it = statements.index.find(sql);
+  if (it == statements.index.end())
+    return lease;
+
+  lease.query_ = std::move(it->second->second);
+  lease.cacheable_ = true;
+  lease.connection_name_ = connection_name;
+  lease.sql_ = sql;
+  lease.generation_ = statements.generation;
+  statements.lru.erase(it->second);
+  statements.index.erase(it);
+  return lease;
+}
+
+StatementLease
+PreparedStatementCache::adopt(const QString &connection_name,
+                              const QString &sql,
+                              std::unique_ptr<QSqlQuery> prepared_query) {
+  Dropped dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  StatementLease lease(std::move(prepared_query));
+  if (capacity_per_connection_ == 0)
+    return lease;
+  auto [conn_it, inserted] = connections_.try_emplace(
+      Key(connection_name, std::this_thread::get_id()));
+  if (inserted)
+    conn_it->second.generation = ++next_generation_;
+  lease.cacheable_ = true;
+  lease.connection_name_ = connection_name;
+  lease.sql_ = sql;
+  lease.generation_ = conn_it->second.generation;
+  return lease;
+}
+
+void PreparedStatementCache::giveBack(StatementLease &lease) {
+  Dropped dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  dropped.push_back(std::move(lease.query_));
+  if (capacity_per_connection_ == 0)
+    return;
+  const Key key(lease.connection_name_, std::this_thread::get_id());
+  auto conn_it = connections_.find(key);
+  // 租约期间连接被 invalidate（重连、关闭或迁移）：旧语句直接销毁
+  if (conn_it == connections_.end() ||
+      conn_it->second.generation != lease.generation_)
+    return;
+  ConnectionStatements &statements = conn_it->second;
+  // 租约期间同一 SQL 已由其他调用 prepare 并放回，保留先放回的那个
+  if (statements.index.count(lease.sql_))
+    return;
+  statements.lru.emplace_front(lease.sql_, std::move(dropped.back()));
+  dropped.pop_back();
+  statements.index.emplace(lease.sql_, statements.lru.begin());
+  trimLocked(key, statements, dropped);
+}
+
+void PreparedStatementCache::dropLocked(std::thread::id owner,
+                                        std::unique_ptr<QSqlQuery> query,
+                                        Dropped &dropped) {
+  if (owner == std::this_thread::get_id())
+    dropped.push_back(std::move(query));
+  else
+    retired_[owner].push_back(std::move(query));
+}
+
+void PreparedStatementCache::eraseLocked(
+    std::map<Key, ConnectionStatements>::iterator it, Dropped &dropped) {
+  for (Entry &entry : it->second.lru) {
+    dropLocked(it->first.second, std::move(entry.second), dropped);
+  }
+  connections_.erase(it);
+}
+
+void PreparedStatementCache::trimLocked(const Key &key,
+                                        ConnectionStatements &statements,
+                                        Dropped &dropped) {
+  while (statements.lru.size() > capacity_per_connection_) {
+    statements.index.erase(statements.lru.back().first);
+    dropLocked(key.second, std::move(statements.lru.back().second), dropped);
+    statements.lru.pop_back();
+  }
+}
+
+void PreparedStatementCache::takeRetiredLocked(Dropped &dropped) {
+  auto it = retired_.find(std::this_thread::get_id());
+  if (it == retired_.end())
+    return;
+  for (auto &query : it->second) {
+    dropped.push_back(std::move(query));
+  }
+  retired_.erase(it);
+}
+
+void PreparedStatementCache::invalidate(const QString &connection_name) {
+  Dropped dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  for (auto it = connections_.begin(); it != connections_.end();) {
+    if (it->first.first == connection_name)
+      eraseLocked(it++, dropped);
+    else
+      ++it;
+  }
+}
+
+void PreparedStatementCache::invalidateAll() {
+  Dropped dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  while (!connections_.empty()) {
+    eraseLocked(connections_.begin(), dropped);
+  }
+}
+
+void PreparedStatementCache::setCapacity(size_t capacity_per_connection) {
+  Dropped dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  takeRetiredLocked(dropped);
+  capacity_per_connection_ = capacity_per_connection;
+  for (auto it = connections_.begin(); it != connections_.end();) {
+    if (capacity_per_connection_ == 0) {
+      eraseLocked(it++, dropped);
+    } else {
+      trimLocked(it->first, it->second, dropped);
+      ++it;
+    }
+  }
+}
+
+size_t PreparedStatementCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_per_connection_;
+}
+
+size_t PreparedStatementCache::size(const QString &connection_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto conn_it =
+      connections_.find(Key(connection_name, std::this_thread::get_id()));
+  return conn_it == connections_.end() ? 0 : conn_it->second.lru.size();
+}
+
+} // namespace internal
+} // namespace cpporm
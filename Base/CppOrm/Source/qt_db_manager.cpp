@@ -1,4 +1,6 @@
 #include "cpporm/qt_db_manager.h"
+#include "cpporm/model_cache.h"
+#include "cpporm/prepared_statement_cache.h"
 #include <QDebug>    // For Qt-style debug output (optional)
 #include <QSqlError> // For QSqlError related information
 #include <QSqlQuery> // Needed for executing SET NAMES
@@ -8,6 +10,24 @@
 
 namespace cpporm {
 
+namespace {
+
+// 在连接成功后，为 MySQL/MariaDB 设置字符集
+void applyConnectionCharset(QSqlDatabase &db, const QString &conn_name) {
+  const QString driverNameUpper = db.driverName().toUpper();
+  if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
+    QSqlQuery set_names_query(db); // 使用当前连接 'db'
+    if (!set_names_query.exec("SET NAMES 'utf8mb4'")) {
+      qWarning() << "QtDbManager: Failed to execute SET NAMES "
+                    "'utf8mb4' for connection"
+                 << conn_name
+                 << ". Error:" << set_names_query.lastError().text();
+    }
+  }
+}
+
+} // namespace
+
 std::expected<QString, Error>
 QtDbManager::openDatabase(const QtDBConfig &config) {
   // std::lock_guard<std::mutex> lock(db_mutex_); // Lock if multi-threaded
@@ -24,6 +44,7 @@ QtDbManager::openDatabase(const QtDBConfig &config) {
     if (existing_db.isValid() && existing_db.isOpen()) {
       return conn_name;
     }
+    internal::PreparedStatementCache::instance().invalidate(conn_name);
     QSqlDatabase::removeDatabase(conn_name);
   }
 
@@ -62,35 +83,52 @@ QtDbManager::openDatabase(const QtDBConfig &config) {
   }
 
   // 在连接成功后，为 MySQL/MariaDB 设置字符集
-  QString driverNameUpper =
-      QString::fromStdString(config.driver_name).toUpper();
-  if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
-    QSqlQuery set_names_query(db); // 使用当前连接 'db'
-    if (!set_names_query.exec("SET NAMES 'utf8mb4'")) {
-      qWarning() << "QtDbManager::openDatabase: Failed to execute SET NAMES "
-                    "'utf8mb4' for connection"
-                 << conn_name
-                 << ". Error:" << set_names_query.lastError().text();
-      // 根据需要决定这是否是致命错误。目前仅警告。
-      // 如果是致命错误，可以关闭连接并返回错误：
-      // db.close();
-      // QSqlDatabase::removeDatabase(conn_name);
-      // return std::unexpected(Error(ErrorCode::QueryExecutionError, "Failed to
-      // set connection charset for " + conn_name.toStdString() + ": " +
-      // set_names_query.lastError().text().toStdString()));
-    } else {
-      // qInfo() << "QtDbManager::openDatabase: Successfully executed SET NAMES
-      // 'utf8mb4' for " << conn_name;
-    }
-  }
+  applyConnectionCharset(db, conn_name);
   return conn_name;
 }
 
+std::expected<QSqlDatabase, Error>
+QtDbManager::openClone(const QString &source_connection_name,
+                       const QString &clone_connection_name) {
+  if (!QSqlDatabase::contains(source_connection_name)) {
+    return std::unexpected(
+        Error(ErrorCode::ConnectionInvalid,
+              "QtDbManager::openClone: source connection '" +
+                  source_connection_name.toStdString() +
+                  "' is not registered."));
+  }
+  // cloneDatabase 只复制配置，可在任意线程调用；打开发生在当前线程，
+  // 克隆连接此后只能在当前线程使用。
+  QSqlDatabase db = QSqlDatabase::cloneDatabase(source_connection_name,
+                                                clone_connection_name);
+  if (!db.isValid()) {
+    return std::unexpected(
+        Error(ErrorCode::DriverNotFound,
+              "QtDbManager::openClone: failed to clone connection '" +
+                  source_connection_name.toStdString() + "'."));
+  }
+  if (!db.open()) {
+    const QSqlError q_error = db.lastError();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(clone_connection_name);
+    return std::unexpected(
+        Error(ErrorCode::ConnectionFailed,
+              "Failed to open cloned Qt database connection '" +
+                  clone_connection_name.toStdString() +
+                  "': " + q_error.text().toStdString(),
+              q_error.nativeErrorCode().toInt()));
+  }
+  applyConnectionCharset(db, clone_connection_name);
+  return db;
+}
+
 QSqlDatabase QtDbManager::getDatabase(const QString &connection_name) {
   return QSqlDatabase::database(connection_name);
 }
 
 void QtDbManager::closeDatabase(const QString &connection_name) {
+  // 缓存的 QSqlQuery 必须先于连接释放，否则 removeDatabase 会报告连接仍在使用
+  internal::PreparedStatementCache::instance().invalidate(connection_name);
   if (QSqlDatabase::contains(connection_name)) {
     QSqlDatabase db = QSqlDatabase::database(connection_name, false);
     if (db.isOpen()) {
@@ -108,4 +146,33 @@ bool QtDbManager::isConnectionValid(const QString &connection_name) {
   return db.isValid() && db.isOpen();
 }
 
+void QtDbManager::setPreparedStatementCacheCapacity(size_t capacity) {
+  internal::PreparedStatementCache::instance().setCapacity(capacity);
+}
+
+void QtDbManager::clearPreparedStatementCache(const QString &connection_name) {
+  internal::PreparedStatementCache::instance().invalidate(connection_name);
+}
+
+void QtDbManager::setModelCacheOptions(size_t max_entries,
+                                       std::chrono::milliseconds ttl) {
+  internal::ModelCache::instance().setOptions(max_entries, ttl);
+}
+
+void QtDbManager::clearModelCache() {
+  internal::ModelCache::instance().invalidateAll();
+}
+
+void QtDbManager::setQueryProfilingOptions(QueryProfilingOptions options) {
+  internal::QueryProfiler::instance().setOptions(std::move(options));
+}
+
+std::vector<QueryStatsSnapshot> QtDbManager::queryStatsSnapshot() {
+  return internal::QueryProfiler::instance().snapshot();
+}
+
+void QtDbManager::resetQueryStats() {
+  internal::QueryProfiler::instance().reset();
+}
+
 } // namespace cpporm
\ No newline at end of file
@@ -0,0 +1,342 @@
+// cpporm/qt_db_pool.cpp
+#include "cpporm/qt_db_pool.h"
+#include "cpporm/qt_db_manager.h"
+
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace cpporm {
+
+namespace {
+
+struct PoolRegistry {
+  std::mutex mutex;
+  std::map<QString, std::shared_ptr<QtDbPool>> pools;
+};
+
+PoolRegistry &poolRegistry() {
+  // 有意泄漏：进程退出时不依赖静态析构顺序
+  static PoolRegistry *registry = new PoolRegistry();
+  return *registry;
+}
+
+} // namespace
+
+// --- Lease ---
+
+QtDbPool::Lease::Lease(std::shared_ptr<QtDbPool> pool, QString connection_name,
+                       QSqlDatabase db)
+    : pool_(std::move(pool)), connection_name_(std::move(connection_name)),
+      db_(std::move(db)), owner_(std::this_thread::get_id()) {}
+
+QtDbPool::Lease::~Lease() { release(); }
+
+QtDbPool::Lease::Lease(Lease &&other) noexcept
+    : pool_(std::move(other.pool_)),
+      connection_name_(std::move(other.connection_name_)),
+      db_(std::move(other.db_)), owner_(other.owner_) {
+  other.pool_.reset();
+}
+
+QtDbPool::Lease &QtDbPool::Lease::operator=(Lease &&other) noexcept {
+  if (this != &other) {
+    release();
+    pool_ = std::move(other.pool_);
+    connection_name_ = std::move(other.connection_name_);
+    db_ = std::move(other.db_);
+    owner_ = other.owner_;
+    other.pool_.reset();
+  }
+  return *this;
+}
+
+void QtDbPool::Lease::release() {
+  if (!pool_)
+    return;
+  std::shared_ptr<QtDbPool> pool = std::move(pool_);
+  pool_.reset();
+  pool->giveBack(connection_name_, std::move(db_), owner_);
+  db_ = QSqlDatabase();
+}
+
+// --- QtDbPool ---
+
+QtDbPool::QtDbPool(QString source_connection_name,
+                   const QtDbPoolOptions &options)
+    : source_connection_name_(std::move(source_connection_name)),
+      options_(options) {}
+
+QtDbPool::~QtDbPool() {
+  const std::thread::id self = std::this_thread::get_id();
+  std::vector<PooledConnection> own;
+  size_t foreign = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (PooledConnection &conn : idle_) {
+      if (conn.owner == self)
+        own.push_back(std::move(conn));
+      else
+        ++foreign;
+    }
+    idle_.clear();
+  }
+  closeConnections(own);
+  // 其他线程的连接不能在这里关闭；保持注册，避免跨线程销毁驱动
+  if (foreign > 0)
+    qWarning() << "cpporm QtDbPool: pool for" << source_connection_name_
+               << "destroyed with" << foreign
+               << "idle connections owned by other threads; call "
+                  "releaseThreadConnections() on those threads first.";
+}
+
+std::expected<std::shared_ptr<QtDbPool>, Error>
+QtDbPool::create(const QString &source_connection_name,
+                 const QtDbPoolOptions &options) {
+  if (options.max_connections == 0) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "QtDbPool::create: max_connections must be greater than 0."));
+  }
+  if (!QtDbManager::isConnectionValid(source_connection_name)) {
+    return std::unexpected(
+        Error(ErrorCode::ConnectionInvalid,
+              "QtDbPool::create: source connection '" +
+                  source_connection_name.toStdString() +
+                  "' is not open. Call QtDbManager::openDatabase first."));
+  }
+
+  PoolRegistry &registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (registry.pools.count(source_connection_name)) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "QtDbPool::create: a pool for connection '" +
+                  source_connection_name.toStdString() +
+                  "' already exists."));
+  }
+  std::shared_ptr<QtDbPool> pool(
+      new QtDbPool(source_connection_name, options));
+  registry.pools.emplace(source_connection_name, pool);
+  return pool;
+}
+
+std::shared_ptr<QtDbPool>
+QtDbPool::find(const QString &source_connection_name) {
+  PoolRegistry &registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.pools.find(source_connection_name);
+  return it != registry.pools.end() ? it->second : nullptr;
+}
+
+void QtDbPool::remove(const QString &source_connection_name) {
+  std::shared_ptr<QtDbPool> pool;
+  {
+    PoolRegistry &registry = poolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.pools.find(source_connection_name);
+    if (it == registry.pools.end())
+      return;
+    pool = std::move(it->second);
+    registry.pools.erase(it);
+  }
+  std::lock_guard<std::mutex> lock(pool->mutex_);
+  pool->detached_ = true;
+  // 空闲连接在最后一个 Lease 归还后随连接池析构关闭
+}
+
+std::expected<QtDbPool::Lease, Error> QtDbPool::acquire() {
+  const std::thread::id self = std::this_thread::get_id();
+  const Clock::time_point deadline = Clock::now() + options_.acquire_timeout;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto find_own_idle = [&]() {
+    return std::find_if(idle_.rbegin(), idle_.rend(),
+                        [&](const PooledConnection &c) {
+                          return c.owner == self && !c.stale;
+                        });
+  };
+
+  while (true) {
+    // 0. 关闭本线程已过期或被其他线程标记为 stale 的空闲连接
+    std::vector<PooledConnection> expired =
+        takeExpiredLocked(Clock::now(), self);
+    if (!expired.empty()) {
+      lock.unlock();
+      closeConnections(expired);
+      lock.lock();
+    }
+
+    // 1. 复用本线程最近归还的连接
+    auto own = find_own_idle();
+    if (own != idle_.rend()) {
+      PooledConnection conn = std::move(*own);
+      idle_.erase(std::next(own).base());
+      lock.unlock();
+      if (Clock::now() - conn.idle_since >= options_.validate_after_idle &&
+          !validate(conn.db)) {
+        qWarning() << "cpporm QtDbPool: idle connection" << conn.name
+                   << "failed validation, reopening.";
+        std::vector<PooledConnection> broken;
+        broken.push_back(std::move(conn));
+        closeConnections(broken);
+        lock.lock();
+        continue;
+      }
+      return Lease(shared_from_this(), conn.name, std::move(conn.db));
+    }
+
+    // 2. 未达上限则在本线程新开一个
+    if (total_ < options_.max_connections) {
+      ++total_;
+      const QString name = source_connection_name_ + "__pool_" +
+                           QString::number(++next_id_);
+      lock.unlock();
+      auto opened = QtDbManager::openClone(source_connection_name_, name);
+      if (!opened) {
+        lock.lock();
+        --total_;
+        lock.unlock();
+        available_.notify_all();
+        return std::unexpected(opened.error());
+      }
+      return Lease(shared_from_this(), name, std::move(opened.value()));
+    }
+
+    // 3. 池满：其他线程的空闲连接不能在本线程关闭，把最久未用的一个
+    // 标记为 stale，由其所属线程下次 acquire 时关闭以腾出名额
+    // （每个等待者至多对应一个 stale 连接）
+    const size_t stale_count = static_cast<size_t>(std::count_if(
+        idle_.begin(), idle_.end(),
+        [](const PooledConnection &c) { return c.stale; }));
+    if (stale_count <= waiters_) {
+      auto oldest_other = std::find_if(
+          idle_.begin(), idle_.end(),
+          [](const PooledConnection &c) { return !c.stale; });
+      if (oldest_other != idle_.end())
+        oldest_other->stale = true;
+    }
+
+    // 4. 等待归还或名额释放
+    ++waiters_;
+    const bool ready =
+        available_.wait_until(lock, deadline, [&]() {
+          return total_ < options_.max_connections || hasOwnIdleLocked(self);
+        });
+    --waiters_;
+    if (!ready) {
+      return std::unexpected(
+          Error(ErrorCode::ConnectionFailed,
+                "QtDbPool: pool for connection '" +
+                    source_connection_name_.toStdString() +
+                    "' exhausted (" +
+                    std::to_string(options_.max_connections) +
+                    " connections) after waiting " +
+                    std::to_string(options_.acquire_timeout.count()) +
+                    " ms."));
+    }
+  }
+}
+
+void QtDbPool::giveBack(const QString &connection_name, QSqlDatabase db,
+                        std::thread::id owner) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // 连接池已注销，或池满且有线程在等待时不再复用该连接：在所属线程上
+  // 直接关闭；从其他线程归还时放回空闲列表并标记为 stale，由所属线程关闭。
+  const bool retire =
+      detached_ || (waiters_ > 0 && total_ >= options_.max_connections);
+  if (retire && owner == std::this_thread::get_id()) {
+    lock.unlock();
+    std::vector<PooledConnection> closing;
+    closing.push_back({connection_name, std::move(db), owner, Clock::now()});
+    closeConnections(closing);
+    return;
+  }
+  idle_.push_back(
+      {connection_name, std::move(db), owner, Clock::now(), retire});
+  lock.unlock();
+  available_.notify_all();
+}
+
+std::vector<QtDbPool::PooledConnection>
+QtDbPool::takeExpiredLocked(Clock::time_point now, std::thread::id owner) {
+  std::vector<PooledConnection> expired;
+  std::map<std::thread::id, size_t> kept;
+  // 从最近归还的开始保留，较旧的优先回收
+  for (auto it = idle_.rbegin(); it != idle_.rend();) {
+    size_t &kept_for_owner = kept[it->owner];
+    if (!it->stale && (kept_for_owner < options_.min_idle_per_thread ||
+                       now - it->idle_since < options_.idle_timeout)) {
+      ++kept_for_owner;
+      ++it;
+      continue;
+    }
+    if (it->owner != owner) {
+      it->stale = true;
+      ++it;
+      continue;
+    }
+    expired.push_back(std::move(*it));
+    it = std::make_reverse_iterator(idle_.erase(std::next(it).base()));
+  }
+  return expired;
+}
+
+bool QtDbPool::hasOwnIdleLocked(std::thread::id owner) const {
+  return std::any_of(idle_.begin(), idle_.end(),
+                     [&](const PooledConnection &c) {
+                       return c.owner == owner && !c.stale;
+                     });
+}
+
+void QtDbPool::closeConnections(std::vector<PooledConnection> &connections) {
+  if (connections.empty())
+    return;
+  for (PooledConnection &conn : connections) {
+    // 先释放本地副本，removeDatabase 才不会报告连接仍在使用
+    conn.db = QSqlDatabase();
+    QtDbManager::closeDatabase(conn.name);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_ -= std::min(total_, connections.size());
+  }
+  connections.clear();
+  available_.notify_all();
+}
+
+bool QtDbPool::validate(QSqlDatabase &db) {
+  if (!db.isOpen())
+    return false;
+  QSqlQuery query(db);
+  return query.exec("SELECT 1");
+}
+
+void QtDbPool::releaseThreadConnections() {
+  const std::thread::id self = std::this_thread::get_id();
+  std::vector<PooledConnection> own;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto split = std::stable_partition(
+        idle_.begin(), idle_.end(),
+        [&](const PooledConnection &c) { return c.owner != self; });
+    std::move(split, idle_.end(), std::back_inserter(own));
+    idle_.erase(split, idle_.end());
+  }
+  closeConnections(own);
+}
+
+size_t QtDbPool::totalConnections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_;
+}
+
+size_t QtDbPool::idleConnections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+} // namespace cpporm
@@ -0,0 +1,380 @@
+// cpporm/query_profiler.cpp
+#include "cpporm/query_profiler.h"
+
+#include <QDebug>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace cpporm {
+
+std::chrono::nanoseconds LatencyHistogramSnapshot::mean() const {
+  if (count == 0)
+    return std::chrono::nanoseconds(0);
+  return total / static_cast<int64_t>(count);
+}
+
+std::chrono::nanoseconds LatencyHistogramSnapshot::percentile(double q) const {
+  if (count == 0)
+    return std::chrono::nanoseconds(0);
+  q = std::clamp(q, 0.0, 1.0);
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      // 桶上界不超过实际记录到的最大值
+      const int64_t upper = (int64_t{1} << (i + 1)) - 1;
+      return std::min(std::chrono::nanoseconds(upper), max);
+    }
+  }
+  return max;
+}
+
+namespace internal {
+
+namespace {
+
+// 线程本地 SQL → 统计项缓存的上限，超出时整体清空（ExecRaw 拼接字面量时
+// 原始 SQL 可能无限多）
+constexpr size_t kThreadCacheLimit = 4096;
+
+bool isIdentifierChar(QChar c) {
+  return c.isLetterOrNumber() || c == QChar('_') || c == QChar('$');
+}
+
+QString overflowFingerprint() { return QString("<other>"); }
+
+} // namespace
+
+void LatencyHistogram::record(int64_t nanoseconds) {
+  if (nanoseconds < 0)
+    nanoseconds = 0;
+  const size_t width = std::bit_width(static_cast<uint64_t>(nanoseconds));
+  const size_t bucket =
+      width == 0 ? 0 : std::min<size_t>(width - 1, kBucketCount - 1);
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(nanoseconds, std::memory_order_relaxed);
+  int64_t current_max = max_ns_.load(std::memory_order_relaxed);
+  while (nanoseconds > current_max &&
+         !max_ns_.compare_exchange_weak(current_max, nanoseconds,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogramSnapshot LatencyHistogram::snapshot() const {
+  // 各计数器分别读取，并发记录时快照之间可能有微小出入
+  LatencyHistogramSnapshot result;
+  result.buckets.reserve(kBucketCount);
+  for (const auto &bucket : buckets_)
+    result.buckets.push_back(bucket.load(std::memory_order_relaxed));
+  result.count = count_.load(std::memory_order_relaxed);
+  result.total =
+      std::chrono::nanoseconds(total_ns_.load(std::memory_order_relaxed));
+  result.max =
+      std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed));
+  return result;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucket : buckets_)
+    bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  total_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+QueryProfiler &QueryProfiler::instance() {
+  // 故意不析构：其他线程的线程本地缓存持有统计项指针
+  static QueryProfiler *profiler = new QueryProfiler();
+  return *profiler;
+}
+
+QueryProfiler::QueryProfiler()
+    : overflow_stats_(std::make_unique<StatementStats>(overflowFingerprint())) {
+}
+
+void QueryProfiler::setOptions(QueryProfilingOptions options) {
+  {
+    std::unique_lock<std::shared_mutex> lock(stats_mutex_);
+    max_fingerprints_ = options.max_fingerprints;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    slow_query_sink_ = std::move(options.slow_query_sink);
+  }
+  slow_threshold_ns_.store(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          options.slow_query_threshold)
+          .count(),
+      std::memory_order_relaxed);
+  enabled_.store(options.enabled, std::memory_order_relaxed);
+}
+
+StatementStats *QueryProfiler::statsFor(const QString &sql) {
+  // 同一条原始 SQL 只计算一次指纹，之后每次执行只有一次线程本地查找
+  thread_local std::unordered_map<QString, StatementStats *, QStringHasher>
+      local_cache;
+  auto cached = local_cache.find(sql);
+  if (cached != local_cache.end())
+    return cached->second;
+  if (local_cache.size() >= kThreadCacheLimit)
+    local_cache.clear();
+
+  QString fp = fingerprint(sql);
+  StatementStats *stats = nullptr;
+  {
+    std::shared_lock<std::shared_mutex> lock(stats_mutex_);
+    auto it = stats_.find(fp);
+    if (it != stats_.end())
+      stats = it->second.get();
+  }
+  if (!stats) {
+    std::unique_lock<std::shared_mutex> lock(stats_mutex_);
+    auto it = stats_.find(fp);
+    if (it != stats_.end()) {
+      stats = it->second.get();
+    } else if (stats_.size() < max_fingerprints_) {
+      auto entry = std::make_unique<StatementStats>(fp);
+      stats = entry.get();
+      stats_.emplace(std::move(fp), std::move(entry));
+    } else {
+      stats = overflow_stats_.get();
+    }
+  }
+  local_cache.emplace(sql, stats);
+  return stats;
+}
+
+void QueryProfiler::recordExecution(const QString &connection_name,
+                                    const QString &sql,
+                                    StatementTimings &timings, bool succeeded,
+                                    bool defer_slow_check) {
+  StatementStats *stats = statsFor(sql);
+  timings.stats = stats;
+  stats->calls.fetch_add(1, std::memory_order_relaxed);
+  if (!succeeded)
+    stats->errors.fetch_add(1, std::memory_order_relaxed);
+  if (timings.prepare_ns > 0)
+    stats->prepare.record(timings.prepare_ns);
+  stats->exec.record(timings.exec_ns);
+
+  if ((defer_slow_check && succeeded) ||
+      !isSlow(timings.prepare_ns + timings.exec_ns))
+    return;
+  SlowQueryRecord record;
+  record.connection_name = connection_name;
+  record.sql = sql;
+  record.fingerprint = stats->fingerprint;
+  record.bound_params = timings.bound_params;
+  record.failed = !succeeded;
+  record.prepare = std::chrono::nanoseconds(timings.prepare_ns);
+  record.exec = std::chrono::nanoseconds(timings.exec_ns);
+  reportSlowQuery(record);
+}
+
+bool QueryProfiler::isSlow(int64_t total_ns) const {
+  const int64_t threshold =
+      slow_threshold_ns_.load(std::memory_order_relaxed);
+  return threshold > 0 && total_ns >= threshold;
+}
+
+void QueryProfiler::reportSlowQuery(const SlowQueryRecord &record) {
+  std::function<void(const SlowQueryRecord &)> sink;
+  {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink = slow_query_sink_;
+  }
+  if (sink) {
+    sink(record);
+    return;
+  }
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  qWarning().noquote()
+      << "cpporm slow query on" << record.connection_name << ":"
+      << duration_cast<microseconds>(record.total()).count() << "us"
+      << "(prepare"
+      << duration_cast<microseconds>(record.prepare).count() << "us,"
+      << "exec" << duration_cast<microseconds>(record.exec).count()
+      << "us," << "fetch"
+      << duration_cast<microseconds>(record.fetch).count() << "us,"
+      << "map" << duration_cast<microseconds>(record.map).count()
+      << "us," << "preload"
+      << duration_cast<microseconds>(record.preload).count() << "us,"
+      << record.rows << "rows," << record.bound_params << "params"
+      << (record.failed ? ", failed)" : ")")
+      << "\nSQL:" << record.sql;
+}
+
+std::vector<QueryStatsSnapshot> QueryProfiler::snapshot() const {
+  std::vector<QueryStatsSnapshot> result;
+  auto append = [&result](const StatementStats &stats) {
+    const uint64_t calls = stats.calls.load(std::memory_order_relaxed);
+    if (calls == 0)
+      return;
+    QueryStatsSnapshot snap;
+    snap.fingerprint = stats.fingerprint;
+    snap.calls = calls;
+    snap.errors = stats.errors.load(std::memory_order_relaxed);
+    snap.rows = stats.rows.load(std::memory_order_relaxed);
+    snap.prepare = stats.prepare.snapshot();
+    snap.exec = stats.exec.snapshot();
+    snap.fetch = stats.fetch.snapshot();
+    snap.map = stats.map.snapshot();
+    snap.preload = stats.preload.snapshot();
+    result.push_back(std::move(snap));
+  };
+  {
+    std::shared_lock<std::shared_mutex> lock(stats_mutex_);
+    result.reserve(stats_.size() + 1);
+    for (const auto &[fp, stats] : stats_)
+      append(*stats);
+  }
+  append(*overflow_stats_);
+  std::sort(result.begin(), result.end(),
+            [](const QueryStatsSnapshot &a, const QueryStatsSnapshot &b) {
+              return a.totalTime() > b.totalTime();
+            });
+  return result;
+}
+
+void QueryProfiler::reset() {
+  auto clear = [](StatementStats &stats) {
+    stats.calls.store(0, std::memory_order_relaxed);
+    stats.errors.store(0, std::memory_order_relaxed);
+    stats.rows.store(0, std::memory_order_relaxed);
+    stats.prepare.reset();
+    stats.exec.reset();
+    stats.fetch.reset();
+    stats.map.reset();
+    stats.preload.reset();
+  };
+  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
+  for (auto &[fp, stats] : stats_)
+    clear(*stats);
+  clear(*overflow_stats_);
+}
+
+QString QueryProfiler::fingerprint(const QString &sql) {
+  QString out;
+  out.reserve(sql.size());
+  const qsizetype n = sql.size();
+  bool pending_space = false;
+  qsizetype i = 0;
+  while (i < n) {
+    const QChar c = sql.at(i);
+    if (c.isSpace()) {
+      pending_space = !out.isEmpty();
+      ++i;
+      continue;
+    }
+    if (pending_space) {
+      out += QChar(' ');
+      pending_space = false;
+    }
+    if (c == QChar('\'')) {
+      // 字符串字面量（'' 与 \' 为转义）
+      ++i;
+      while (i < n) {
+        const QChar d = sql.at(i);
+        if (d == QChar('\\') && i + 1 < n) {
+          i += 2;
+        } else if (d == QChar('\'')) {
+          if (i + 1 < n && sql.at(i + 1) == QChar('\'')) {
+            i += 2;
+          } else {
+            ++i;
+            break;
+          }
+        } else {
+          ++i;
+        }
+      }
+      out += QChar('?');
+      continue;
+    }
+    if (c == QChar('`') || c == QChar('"')) {
+      // 带引号的标识符原样保留
+      const qsizetype close = sql.indexOf(c, i + 1);
+      const qsizetype end = close < 0 ? n : close + 1;
+      out += sql.mid(i, end - i);
+      i = end;
+      continue;
+    }
+    if (c.isDigit() &&
+        (out.isEmpty() || !isIdentifierChar(out.at(out.size() - 1)))) {
+      while (i < n && (sql.at(i).isLetterOrNumber() || sql.at(i) == QChar('.')))
+        ++i;
+      out += QChar('?');
+      continue;
+    }
+    out += c;
+    ++i;
+  }
+
+  // IN (?, ?, ...) 与多行 VALUES 的长度随数据变化，折叠后归为同一指纹
+  static const QRegularExpression placeholder_list(
+      QString(R"(\?(?:\s*,\s*\?)+)"));
+  static const QRegularExpression repeated_tuples(
+      QString(R"((\([^()]*\))(?:\s*,\s*\1)+)"));
+  out.replace(placeholder_list, QString("?+"));
+  out.replace(repeated_tuples, QString("\\1+"));
+  return out;
+}
+
+StatementProfile::StatementProfile(const QString &connection_name,
+                                   const QString &sql,
+                                   const StatementTimings &timings)
+    : connection_name_(connection_name), sql_(sql), timings_(timings) {
+  if (active())
+    fetch_started_ = Clock::now();
+}
+
+void StatementProfile::endFetch() {
+  if (!active() || fetch_ns_ >= 0)
+    return;
+  const int64_t loop_ns = (Clock::now() - fetch_started_).count();
+  fetch_ns_ = std::max<int64_t>(0, loop_ns - map_ns_);
+}
+
+void StatementProfile::endPreload(Clock::time_point preload_started) {
+  if (active())
+    preload_ns_ += (Clock::now() - preload_started).count();
+}
+
+StatementProfile::~StatementProfile() {
+  if (!active())
+    return;
+  endFetch();
+  StatementStats &stats = *timings_.stats;
+  stats.rows.fetch_add(rows_, std::memory_order_relaxed);
+  stats.fetch.record(fetch_ns_);
+  stats.map.record(map_ns_);
+  if (preload_ns_ > 0)
+    stats.preload.record(preload_ns_);
+
+  QueryProfiler &profiler = QueryProfiler::instance();
+  if (!profiler.isSlow(timings_.prepare_ns + timings_.exec_ns + fetch_ns_ +
+                       map_ns_ + preload_ns_))
+    return;
+  SlowQueryRecord record;
+  record.connection_name = connection_name_;
+  record.sql = sql_;
+  record.fingerprint = stats.fingerprint;
+  record.bound_params = timings_.bound_params;
+  record.rows = rows_;
+  record.prepare = std::chrono::nanoseconds(timings_.prepare_ns);
+  record.exec = std::chrono::nanoseconds(timings_.exec_ns);
+  record.fetch = std::chrono::nanoseconds(fetch_ns_);
+  record.map = std::chrono::nanoseconds(map_ns_);
+  record.preload = std::chrono::nanoseconds(preload_ns_);
+  profiler.reportSlowQuery(record);
+}
+
+} // namespace internal
+} // namespace cpporm
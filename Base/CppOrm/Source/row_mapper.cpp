@@ -0,0 +1,72 @@
+// cpporm/row_mapper.cpp
+#include "cpporm/row_mapper.h"
+#include "cpporm/session.h" // Session::qvariantToAny
+
+#include <QDebug>
+#include <QVariant>
+
+namespace cpporm {
+namespace internal {
+
+RowMapper::RowMapper(const ModelMeta &meta, const QSqlRecord &record)
+    : meta_(meta) {
+  const int column_count = record.count();
+  columns_.reserve(static_cast<size_t>(column_count));
+  for (int i = 0; i < column_count; ++i) {
+    const FieldMeta *field_meta =
+        meta.findFieldByDbName(record.fieldName(i).toStdString());
+    if (!field_meta || has_flag(field_meta->flags, FieldFlag::Association))
+      continue;
+    if (!field_meta->variant_setter && !field_meta->setter)
+      continue;
+    columns_.push_back(
+        {i, field_meta, static_cast<FieldId>(field_meta - meta.fields.data())});
+  }
+}
+
+void RowMapper::mapRow(const QSqlQuery &query, ModelBase &model) const {
+  // getter/setter 约定以 ModelBase* 作为 void* 传入（见 ModelBase::setFieldValue）
+  void *model_ptr = &model;
+  // 未出现在结果集中的列保持无效值，Save 时视为已修改
+  model._loaded_values.assign(meta_.fields.size(), QVariant());
+  for (const Column &column : columns_) {
+    const QVariant value = query.value(column.index);
+    const FieldMeta &field_meta = *column.field;
+    model._loaded_values[column.field_id] = value;
+    if (!field_meta.variant_setter) {
+      mapColumnViaAny(column, value, model);
+      continue;
+    }
+    if (!field_meta.variant_setter(model_ptr, value)) {
+      model.markFieldDirty(column.field_id);
+      qWarning() << "cpporm RowMapper::mapRow: QVariant to C++ type "
+                    "conversion failed for field"
+                 << QString::fromStdString(field_meta.cpp_name)
+                 << ". DB value:" << value.toString()
+                 << "(QVariant type:" << value.typeName()
+                 << ", Target C++ type:" << field_meta.cpp_type.name() << ")";
+    }
+  }
+  model._is_persisted = true;
+}
+
+// 手工注册（非宏生成）的字段没有类型化 setter，按旧路径经 std::any 写入。
+void RowMapper::mapColumnViaAny(const Column &column, const QVariant &value,
+                                ModelBase &model) const {
+  const FieldMeta &field_meta = *column.field;
+  std::any cpp_value;
+  bool conversion_ok = false;
+  Session::qvariantToAny(value, field_meta.cpp_type, cpp_value, conversion_ok);
+  if (!conversion_ok)
+    cpp_value.reset();
+  try {
+    field_meta.setter(&model, cpp_value);
+  } catch (const std::exception &e) {
+    qWarning() << "cpporm RowMapper::mapRow: Error setting field"
+               << QString::fromStdString(field_meta.cpp_name) << "of table"
+               << QString::fromStdString(meta_.table_name) << ":" << e.what();
+  }
+}
+
+} // namespace internal
+} // namespace cpporm
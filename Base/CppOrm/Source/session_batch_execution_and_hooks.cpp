@@ -21,14 +21,14 @@ executeBatchSql(Session &session, const QString &sql_to_execute,
 
   auto exec_pair = FriendAccess::callExecuteQueryInternal(
       session.getDbHandle(), sql_to_execute, bindings);
-  result.query_object = std::move(exec_pair.first);
+  result.statement = std::move(exec_pair.first);
   result.db_error = exec_pair.second;
 
   if (result.db_error) {
     return result;
   }
 
-  result.rows_affected = result.query_object.numRowsAffected();
+  result.rows_affected = result.statement->numRowsAffected();
 
   // 根据数据库操作结果和冲突选项，设置 _is_persisted 状态
   // 并将这些模型加入 models_potentially_persisted 列表
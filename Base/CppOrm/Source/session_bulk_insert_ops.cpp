@@ -0,0 +1,302 @@
+// cpporm/session_bulk_insert_ops.cpp
+#include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
+#include "cpporm/query_builder.h"
+#include "cpporm/session.h"
+#include "cpporm/session_priv_batch_helpers.h" // callAfterCreateHooks
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMetaType>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace cpporm {
+
+namespace {
+
+// json_populate_recordset 按目标列类型的文本输入函数解析字符串，
+// 因此除 NULL/布尔外统一编码为字符串，避免 64 位整数经 double 丢精度。
+QJsonValue toBulkJsonValue(const QVariant &value) {
+  if (value.isNull() || !value.isValid() ||
+      value.typeId() == QMetaType::UnknownType)
+    return QJsonValue();
+  switch (value.typeId()) {
+  case QMetaType::Bool:
+    return QJsonValue(value.toBool());
+  case QMetaType::QDateTime:
+    return QJsonValue(value.toDateTime().toString(Qt::ISODateWithMs));
+  case QMetaType::QDate:
+    return QJsonValue(value.toDate().toString(Qt::ISODate));
+  case QMetaType::QTime:
+    return QJsonValue(value.toTime().toString(Qt::ISODateWithMs));
+  case QMetaType::QByteArray:
+    // bytea 的 hex 输入格式
+    return QJsonValue("\\x" + QString::fromUtf8(value.toByteArray().toHex()));
+  default:
+    return QJsonValue(value.toString());
+  }
+}
+
+Error bulkQueryError(const QSqlQuery &query, const char *what,
+                     const QString &sql) {
+  const QSqlError err = query.lastError();
+  return Error(ErrorCode::QueryExecutionError,
+               std::string(what) + ": " + err.text().toStdString() +
+                   " SQL: " + sql.toStdString(),
+               err.nativeErrorCode().toInt());
+}
+
+} // namespace
+
+std::expected<size_t, Error>
+Session::BulkInsert(const ModelMeta &meta,
+                    const std::vector<ModelBase *> &models,
+                    size_t rows_per_statement) {
+  if (rows_per_statement == 0) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "BulkInsert: rows_per_statement must be greater than zero."));
+  }
+
+  // 钩子与时间戳在写库前全部处理完，任一 beforeCreate 失败则不写入任何行
+  std::vector<ModelBase *> rows_models;
+  std::vector<internal::SessionModelDataForWrite> rows_data;
+  rows_models.reserve(models.size());
+  rows_data.reserve(models.size());
+  for (ModelBase *model : models) {
+    if (!model)
+      continue;
+    Error hook_err = model->beforeCreate(*this);
+    if (hook_err)
+      return std::unexpected(hook_err);
+    autoSetTimestamps(*model, meta, true);
+    rows_data.push_back(extractModelData(*model, meta, false, true));
+    rows_models.push_back(model);
+  }
+  if (rows_models.empty())
+    return 0;
+
+  std::vector<QString> column_names;
+  column_names.reserve(rows_data.front().fields_to_write.size());
+  for (const auto &pair : rows_data.front().fields_to_write) {
+    column_names.push_back(pair.first);
+  }
+  if (column_names.empty()) {
+    return std::unexpected(
+        Error(ErrorCode::MappingError,
+              "BulkInsert: model has no writable columns. Table: " +
+                  meta.table_name));
+  }
+
+  const bool is_postgres = db_handle_.driverName().toUpper() == "QPSQL";
+  std::expected<size_t, Error> inserted =
+      is_postgres
+          ? bulkInsertViaJsonRecordset(meta, rows_models, rows_data,
+                                       column_names, rows_per_statement)
+          : bulkInsertViaExecBatch(meta, rows_models, rows_data, column_names,
+                                   rows_per_statement);
+  if (!inserted)
+    return inserted;
+
+  Error hooks_err = make_ok();
+  internal_batch_helpers::callAfterCreateHooks(*this, rows_models, hooks_err);
+  if (hooks_err)
+    return std::unexpected(hooks_err);
+  return inserted;
+}
+
+// PostgreSQL：每轮一个 JSON 数组参数，INSERT ... SELECT FROM
+// json_populate_recordset，列值按表定义转换；自增主键经 RETURNING 回填。
+// 参数个数与行数无关，不受 65535 占位符上限约束。
+std::expected<size_t, Error> Session::bulkInsertViaJsonRecordset(
+    const ModelMeta &meta, const std::vector<ModelBase *> &rows_models,
+    const std::vector<internal::SessionModelDataForWrite> &rows_data,
+    const std::vector<QString> &column_names, size_t rows_per_statement) {
+  // 只在 QPSQL 上执行：标识符交给驱动加双引号，反引号 PostgreSQL 不认
+  const QSqlDriver *driver = db_handle_.driver();
+  const QString table = driver->escapeIdentifier(
+      QString::fromStdString(meta.table_name), QSqlDriver::TableName);
+  QStringList quoted_columns;
+  for (const QString &column : column_names) {
+    quoted_columns.append(
+        driver->escapeIdentifier(column, QSqlDriver::FieldName));
+  }
+  const QString column_list = quoted_columns.join(", ");
+
+  const FieldMeta *pk_field = meta.getPrimaryField();
+  const bool backfill_pk =
+      pk_field && has_flag(pk_field->flags, FieldFlag::AutoIncrement);
+  QString sql = QString("INSERT INTO %1 (%2) SELECT %2 FROM "
+                        "json_populate_recordset(NULL::%1, ?::json)")
+                    .arg(table, column_list);
+  if (backfill_pk) {
+    sql += " RETURNING " +
+           driver->escapeIdentifier(QString::fromStdString(pk_field->db_name),
+                                    QSqlDriver::FieldName);
+  }
+
+  size_t inserted_rows = 0;
+  for (size_t begin = 0; begin < rows_models.size();
+       begin += rows_per_statement) {
+    const size_t end = std::min(rows_models.size(), begin + rows_per_statement);
+    QJsonArray records;
+    for (size_t i = begin; i < end; ++i) {
+      const auto &fields = rows_data[i].fields_to_write;
+      QJsonObject record;
+      for (const QString &column : column_names) {
+        auto it = fields.find(column);
+        record.insert(column, it != fields.end() ? toBulkJsonValue(it->second)
+                                                 : QJsonValue());
+      }
+      records.append(record);
+    }
+    const QString payload = QString::fromUtf8(
+        QJsonDocument(records).toJson(QJsonDocument::Compact));
+
+    auto [statement, exec_err] =
+        execute_query_internal(db_handle_, sql, QVariantList{payload});
+    QSqlQuery &query = *statement;
+    if (exec_err)
+      return std::unexpected(exec_err);
+
+    std::vector<ModelBase *> chunk_models(rows_models.begin() + begin,
+                                          rows_models.begin() + end);
+    for (ModelBase *model : chunk_models) {
+      model->_is_persisted = true;
+    }
+    if (backfill_pk) {
+      internal_batch_helpers::backfillIdsFromReturning(
+          query, meta, chunk_models, pk_field->cpp_name, pk_field->cpp_type);
+    }
+    query.finish();
+    inserted_rows += chunk_models.size();
+  }
+  return inserted_rows;
+}
+
+// 其他驱动：预编译单行 INSERT，按列绑定 QVariantList 后 execBatch。
+// 支持数组绑定的驱动（ODBC/OCI）一次往返发送整批；其余驱动由 Qt 逐行执行
+// 同一个已 prepare 的语句。未处于事务中时每轮包在一个事务里，避免 SQLite
+// 等逐行提交。execBatch 无法给出逐行的自增 ID，因此不回填主键。
+std::expected<size_t, Error> Session::bulkInsertViaExecBatch(
+    const ModelMeta &meta, const std::vector<ModelBase *> &rows_models,
+    const std::vector<internal::SessionModelDataForWrite> &rows_data,
+    const std::vector<QString> &column_names, size_t rows_per_statement) {
+  if (!db_handle_.isOpen() && !db_handle_.open()) {
+    const QSqlError err = db_handle_.lastError();
+    return std::unexpected(Error(ErrorCode::ConnectionNotOpen,
+                                 "BulkInsert: failed to open database: " +
+                                     err.text().toStdString(),
+                                 err.nativeErrorCode().toInt()));
+  }
+
+  QStringList quoted_columns;
+  QStringList placeholders;
+  for (const QString &column : column_names) {
+    quoted_columns.append(QString::fromStdString(
+        QueryBuilder::quoteSqlIdentifier(column.toStdString())));
+    placeholders.append("?");
+  }
+  const QString sql =
+      QString("INSERT INTO %1 (%2) VALUES (%3)")
+          .arg(QString::fromStdString(
+                   QueryBuilder::quoteSqlIdentifier(meta.table_name)),
+               quoted_columns.join(", "), placeholders.join(", "));
+
+  QSqlQuery query(db_handle_);
+  if (!query.prepare(sql)) {
+    const QSqlError err = query.lastError();
+    return std::unexpected(Error(ErrorCode::StatementPreparationError,
+                                 "BulkInsert: failed to prepare: " +
+                                     err.text().toStdString() +
+                                     " SQL: " + sql.toStdString(),
+                                 err.nativeErrorCode().toInt()));
+  }
+
+  const bool own_transaction =
+      !is_explicit_transaction_handle_ && db_handle_.driver() &&
+      db_handle_.driver()->hasFeature(QSqlDriver::Transactions);
+
+  size_t inserted_rows = 0;
+  for (size_t begin = 0; begin < rows_models.size();
+       begin += rows_per_statement) {
+    const size_t end = std::min(rows_models.size(), begin + rows_per_statement);
+    const size_t round_rows = end - begin;
+    // 按位置绑定：execBatch 不会像 exec 那样重置 addBindValue 的计数，
+    // 复用同一预编译语句时第二轮起会绑到 n..2n-1 上
+    for (size_t c = 0; c < column_names.size(); ++c) {
+      const QString &column = column_names[c];
+      QVariantList column_values;
+      column_values.reserve(static_cast<qsizetype>(end - begin));
+      for (size_t i = begin; i < end; ++i) {
+        const auto &fields = rows_data[i].fields_to_write;
+        auto it = fields.find(column);
+        column_values.append(it != fields.end() ? it->second : QVariant());
+      }
+      query.bindValue(static_cast<int>(c), column_values);
+    }
+    if (static_cast<size_t>(query.boundValues().size()) !=
+        column_names.size()) {
+      return std::unexpected(
+          Error(ErrorCode::InternalError,
+                "BulkInsert: bound " +
+                    std::to_string(query.boundValues().size()) +
+                    " value lists for " + std::to_string(column_names.size()) +
+                    " columns. SQL: " + sql.toStdString()));
+    }
+
+    bool in_own_transaction = false;
+    if (own_transaction) {
+      in_own_transaction = db_handle_.transaction();
+      if (!in_own_transaction)
+        qWarning() << "cpporm Session::BulkInsert: could not start a "
+                      "transaction; rows are committed individually.";
+    }
+    if (!query.execBatch()) {
+      Error err = bulkQueryError(query, "BulkInsert: execBatch failed", sql);
+      if (in_own_transaction)
+        db_handle_.rollback();
+      return std::unexpected(err);
+    }
+    // 原生批量驱动报告整批的影响行数；Qt 的逐行模拟只报告最后一行，
+    // 此时任一行失败都会让 execBatch 返回 false，无需再核对
+    if (db_handle_.driver()->hasFeature(QSqlDriver::BatchOperations)) {
+      const int affected = query.numRowsAffected();
+      if (affected >= 0 && static_cast<size_t>(affected) != round_rows) {
+        if (in_own_transaction)
+          db_handle_.rollback();
+        return std::unexpected(
+            Error(ErrorCode::QueryExecutionError,
+                  "BulkInsert: execBatch affected " + std::to_string(affected) +
+                      " rows, expected " + std::to_string(round_rows) +
+                      ". SQL: " + sql.toStdString()));
+      }
+    }
+    if (in_own_transaction && !db_handle_.commit()) {
+      const QSqlError commit_err = db_handle_.lastError();
+      return std::unexpected(Error(ErrorCode::TransactionError,
+                                   "BulkInsert: commit failed: " +
+                                       commit_err.text().toStdString(),
+                                   commit_err.nativeErrorCode().toInt()));
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+      rows_models[i]->_is_persisted = true;
+    }
+    inserted_rows += round_rows;
+  }
+  return inserted_rows;
+}
+
+} // namespace cpporm
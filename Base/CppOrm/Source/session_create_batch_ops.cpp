@@ -1,5 +1,7 @@
 // cpporm/session_create_batch_ops.cpp
+#include "cpporm/adaptive_batch_sizer.h"
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h"
 #include "cpporm/session.h"
 #include "cpporm/session_priv_batch_helpers.h" // 包含新的私有助手声明
@@ -12,6 +14,7 @@
 #include <QSqlQuery>
 #include <QVariant>
 #include <algorithm>
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -26,7 +29,8 @@ Error Session::CreateBatchProviderInternal(
         void(const std::vector<ModelBase *> &processed_batch_models_with_ids,
              Error batch_error)>
         per_db_batch_completion_callback,
-    const OnConflictClause *conflict_options_override) {
+    const OnConflictClause *conflict_options_override,
+    size_t max_rows_per_statement) {
 
   const ModelMeta *meta_ptr = qb_prototype.getModelMeta();
   if (!meta_ptr) {
@@ -76,6 +80,9 @@ Error Session::CreateBatchProviderInternal(
                                        OnConflictClause::Action::DoNothing)));
 
   std::vector<std::string> batch_ordered_db_field_names_cache;
+  size_t estimated_row_bytes = 0;
+  // 每条 INSERT 的行数：字段顺序确定后按驱动上限创建，随后按耗时调节
+  std::optional<internal::AdaptiveBatchSizer> batch_sizer;
   std::optional<std::vector<ModelBase *>> current_provider_chunk_opt;
   Error first_error_encountered_in_loop = make_ok();
 
@@ -118,6 +125,8 @@ Error Session::CreateBatchProviderInternal(
           batch_ordered_db_field_names_cache.push_back(
               pair.first.toStdString());
         }
+        estimated_row_bytes =
+            internal::estimateRowBytes(first_data.fields_to_write);
       } else {
         per_db_batch_completion_callback(models_in_current_provider_chunk,
                                          make_ok()); // Chunk of nullptrs
@@ -174,134 +183,164 @@ Error Session::CreateBatchProviderInternal(
       continue;
     }
 
-    internal_batch_helpers::BatchSqlParts sql_parts_for_this_db_batch;
-    auto [models_prepared_for_db_op, prepare_error] =
-        internal_batch_helpers::prepareModelsAndSqlPlaceholders(
-            *this, models_in_current_provider_chunk, meta,
-            batch_ordered_db_field_names_cache, sql_parts_for_this_db_batch);
-
-    if (prepare_error) {
-      if (first_error_encountered_in_loop.isOk())
-        first_error_encountered_in_loop = prepare_error;
-      if (models_prepared_for_db_op
-              .empty()) { // 如果准备后完全为空，则整个 chunk 都有问题
-        per_db_batch_completion_callback(models_in_current_provider_chunk,
-                                         prepare_error);
-      } else { // 部分准备成功，部分失败（失败的已在
-               // prepareModelsAndSqlPlaceholders 中单独回调）
-        // 对于成功准备的部分，我们是否继续？或者因为批次中部分失败而整体失败？
-        // 目前 prepareModelsAndSqlPlaceholders 不会单独回调，它返回第一个错误。
-        // 所以如果 prepare_error 非空，意味着整个 chunk 的准备阶段有问题。
-        per_db_batch_completion_callback(models_in_current_provider_chunk,
-                                         prepare_error);
-      }
-      continue;
-    }
-    if (models_prepared_for_db_op.empty()) {
-      per_db_batch_completion_callback(models_in_current_provider_chunk,
-                                       make_ok()); // 无可操作模型
-      continue;
+    if (!batch_sizer) {
+      const size_t conflict_placeholders =
+          active_conflict_clause
+              ? active_conflict_clause->update_assignments.size()
+              : 0;
+      batch_sizer.emplace(db_driver_name_upper,
+                          batch_ordered_db_field_names_cache.size(),
+                          estimated_row_bytes, max_rows_per_statement,
+                          conflict_placeholders);
     }
 
-    Error build_sql_err = internal_batch_helpers::buildFullBatchSqlStatement(
-        *this, qb_prototype, meta, batch_ordered_db_field_names_cache,
-        active_conflict_clause, sql_parts_for_this_db_batch);
-
-    if (build_sql_err || !sql_parts_for_this_db_batch.can_proceed) {
-      Error final_build_err = build_sql_err
-                                  ? build_sql_err
-                                  : Error(ErrorCode::StatementPreparationError,
-                                          "Failed to build final SQL for batch "
-                                          "(can_proceed is false).");
-      per_db_batch_completion_callback(models_prepared_for_db_op,
-                                       final_build_err);
-      if (first_error_encountered_in_loop.isOk())
-        first_error_encountered_in_loop = final_build_err;
-      continue;
-    }
+    // provider 给出的块可能超过驱动的占位符/报文上限，按 sizer 拆成多条语句
+    for (size_t sub_begin = 0;
+         sub_begin < models_in_current_provider_chunk.size();) {
+      const size_t sub_end =
+          std::min(models_in_current_provider_chunk.size(),
+                   sub_begin + batch_sizer->nextBatchSize());
+      std::vector<ModelBase *> sub_chunk(
+          models_in_current_provider_chunk.begin() + sub_begin,
+          models_in_current_provider_chunk.begin() + sub_end);
+      sub_begin = sub_end;
+
+      internal_batch_helpers::BatchSqlParts sql_parts_for_this_db_batch;
+      auto [models_prepared_for_db_op, prepare_error] =
+          internal_batch_helpers::prepareModelsAndSqlPlaceholders(
+              *this, sub_chunk, meta, batch_ordered_db_field_names_cache,
+              sql_parts_for_this_db_batch);
+
+      if (prepare_error) {
+        if (first_error_encountered_in_loop.isOk())
+          first_error_encountered_in_loop = prepare_error;
+        if (models_prepared_for_db_op
+                .empty()) { // 如果准备后完全为空，则整个 chunk 都有问题
+          per_db_batch_completion_callback(sub_chunk, prepare_error);
+        } else { // 部分准备成功，部分失败（失败的已在
+                 // prepareModelsAndSqlPlaceholders 中单独回调）
+          // 对于成功准备的部分，我们是否继续？或者因为批次中部分失败而整体失败？
+          // 目前 prepareModelsAndSqlPlaceholders 不会单独回调，它返回第一个错误。
+          // 所以如果 prepare_error 非空，意味着整个 chunk 的准备阶段有问题。
+          per_db_batch_completion_callback(sub_chunk, prepare_error);
+        }
+        continue;
+      }
+      if (models_prepared_for_db_op.empty()) {
+        per_db_batch_completion_callback(sub_chunk, make_ok()); // 无可操作模型
+        continue;
+      }
 
-    internal_batch_helpers::ExecutionResult exec_result =
-        internal_batch_helpers::executeBatchSql(
-            *this, sql_parts_for_this_db_batch.final_sql_statement,
-            sql_parts_for_this_db_batch.final_bindings,
-            models_prepared_for_db_op, // 这些是实际参与DB操作的模型
-            active_conflict_clause);
-
-    if (exec_result.db_error) {
-      per_db_batch_completion_callback(models_prepared_for_db_op,
-                                       exec_result.db_error);
-      if (first_error_encountered_in_loop.isOk())
-        first_error_encountered_in_loop = exec_result.db_error;
-      continue;
-    }
+      Error build_sql_err = internal_batch_helpers::buildFullBatchSqlStatement(
+          *this, qb_prototype, meta, batch_ordered_db_field_names_cache,
+          active_conflict_clause, sql_parts_for_this_db_batch);
+
+      if (build_sql_err || !sql_parts_for_this_db_batch.can_proceed) {
+        Error final_build_err =
+            build_sql_err ? build_sql_err
+                          : Error(ErrorCode::StatementPreparationError,
+                                  "Failed to build final SQL for batch "
+                                  "(can_proceed is false).");
+        per_db_batch_completion_callback(models_prepared_for_db_op,
+                                         final_build_err);
+        if (first_error_encountered_in_loop.isOk())
+          first_error_encountered_in_loop = final_build_err;
+        continue;
+      }
 
-    std::vector<ModelBase *> successfully_backfilled_models;
-    if (has_auto_inc_pk && !exec_result.models_potentially_persisted.empty()) {
-      if (use_returning_for_batch) {
-        successfully_backfilled_models =
-            internal_batch_helpers::backfillIdsFromReturning(
-                exec_result.query_object, meta,
-                exec_result.models_potentially_persisted, pk_cpp_name_str,
-                pk_cpp_type);
-      } else if (driver_supports_last_insert_id) {
-        successfully_backfilled_models =
-            internal_batch_helpers::backfillIdsFromLastInsertId(
-                exec_result.query_object, *this, meta,
-                exec_result.models_potentially_persisted,
-                exec_result.rows_affected, pk_cpp_name_str, pk_cpp_type,
-                active_conflict_clause);
-      } else { // 无 RETURNING 且无 LastInsertId，但操作成功
-        // 此时 successfully_backfilled_models 将为空，但
-        // models_potentially_persisted 中的模型 可能已被标记为
-        // _is_persisted。回调时传递 models_potentially_persisted。
-        for (ModelBase *m : exec_result.models_potentially_persisted) {
-          if (m && m->_is_persisted)
-            successfully_backfilled_models.push_back(m);
-        }
+      const auto exec_started_at = std::chrono::steady_clock::now();
+      internal_batch_helpers::ExecutionResult exec_result =
+          internal_batch_helpers::executeBatchSql(
+              *this, sql_parts_for_this_db_batch.final_sql_statement,
+              sql_parts_for_this_db_batch.final_bindings,
+              models_prepared_for_db_op, // 这些是实际参与DB操作的模型
+              active_conflict_clause);
+      batch_sizer->recordBatch(models_prepared_for_db_op.size(),
+                               std::chrono::steady_clock::now() -
+                                   exec_started_at);
+
+      if (exec_result.db_error) {
+        per_db_batch_completion_callback(models_prepared_for_db_op,
+                                         exec_result.db_error);
+        if (first_error_encountered_in_loop.isOk())
+          first_error_encountered_in_loop = exec_result.db_error;
+        continue;
       }
-    } else if (!exec_result.models_potentially_persisted.empty() &&
-               exec_result.rows_affected >= 0) { // 无自增PK，但操作成功
-      for (ModelBase *m : exec_result.models_potentially_persisted) {
-        if (m) { // 之前在 executeBatchSql 中已根据行影响数和冲突选项初步标记
-          if (m->_is_persisted)
-            successfully_backfilled_models.push_back(m);
+
+      std::vector<ModelBase *> successfully_backfilled_models;
+      if (has_auto_inc_pk &&
+          !exec_result.models_potentially_persisted.empty()) {
+        if (use_returning_for_batch) {
+          successfully_backfilled_models =
+              internal_batch_helpers::backfillIdsFromReturning(
+                  *exec_result.statement, meta,
+                  exec_result.models_potentially_persisted, pk_cpp_name_str,
+                  pk_cpp_type);
+        } else if (driver_supports_last_insert_id) {
+          successfully_backfilled_models =
+              internal_batch_helpers::backfillIdsFromLastInsertId(
+                  *exec_result.statement, *this, meta,
+                  exec_result.models_potentially_persisted,
+                  exec_result.rows_affected, pk_cpp_name_str, pk_cpp_type,
+                  active_conflict_clause);
+        } else { // 无 RETURNING 且无 LastInsertId，但操作成功
+          // 此时 successfully_backfilled_models 将为空，但
+          // models_potentially_persisted 中的模型 可能已被标记为
+          // _is_persisted。回调时传递 models_potentially_persisted。
+          for (ModelBase *m : exec_result.models_potentially_persisted) {
+            if (m && m->_is_persisted)
+              successfully_backfilled_models.push_back(m);
+          }
+        }
+      } else if (!exec_result.models_potentially_persisted.empty() &&
+                 exec_result.rows_affected >= 0) { // 无自增PK，但操作成功
+        for (ModelBase *m : exec_result.models_potentially_persisted) {
+          if (m) { // 之前在 executeBatchSql 中已根据行影响数和冲突选项初步标记
+            if (m->_is_persisted)
+              successfully_backfilled_models.push_back(m);
+          }
         }
       }
-    }
 
-    internal_batch_helpers::callAfterCreateHooks(
-        *this, successfully_backfilled_models, first_error_encountered_in_loop);
-
-    // 决定回调中传递哪个列表：
-    // 如果ID回填成功了一些模型，则传递 successfully_backfilled_models。
-    // 如果ID回填没有适用或失败，但DB操作本身成功，则传递
-    // exec_result.models_potentially_persisted （这些模型已被标记为
-    // _is_persisted，只是没有获得ID）。
-    // 回调的目的是通知哪些模型被“成功处理”（插入/更新，并尽可能回填ID）。
-    if (!successfully_backfilled_models.empty()) {
-      per_db_batch_completion_callback(successfully_backfilled_models,
-                                       make_ok());
-    } else if (exec_result.rows_affected >= 0 &&
-               exec_result.db_error.isOk()) { // DB操作成功，但可能无ID回填
-      // 检查 models_prepared_for_db_op 中哪些被标记为 _is_persisted
-      std::vector<ModelBase *> final_persisted_for_callback;
-      for (ModelBase *m : models_prepared_for_db_op) {
-        if (m && m->_is_persisted)
-          final_persisted_for_callback.push_back(m);
+      internal_batch_helpers::callAfterCreateHooks(
+          *this, successfully_backfilled_models,
+          first_error_encountered_in_loop);
+
+      // 决定回调中传递哪个列表：
+      // 如果ID回填成功了一些模型，则传递 successfully_backfilled_models。
+      // 如果ID回填没有适用或失败，但DB操作本身成功，则传递
+      // exec_result.models_potentially_persisted （这些模型已被标记为
+      // _is_persisted，只是没有获得ID）。
+      // 回调的目的是通知哪些模型被“成功处理”（插入/更新，并尽可能回填ID）。
+      if (!successfully_backfilled_models.empty()) {
+        per_db_batch_completion_callback(successfully_backfilled_models,
+                                         make_ok());
+      } else if (exec_result.rows_affected >= 0 &&
+                 exec_result.db_error.isOk()) { // DB操作成功，但可能无ID回填
+        // 检查 models_prepared_for_db_op 中哪些被标记为 _is_persisted
+        std::vector<ModelBase *> final_persisted_for_callback;
+        for (ModelBase *m : models_prepared_for_db_op) {
+          if (m && m->_is_persisted)
+            final_persisted_for_callback.push_back(m);
+        }
+        per_db_batch_completion_callback(final_persisted_for_callback,
+                                         make_ok());
+      } else { // 如果没有成功回填的模型，并且DB操作可能有问题（虽然上面已检查
+               // exec_result.db_error）
+        per_db_batch_completion_callback(
+            {}, exec_result.db_error.isOk()
+                    ? Error(ErrorCode::UnknownError,
+                            "Batch operation reported success but no models "
+                            "processed or IDs backfilled.")
+                    : exec_result.db_error);
       }
-      per_db_batch_completion_callback(final_persisted_for_callback, make_ok());
-    } else { // 如果没有成功回填的模型，并且DB操作可能有问题（虽然上面已检查
-             // exec_result.db_error）
-      per_db_batch_completion_callback(
-          {}, exec_result.db_error.isOk()
-                  ? Error(ErrorCode::UnknownError,
-                          "Batch operation reported success but no models "
-                          "processed or IDs backfilled.")
-                  : exec_result.db_error);
     }
-
   } // 结束 provider while 循环
 
+  // upsert 可能改写已缓存的行
+  if (active_conflict_clause)
+    invalidateCachedTable(meta.table_name);
+
   if (clear_session_temp_on_conflict_at_end) {
     this->clearTempOnConflictClause();
   }
@@ -320,17 +359,20 @@ std::expected<size_t, Error> Session::CreateBatchWithMeta(
 
   QueryBuilder qb_proto = this->Model(meta);
 
+  // 0 表示不在此处分块，由 CreateBatchProviderInternal 按驱动上限拆分语句
+  const size_t provider_chunk_rows = internal_db_batch_size_hint > 0
+                                         ? internal_db_batch_size_hint
+                                         : models_to_create.size();
   size_t provider_current_idx = 0;
   auto internal_vector_provider = [&models_to_create, provider_current_idx,
-                                   internal_db_batch_size_hint]() mutable
+                                   provider_chunk_rows]() mutable
       -> std::optional<std::vector<ModelBase *>> {
     if (provider_current_idx >= models_to_create.size()) {
       return std::nullopt;
     }
     std::vector<ModelBase *> chunk;
-    size_t end_idx =
-        std::min(models_to_create.size(),
-                 provider_current_idx + internal_db_batch_size_hint);
+    size_t end_idx = std::min(models_to_create.size(),
+                              provider_current_idx + provider_chunk_rows);
     for (size_t i = provider_current_idx; i < end_idx; ++i) {
       if (models_to_create[i]) {
         chunk.push_back(models_to_create[i]);
@@ -369,7 +411,8 @@ std::expected<size_t, Error> Session::CreateBatchWithMeta(
 
   Error provider_loop_err = this->CreateBatchProviderInternal(
       qb_proto, internal_vector_provider,
-      per_db_batch_completion_callback_for_vector, conflict_options_override);
+      per_db_batch_completion_callback_for_vector, conflict_options_override,
+      internal_db_batch_size_hint);
 
   if (provider_loop_err) {
     return std::unexpected(provider_loop_err);
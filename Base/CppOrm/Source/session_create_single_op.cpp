@@ -1,5 +1,6 @@
 // cpporm/session_create_single_op.cpp
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h"
 #include "cpporm/session.h"
 // #include "cpporm/qt_db_manager.h" // 如果需要直接访问
@@ -189,12 +190,16 @@ Session::CreateImpl(const QueryBuilder &qb, ModelBase &model_instance,
             data_to_write.auto_increment_pk_name_db.toStdString()));
   }
 
-  auto [query, exec_err] = execute_query_internal(
+  auto [statement, exec_err] = execute_query_internal(
       this->db_handle_, final_sql_query_str, all_bindings);
+  QSqlQuery &query = *statement;
 
   if (clear_temp_on_conflict_at_end)
     this->clearTempOnConflictClause();
 
+  // upsert 可能改写已缓存的行
+  if (active_conflict_clause)
+    invalidateCachedTable(meta.table_name);
   if (exec_err)
     return std::unexpected(exec_err);
 
@@ -217,6 +222,7 @@ Session::CreateImpl(const QueryBuilder &qb, ModelBase &model_instance,
       rows_affected > 0) {
     if (query.next())
       returned_id = query.value(0);
+    query.finish();
   } else if (data_to_write.has_auto_increment_pk && driver_can_return_id &&
              was_insert_action && rows_affected == 1) {
     returned_id = query.lastInsertId();
@@ -265,6 +271,18 @@ Session::CreateImpl(const QueryBuilder &qb, ModelBase &model_instance,
     }
   }
 
+  // 插入（或按插入值整行覆盖的 upsert）后，数据库中的行与写入的值一致；
+  // DO NOTHING 或只更新部分列时行内容未知，放弃脏字段跟踪。
+  if (model_instance._is_persisted &&
+      (!active_conflict_clause ||
+       active_conflict_clause->action ==
+           OnConflictClause::Action::UpdateAllExcluded)) {
+    snapshotWrittenValues(model_instance, meta, data_to_write.fields_to_write,
+                          true);
+  } else {
+    model_instance.markAllDirty();
+  }
+
   if (model_instance._is_persisted) {
     hook_err = model_instance.afterCreate(*this);
     if (hook_err)
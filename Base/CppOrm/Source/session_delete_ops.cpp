@@ -1,5 +1,7 @@
 // cpporm/session_delete_ops.cpp
+#include "cpporm/adaptive_batch_sizer.h"
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h" // Now includes core, execution, and state
 #include "cpporm/session.h"
 
@@ -8,6 +10,7 @@
 #include <QSqlQuery>
 #include <QVariant>
 #include <algorithm> // for std::min
+#include <chrono>
 
 namespace cpporm {
 
@@ -87,8 +90,10 @@ Session::DeleteImpl(const QueryBuilder &qb_const) {
   // Hooks are generally managed by higher-level methods if model instances are
   // involved. DeleteImpl is generic.
 
-  auto [query_obj, exec_err] =
+  auto [statement, exec_err] =
       execute_query_internal(this->db_handle_, sql, params);
+  QSqlQuery &query_obj = *statement;
+  invalidateCachedTable(qb);
   if (exec_err)
     return std::unexpected(exec_err);
 
@@ -217,28 +222,36 @@ std::expected<long long, Error> Session::DeleteBatch(
   Error first_error_encountered = make_ok();
   bool an_error_occurred_in_any_batch = false;
 
-  size_t actual_batch_size = batch_delete_size_hint;
-  if (actual_batch_size == 0 && !primary_keys_list.empty())
-    actual_batch_size = 1;
-  if (actual_batch_size > 200)
-    actual_batch_size = 100; // Cap batch size
+  // 每行占用 primary_keys 个占位符；hint 为 0 时完全由驱动上限与耗时决定。
+  // 软删除走 UPDATE，SET 中的 deleted_at / updated_at 各占一个参数
+  size_t reserved_placeholders = 0;
+  if (meta.findFieldWithFlag(FieldFlag::DeletedAt)) {
+    reserved_placeholders = 1;
+    if (meta.findFieldWithFlag(FieldFlag::UpdatedAt))
+      ++reserved_placeholders;
+  }
+  internal::AdaptiveBatchSizer batch_sizer(
+      db_handle_.driverName().toUpper(), meta.primary_keys_db_names.size(), 0,
+      batch_delete_size_hint, reserved_placeholders);
 
-  for (size_t i = 0; i < primary_keys_list.size(); i += actual_batch_size) {
+  size_t i = 0;
+  while (i < primary_keys_list.size()) {
     // Create a QB specifically for this session and meta for each batch
     QueryBuilder qb_for_this_batch(this, this->connection_name_, &meta);
 
+    const size_t actual_batch_size = batch_sizer.nextBatchSize();
     size_t current_batch_end_idx =
         std::min(i + actual_batch_size, primary_keys_list.size());
-
-    if (current_batch_end_idx <= i)
-      continue;
+    const size_t batch_begin_idx = i;
+    i = current_batch_end_idx;
 
     if (meta.primary_keys_db_names.size() == 1) { // Single PK
       const std::string &pk_col_db_name = meta.primary_keys_db_names[0];
       std::vector<QueryValue> pk_values_for_in_clause;
-      pk_values_for_in_clause.reserve(current_batch_end_idx - i);
+      pk_values_for_in_clause.reserve(current_batch_end_idx -
+                                      batch_begin_idx);
 
-      for (size_t k = i; k < current_batch_end_idx; ++k) {
+      for (size_t k = batch_begin_idx; k < current_batch_end_idx; ++k) {
         const auto &pk_map_for_item = primary_keys_list[k];
         auto it = pk_map_for_item.find(pk_col_db_name);
         if (it != pk_map_for_item.end()) {
@@ -264,9 +277,10 @@ std::expected<long long, Error> Session::DeleteBatch(
     } else { // Composite PKs
       std::vector<std::string> or_conditions_str_parts;
       std::vector<QueryValue> all_composite_pk_bindings;
-      or_conditions_str_parts.reserve(current_batch_end_idx - i);
+      or_conditions_str_parts.reserve(current_batch_end_idx -
+                                      batch_begin_idx);
 
-      for (size_t k = i; k < current_batch_end_idx; ++k) {
+      for (size_t k = batch_begin_idx; k < current_batch_end_idx; ++k) {
         std::string current_item_pk_condition_group_str = "(";
         bool first_col_in_group = true;
         bool current_item_pk_group_valid = true;
@@ -321,7 +335,11 @@ std::expected<long long, Error> Session::DeleteBatch(
       }
     }
 
+    const auto batch_started_at = std::chrono::steady_clock::now();
     auto batch_delete_result = this->DeleteImpl(qb_for_this_batch);
+    batch_sizer.recordBatch(current_batch_end_idx - batch_begin_idx,
+                            std::chrono::steady_clock::now() -
+                                batch_started_at);
 
     if (batch_delete_result.has_value()) {
       total_rows_affected_accumulator += batch_delete_result.value();
@@ -1,6 +1,7 @@
 // cpporm/session_lifecycle.cpp
 #include "cpporm/model_base.h" // FriendAccess 可能需要 ModelBase/ModelMeta
 #include "cpporm/qt_db_manager.h"
+#include "cpporm/qt_db_pool.h"
 #include "cpporm/session.h" // 主头文件
 #include "cpporm/session_priv_batch_helpers.h" // For FriendAccess definition & internal::SessionModelDataForWrite
 
@@ -14,9 +15,25 @@ namespace cpporm {
 // --- Session 构造函数、析构函数、移动操作 ---
 Session::Session(QString connection_name)
     : connection_name_(std::move(connection_name)),
-      db_handle_(QtDbManager::getDatabase(connection_name_)),
       is_explicit_transaction_handle_(false),
       temp_on_conflict_clause_(nullptr) {
+  // 连接名注册了连接池时只使用池中属于当前线程的连接，不取共享连接：
+  // 共享连接属于其他线程，Qt6 下在工作线程中取用会报警且不可用。
+  if (std::shared_ptr<QtDbPool> pool = QtDbPool::find(connection_name_)) {
+    auto lease = pool->acquire();
+    if (!lease) {
+      qWarning() << "cpporm Session: Failed to acquire pooled connection for"
+                 << connection_name_ << ":"
+                 << QString::fromStdString(lease.error().message)
+                 << ". The session has no usable connection.";
+      return;
+    }
+    pool_lease_ = std::make_shared<QtDbPool::Lease>(std::move(*lease));
+    connection_name_ = pool_lease_->connectionName();
+    db_handle_ = pool_lease_->database();
+  } else {
+    db_handle_ = QtDbManager::getDatabase(connection_name_);
+  }
   if (!db_handle_.isValid()) {
     qWarning()
         << "cpporm Session: Constructed with invalid QSqlDatabase for "
@@ -45,13 +62,23 @@ Session::~Session() {
                << connection_name_ << ". Rolling back automatically.";
     db_handle_.rollback();
   }
+  // 租约归还时连接可能被关闭，先释放本地句柄副本
+  if (pool_lease_) {
+    db_handle_ = QSqlDatabase();
+    pool_lease_.reset();
+  }
 }
 
 Session::Session(Session &&other) noexcept
     : connection_name_(std::move(other.connection_name_)),
       db_handle_(std::move(other.db_handle_)),
       is_explicit_transaction_handle_(other.is_explicit_transaction_handle_),
-      temp_on_conflict_clause_(std::move(other.temp_on_conflict_clause_)) {
+      temp_on_conflict_clause_(std::move(other.temp_on_conflict_clause_)),
+      pool_lease_(std::move(other.pool_lease_)),
+      identity_map_enabled_(other.identity_map_enabled_),
+      identity_map_(std::move(other.identity_map_)),
+      cache_scope_(std::move(other.cache_scope_)),
+      tx_written_tables_(std::move(other.tx_written_tables_)) {
   other.is_explicit_transaction_handle_ = false;
 }
 
@@ -66,6 +93,11 @@ Session &Session::operator=(Session &&other) noexcept {
     db_handle_ = std::move(other.db_handle_);
     is_explicit_transaction_handle_ = other.is_explicit_transaction_handle_;
     temp_on_conflict_clause_ = std::move(other.temp_on_conflict_clause_);
+    pool_lease_ = std::move(other.pool_lease_);
+    identity_map_enabled_ = other.identity_map_enabled_;
+    identity_map_ = std::move(other.identity_map_);
+    cache_scope_ = std::move(other.cache_scope_);
+    tx_written_tables_ = std::move(other.tx_written_tables_);
     other.is_explicit_transaction_handle_ = false;
   }
   return *this;
@@ -104,7 +136,7 @@ internal_batch_helpers::FriendAccess::callExtractModelData(
                             include_timestamps_even_if_null);
 }
 
-std::pair<QSqlQuery, Error>
+std::pair<internal::StatementLease, Error>
 internal_batch_helpers::FriendAccess::callExecuteQueryInternal(
     QSqlDatabase db, // Session 实例不是必需的，因为原始函数是静态的
     const QString &sql, const QVariantList &params) {
@@ -1,5 +1,6 @@
 // cpporm/session_mapping_utils.cpp
 #include "cpporm/model_base.h"
+#include "cpporm/row_mapper.h"
 #include "cpporm/session.h"
 #include <QByteArray>
 #include <QDate>
@@ -12,120 +13,12 @@
 
 namespace cpporm {
 
+// 单行映射：为当前结果集临时编译一个 RowMapper。
+// 多行读取（FindImpl）应自行构造 RowMapper 并逐行复用。
 Error Session::mapRowToModel(QSqlQuery &query, ModelBase &model,
                              const ModelMeta &meta) {
-  QSqlRecord record = query.record();
-  for (int i = 0; i < record.count(); ++i) {
-    QString db_col_name_qstr = record.fieldName(i);
-    const FieldMeta *field_meta =
-        meta.findFieldByDbName(db_col_name_qstr.toStdString());
-
-    if (!field_meta) {
-      continue;
-    }
-    if (has_flag(field_meta->flags, FieldFlag::Association))
-      continue;
-
-    QVariant q_value = query.value(i);
-    std::any cpp_value;
-
-    if (q_value.isNull() || q_value.typeId() == QMetaType::UnknownType ||
-        !q_value.isValid()) {
-      // If DB value is NULL, set std::any to represent this (empty or specific
-      // null type)
-      Error set_err = model.setFieldValue(field_meta->cpp_name, std::any{});
-      if (set_err) {
-        qWarning() << "cpporm Session::mapRowToModel: Error setting "
-                      "null/invalid field"
-                   << QString::fromStdString(field_meta->cpp_name) << ":"
-                   << set_err.toString().c_str();
-      }
-      continue;
-    }
-
-    bool conversion_ok = false;
-    if (field_meta->cpp_type == typeid(QDateTime)) {
-      if (q_value.canConvert<QDateTime>()) {
-        cpp_value = q_value.toDateTime();
-        conversion_ok = true;
-      }
-    } else if (field_meta->cpp_type == typeid(QDate)) {
-      if (q_value.canConvert<QDate>()) {
-        cpp_value = q_value.toDate();
-        conversion_ok = true;
-      }
-    } else if (field_meta->cpp_type == typeid(QTime)) {
-      if (q_value.canConvert<QTime>()) {
-        cpp_value = q_value.toTime();
-        conversion_ok = true;
-      }
-    } else if (field_meta->cpp_type == typeid(std::string)) {
-      if (q_value.typeId() == QMetaType::QByteArray) {
-        // If the database returns bytes (e.g. for TEXT/BLOB treated as string)
-        // assume UTF-8. If it's truly binary, std::string might not be the best
-        // C++ type.
-        QByteArray ba = q_value.toByteArray();
-        cpp_value = std::string(ba.constData(), static_cast<size_t>(ba.size()));
-        conversion_ok = true;
-      } else if (q_value.canConvert<QString>()) {
-        QByteArray ba = q_value.toString().toUtf8();
-        cpp_value = std::string(ba.constData(), static_cast<size_t>(ba.size()));
-        conversion_ok = true;
-      } else {
-        qWarning()
-            << "cpporm Session::mapRowToModel: QVariant for std::string field "
-            << QString::fromStdString(field_meta->cpp_name)
-            << " cannot be converted to QString or QByteArray. DB value type: "
-            << q_value.typeName();
-      }
-    } else if (field_meta->cpp_type == typeid(int)) {
-      cpp_value = q_value.toInt(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(long long)) {
-      cpp_value = q_value.toLongLong(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(unsigned int)) {
-      cpp_value = q_value.toUInt(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(unsigned long long)) {
-      cpp_value = q_value.toULongLong(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(double)) {
-      cpp_value = q_value.toDouble(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(float)) {
-      cpp_value = q_value.toFloat(&conversion_ok);
-    } else if (field_meta->cpp_type == typeid(bool)) {
-      cpp_value = q_value.toBool();
-      conversion_ok = true;
-    } else if (field_meta->cpp_type == typeid(QByteArray)) {
-      cpp_value = q_value.toByteArray();
-      conversion_ok = true;
-    } else {
-      qWarning()
-          << "cpporm Session::mapRowToModel: Unsupported C++ type for field"
-          << QString::fromStdString(field_meta->cpp_name)
-          << "Type:" << field_meta->cpp_type.name();
-      continue;
-    }
-
-    if (!conversion_ok) {
-      qWarning() << "cpporm Session::mapRowToModel: QVariant to C++ type "
-                    "conversion failed for field"
-                 << QString::fromStdString(field_meta->cpp_name)
-                 << ". DB value:" << q_value.toString()
-                 << "(QVariant type:" << q_value.typeName()
-                 << ", Target C++ type:" << field_meta->cpp_type.name() << ")";
-      Error set_err = model.setFieldValue(field_meta->cpp_name, std::any{});
-      if (set_err) {
-        // Potentially return error or log and continue
-      }
-      continue;
-    }
-
-    Error set_err = model.setFieldValue(field_meta->cpp_name, cpp_value);
-    if (set_err) {
-      qWarning() << "cpporm Session::mapRowToModel: Error setting field"
-                 << QString::fromStdString(field_meta->cpp_name)
-                 << "after conversion:" << set_err.toString().c_str();
-    }
-  }
-  model._is_persisted = true;
+  internal::RowMapper row_mapper(meta, query.record());
+  row_mapper.mapRow(query, model);
   return make_ok();
 }
 
@@ -142,7 +35,10 @@ Session::extractModelData(const ModelBase &model_instance,
     bool is_pk = has_flag(field_meta.flags, FieldFlag::PrimaryKey);
     bool is_auto_inc = has_flag(field_meta.flags, FieldFlag::AutoIncrement);
 
-    std::any val_any = model_instance.getFieldValue(field_meta.cpp_name);
+    // 已持有 FieldMeta，直接调用 getter，免去按名查找
+    std::any val_any = field_meta.getter
+                           ? field_meta.getter(&model_instance)
+                           : model_instance.getFieldValue(field_meta.cpp_name);
 
     QVariant q_val;
     if (!val_any.has_value()) {
@@ -217,6 +113,23 @@ Session::extractModelData(const ModelBase &model_instance,
   return data;
 }
 
+void Session::snapshotWrittenValues(ModelBase &model_instance,
+                                    const ModelMeta &meta,
+                                    const std::map<QString, QVariant> &written,
+                                    bool replace) {
+  // 快照按模型自身 ModelMeta 的 FieldId 下标存放
+  if (&meta != &model_instance._getOwnModelMeta()) {
+    model_instance.markAllDirty();
+    return;
+  }
+  if (replace || !model_instance._isDirtyTracked())
+    model_instance._loaded_values.assign(meta.fields.size(), QVariant());
+  for (const auto &[db_name, value] : written) {
+    model_instance._recordLoadedValue(
+        meta.findFieldIdByDbName(db_name.toStdString()), value);
+  }
+}
+
 void Session::autoSetTimestamps(ModelBase &model_instance,
                                 const ModelMeta &meta, bool is_create_op) {
   QDateTime current_ts = QDateTime::currentDateTimeUtc();
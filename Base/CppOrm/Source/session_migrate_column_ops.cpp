@@ -118,6 +118,56 @@ std::string normalizeDbType(const std::string &db_type_raw,
                      // original lowercased
 }
 
+DbColumnInfo readDbColumnInfo(const QSqlQuery &query,
+                              const QString &driverNameUpper) {
+  DbColumnInfo colInfo;
+  if (driverNameUpper == "QSQLITE") {
+    colInfo.name = query.value("name").toString().toStdString();
+    colInfo.type = query.value("type").toString().toStdString();
+    colInfo.is_nullable = !query.value("notnull").toBool();
+    QVariant dflt_val = query.value("dflt_value");
+    colInfo.default_value =
+        dflt_val.isNull() ? "" : dflt_val.toString().toStdString();
+    colInfo.column_key = query.value("pk").toInt() > 0 ? "PRI" : "";
+  } else if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
+    colInfo.name = query.value("Field").toString().toStdString();
+    colInfo.type = query.value("Type").toString().toStdString();
+    colInfo.is_nullable = (query.value("Null").toString().toUpper() == "YES");
+    QVariant defVal = query.value("Default");
+    colInfo.default_value =
+        defVal.isNull() ? "" : defVal.toString().toStdString();
+    colInfo.collation_name = query.value("Collation").toString().toStdString();
+    colInfo.column_key = query.value("Key").toString().toStdString();
+    colInfo.extra = query.value("Extra").toString().toStdString();
+  } else if (driverNameUpper == "QPSQL") {
+    colInfo.name = query.value("column_name").toString().toStdString();
+    std::string pg_udt_name = query.value("udt_name").toString().toStdString();
+    std::string pg_data_type =
+        query.value("data_type").toString().toStdString();
+
+    if (pg_data_type.rfind("ARRAY", 0) == 0) {
+      colInfo.type = pg_udt_name;
+      if (colInfo.type.rfind('_', 0) == 0)
+        colInfo.type.erase(0, 1);
+      colInfo.type += "[]";
+    } else if (pg_udt_name.empty() || pg_udt_name == "anyelement" ||
+               pg_udt_name == "anyarray") {
+      colInfo.type = pg_data_type;
+    } else {
+      colInfo.type = pg_udt_name;
+    }
+    colInfo.is_nullable =
+        (query.value("is_nullable").toString().toUpper() == "YES");
+    colInfo.default_value =
+        query.value("column_default").toString().toStdString();
+    colInfo.collation_name =
+        query.value("collation_name").toString().toStdString();
+  }
+  if (!colInfo.name.empty())
+    colInfo.normalized_type = normalizeDbType(colInfo.type, driverNameUpper);
+  return colInfo;
+}
+
 std::map<std::string, DbColumnInfo>
 getTableColumnsInfo(Session &session, const QString &tableName,
                     const QString &driverNameUpper) {
@@ -170,65 +220,88 @@ getTableColumnsInfo(Session &session, const QString &tableName,
   }
 
   while (query.next()) {
-    DbColumnInfo colInfo;
-    if (driverNameUpper == "QSQLITE") {
-      colInfo.name = query.value("name").toString().toStdString();
-      colInfo.type = query.value("type").toString().toStdString();
-      colInfo.is_nullable = !query.value("notnull").toBool();
-      QVariant dflt_val = query.value("dflt_value");
-      colInfo.default_value =
-          dflt_val.isNull() ? "" : dflt_val.toString().toStdString();
-      colInfo.column_key = query.value("pk").toInt() > 0 ? "PRI" : "";
-    } else if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
-      colInfo.name = query.value("Field").toString().toStdString();
-      colInfo.type = query.value("Type").toString().toStdString();
-      colInfo.is_nullable = (query.value("Null").toString().toUpper() == "YES");
-      QVariant defVal = query.value("Default");
-      colInfo.default_value =
-          defVal.isNull() ? "" : defVal.toString().toStdString();
-      colInfo.collation_name =
-          query.value("Collation").toString().toStdString();
-      colInfo.column_key = query.value("Key").toString().toStdString();
-      colInfo.extra = query.value("Extra").toString().toStdString();
-    } else if (driverNameUpper == "QPSQL") {
-      colInfo.name = query.value("column_name").toString().toStdString();
-      std::string pg_udt_name =
-          query.value("udt_name").toString().toStdString();
-      std::string pg_data_type =
-          query.value("data_type").toString().toStdString();
+    DbColumnInfo colInfo = readDbColumnInfo(query, driverNameUpper);
+    if (!colInfo.name.empty())
+      columns[colInfo.name] = colInfo;
+  }
+  return columns;
+}
 
-      if (pg_data_type.rfind("ARRAY", 0) == 0) {
-        colInfo.type = pg_udt_name;
-        if (colInfo.type.rfind('_', 0) == 0)
-          colInfo.type.erase(0, 1);
-        colInfo.type += "[]";
-      } else if (pg_udt_name.empty() || pg_udt_name == "anyelement" ||
-                 pg_udt_name == "anyarray") {
-        colInfo.type = pg_data_type;
-      } else {
-        colInfo.type = pg_udt_name;
-      }
-      colInfo.is_nullable =
-          (query.value("is_nullable").toString().toUpper() == "YES");
-      colInfo.default_value =
-          query.value("column_default").toString().toStdString();
-      colInfo.collation_name =
-          query.value("collation_name").toString().toStdString();
+namespace {
+
+struct PendingColumnAlter {
+  std::string column;
+  std::string action; // "ADD" / "MODIFY"，仅用于日志
+  std::string clause; // 不含 "ALTER TABLE t" 前缀
+};
+
+// MySQL/MariaDB 与 PostgreSQL 支持一条 ALTER TABLE 中包含多个子句：
+// 合并执行只重建一次表。合并语句失败时（整条语句不生效）逐列重试，
+// 单列失败与原来一样只告警。SQLite 每条 ALTER 只能有一个子句。
+void executeColumnAlters(Session &session, const ModelMeta &meta,
+                         const QString &driverNameUpper,
+                         const std::vector<PendingColumnAlter> &alters,
+                         MigrationContext &context) {
+  if (alters.empty())
+    return;
+  const std::string alter_prefix =
+      "ALTER TABLE " + QueryBuilder::quoteSqlIdentifier(meta.table_name) + " ";
+  const bool can_combine = driverNameUpper == "QMYSQL" ||
+                           driverNameUpper == "QMARIADB" ||
+                           driverNameUpper == "QPSQL";
+  if (can_combine && alters.size() > 1) {
+    std::string combined_sql = alter_prefix;
+    for (size_t i = 0; i < alters.size(); ++i) {
+      if (i > 0)
+        combined_sql += ", ";
+      combined_sql += alters[i].clause;
     }
-    if (!colInfo.name.empty()) {
-      colInfo.normalized_type = normalizeDbType(colInfo.type, driverNameUpper);
-      columns[colInfo.name] = colInfo;
+    combined_sql += ";";
+    qInfo() << "migrateModifyColumns (ALTER DDL): "
+            << QString::fromStdString(combined_sql);
+    auto [_, combined_err] = execute_ddl_query(
+        session.getDbHandle(), QString::fromStdString(combined_sql));
+    if (!combined_err)
+      return;
+    qWarning() << "migrateModifyColumns: Combined ALTER for table '"
+               << QString::fromStdString(meta.table_name)
+               << "' failed, retrying column by column: "
+               << QString::fromStdString(combined_err.toString());
+  }
+
+  for (const PendingColumnAlter &alter : alters) {
+    const std::string sql = alter_prefix + alter.clause + ";";
+    qInfo() << "migrateModifyColumns (" << alter.action.c_str()
+            << " DDL): " << QString::fromStdString(sql);
+    auto [_, err] =
+        execute_ddl_query(session.getDbHandle(), QString::fromStdString(sql));
+    if (err) {
+      context.ddl_failed = true;
+      qWarning() << "migrateModifyColumns: Failed to" << alter.action.c_str()
+                 << "column '" << QString::fromStdString(alter.column)
+                 << "': " << QString::fromStdString(err.toString());
     }
   }
-  return columns;
 }
 
+} // namespace
+
 Error migrateModifyColumns(Session &session, const ModelMeta &meta,
-                           const QString &driverNameUpper) {
+                           const QString &driverNameUpper,
+                           MigrationContext &context) {
   qInfo() << "migrateModifyColumns: Checking columns for table '"
           << QString::fromStdString(meta.table_name) << "'...";
-  std::map<std::string, DbColumnInfo> existing_db_columns = getTableColumnsInfo(
-      session, QString::fromStdString(meta.table_name), driverNameUpper);
+  std::map<std::string, DbColumnInfo> existing_db_columns;
+  if (context.snapshot) {
+    auto it_table = context.snapshot->columns.find(meta.table_name);
+    if (it_table != context.snapshot->columns.end())
+      existing_db_columns = it_table->second;
+  } else {
+    existing_db_columns = getTableColumnsInfo(
+        session, QString::fromStdString(meta.table_name), driverNameUpper);
+  }
+  // 收集本表所有列变更，最后合并为一条 ALTER TABLE 执行
+  std::vector<PendingColumnAlter> pending_alters;
 
   for (const auto &model_field : meta.fields) {
     if (has_flag(model_field.flags, FieldFlag::Association) ||
@@ -249,29 +322,19 @@ Error migrateModifyColumns(Session &session, const ModelMeta &meta,
               << QString::fromStdString(meta.table_name)
               << "'. Attempting to ADD.";
 
-      std::string add_col_sql_str =
-          "ALTER TABLE " + QueryBuilder::quoteSqlIdentifier(meta.table_name) +
-          " ADD COLUMN " +
+      std::string add_col_clause =
+          "ADD COLUMN " +
           QueryBuilder::quoteSqlIdentifier(model_field.db_name) + " " +
           model_sql_type_str;
 
       if (has_flag(model_field.flags, FieldFlag::NotNull))
-        add_col_sql_str += " NOT NULL";
+        add_col_clause += " NOT NULL";
       if (has_flag(model_field.flags, FieldFlag::Unique) &&
           !has_flag(model_field.flags, FieldFlag::PrimaryKey)) {
-        add_col_sql_str += " UNIQUE";
-      }
-      add_col_sql_str += ";";
-
-      qInfo() << "migrateModifyColumns (ADD DDL): "
-              << QString::fromStdString(add_col_sql_str);
-      auto [_, add_err] = execute_ddl_query(
-          session.getDbHandle(), QString::fromStdString(add_col_sql_str));
-      if (add_err) {
-        qWarning() << "migrateModifyColumns: Failed to ADD column '"
-                   << QString::fromStdString(model_field.db_name)
-                   << "': " << QString::fromStdString(add_err.toString());
+        add_col_clause += " UNIQUE";
       }
+      pending_alters.push_back(
+          {model_field.db_name, "ADD", std::move(add_col_clause)});
 
     } else { // Column exists, check for modifications
       DbColumnInfo &db_col = it_db_col->second;
@@ -340,20 +403,19 @@ Error migrateModifyColumns(Session &session, const ModelMeta &meta,
                 << QString::fromStdString(model_normalized_sql_type)
                 << "). Attempting to MODIFY.";
 
-        std::string alter_col_sql_str =
-            "ALTER TABLE " + QueryBuilder::quoteSqlIdentifier(meta.table_name);
+        std::string alter_col_clause;
         if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
-          alter_col_sql_str +=
-              " MODIFY COLUMN " +
+          alter_col_clause =
+              "MODIFY COLUMN " +
               QueryBuilder::quoteSqlIdentifier(model_field.db_name) + " " +
               model_sql_type_str;
           if (has_flag(model_field.flags, FieldFlag::NotNull))
-            alter_col_sql_str += " NOT NULL";
+            alter_col_clause += " NOT NULL";
           else
-            alter_col_sql_str += " NULL";
+            alter_col_clause += " NULL";
         } else if (driverNameUpper == "QPSQL") {
-          alter_col_sql_str +=
-              " ALTER COLUMN " +
+          alter_col_clause =
+              "ALTER COLUMN " +
               QueryBuilder::quoteSqlIdentifier(model_field.db_name) + " TYPE " +
               model_sql_type_str;
           // For PG, nullability and default changes are separate ALTER
@@ -373,23 +435,16 @@ Error migrateModifyColumns(Session &session, const ModelMeta &meta,
                      << "' type alteration skipped.";
           continue; // Skip to next field
         }
-        alter_col_sql_str += ";";
-
-        qInfo() << "migrateModifyColumns (MODIFY DDL): "
-                << QString::fromStdString(alter_col_sql_str);
-        auto [_, alter_err] = execute_ddl_query(
-            session.getDbHandle(), QString::fromStdString(alter_col_sql_str));
-        if (alter_err) {
-          qWarning() << "migrateModifyColumns: Failed to MODIFY column '"
-                     << QString::fromStdString(model_field.db_name)
-                     << "': " << QString::fromStdString(alter_err.toString());
-        }
+        pending_alters.push_back(
+            {model_field.db_name, "MODIFY", std::move(alter_col_clause)});
       }
       // TODO: Add logic to check and alter NULLability, DEFAULT values if they
       // differ, which might require separate ALTER COLUMN statements for some
       // DBs (like PostgreSQL).
     }
   }
+  executeColumnAlters(session, meta, driverNameUpper, pending_alters,
+                      context);
   return make_ok();
 }
 
@@ -244,11 +244,19 @@ getTableIndexesInfo(Session &session, const QString &tableName,
 }
 
 Error migrateManageIndexes(Session &session, const ModelMeta &meta,
-                           const QString &driverNameUpper) {
+                           const QString &driverNameUpper,
+                           MigrationContext &context) {
   qInfo() << "migrateManageIndexes: Managing indexes for table '"
           << QString::fromStdString(meta.table_name) << "'...";
-  std::map<std::string, DbIndexInfo> existing_db_indexes = getTableIndexesInfo(
-      session, QString::fromStdString(meta.table_name), driverNameUpper);
+  std::map<std::string, DbIndexInfo> existing_db_indexes;
+  if (context.snapshot) {
+    auto it_table = context.snapshot->indexes.find(meta.table_name);
+    if (it_table != context.snapshot->indexes.end())
+      existing_db_indexes = it_table->second;
+  } else {
+    existing_db_indexes = getTableIndexesInfo(
+        session, QString::fromStdString(meta.table_name), driverNameUpper);
+  }
 
   std::set<std::string>
       model_index_names_processed; // To track which model indexes we've handled
@@ -328,6 +336,7 @@ Error migrateManageIndexes(Session &session, const ModelMeta &meta,
       auto [_, drop_err] =
           execute_ddl_query(session.getDbHandle(), drop_sql); // Pass copy
       if (drop_err) {
+        context.ddl_failed = true;
         qWarning() << "migrateManageIndexes: Failed to DROP index '"
                    << model_idx_name_qstr
                    << "': " << QString::fromStdString(drop_err.toString());
@@ -387,6 +396,7 @@ Error migrateManageIndexes(Session &session, const ModelMeta &meta,
                   << QString::fromStdString(create_err.toString());
         } else if (!ignorable) { // If it's not an "already exists" error, or if
                                  // we tried to drop and still failed create
+          context.ddl_failed = true;
           qWarning() << "migrateManageIndexes: Failed to CREATE index '"
                      << model_idx_name_qstr
                      << "': " << QString::fromStdString(create_err.toString());
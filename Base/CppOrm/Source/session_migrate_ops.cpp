@@ -1,5 +1,6 @@
 // cpporm/session_migrate_ops.cpp
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/qt_db_manager.h"
 #include "cpporm/query_builder.h"
 #include "cpporm/session.h"
@@ -15,49 +16,55 @@
 
 namespace cpporm {
 
-Error Session::AutoMigrate(const ModelMeta &meta) {
-  if (!db_handle_.isOpen()) {
-    if (!db_handle_.open()) {
-      QSqlError err = db_handle_.lastError();
-      return Error(ErrorCode::ConnectionNotOpen,
-                   "Cannot AutoMigrate: Database connection is not open and "
-                   "failed to open: " +
-                       err.text().toStdString());
-    }
-  }
-  if (meta.table_name.empty()) {
-    return Error(ErrorCode::InvalidConfiguration,
-                 "Cannot AutoMigrate: ModelMeta has no table name.");
+namespace {
+// 迁移可能改变表结构（包括中途失败时的部分变更），
+// 离开 AutoMigrate 时丢弃该连接上已 prepare 的语句。
+struct StatementCacheInvalidator {
+  const QString &connection_name;
+  ~StatementCacheInvalidator() {
+    internal::PreparedStatementCache::instance().invalidate(connection_name);
   }
+};
+
+// 单表迁移：建表 → 列 → 索引。有结构快照时，快照中已存在的表跳过
+// CREATE TABLE IF NOT EXISTS；快照中没有的表是本次新建的，列与模型
+// 一致，跳过列比对，索引按空集比对（全部创建）。
+Error migrateTable(Session &session, const ModelMeta &meta,
+                   const QString &driverNameUpper,
+                   internal::MigrationContext &context) {
   qInfo() << "AutoMigrate: Starting migration for table '"
           << QString::fromStdString(meta.table_name) << "'...";
 
-  QString driverNameUpper = db_handle_.driverName().toUpper();
-
-  // Pass '*this' (Session reference) to internal migration functions
-  Error table_err = internal::migrateCreateTable(*this, meta, driverNameUpper);
-  if (table_err) {
-    qWarning() << "AutoMigrate: Failed during table creation for '"
-               << QString::fromStdString(meta.table_name)
-               << "': " << QString::fromStdString(table_err.toString());
-    return table_err;
+  const bool table_in_snapshot =
+      context.snapshot && context.snapshot->tables.count(meta.table_name) > 0;
+  if (!table_in_snapshot) {
+    Error table_err =
+        internal::migrateCreateTable(session, meta, driverNameUpper);
+    if (table_err) {
+      qWarning() << "AutoMigrate: Failed during table creation for '"
+                 << QString::fromStdString(meta.table_name)
+                 << "': " << QString::fromStdString(table_err.toString());
+      return table_err;
+    }
+    qInfo() << "AutoMigrate: Table creation/check phase completed for '"
+            << QString::fromStdString(meta.table_name) << "'.";
   }
-  qInfo() << "AutoMigrate: Table creation/check phase completed for '"
-          << QString::fromStdString(meta.table_name) << "'.";
 
-  Error column_err =
-      internal::migrateModifyColumns(*this, meta, driverNameUpper);
-  if (column_err) {
-    qWarning() << "AutoMigrate: Failed during column modification for '"
-               << QString::fromStdString(meta.table_name)
-               << "': " << QString::fromStdString(column_err.toString());
-    return column_err;
+  if (!context.snapshot || table_in_snapshot) {
+    Error column_err =
+        internal::migrateModifyColumns(session, meta, driverNameUpper, context);
+    if (column_err) {
+      qWarning() << "AutoMigrate: Failed during column modification for '"
+                 << QString::fromStdString(meta.table_name)
+                 << "': " << QString::fromStdString(column_err.toString());
+      return column_err;
+    }
+    qInfo() << "AutoMigrate: Column modification phase completed for '"
+            << QString::fromStdString(meta.table_name) << "'.";
   }
-  qInfo() << "AutoMigrate: Column modification phase completed for '"
-          << QString::fromStdString(meta.table_name) << "'.";
 
   Error index_err =
-      internal::migrateManageIndexes(*this, meta, driverNameUpper);
+      internal::migrateManageIndexes(session, meta, driverNameUpper, context);
   if (index_err) {
     qWarning() << "AutoMigrate: Failed during index management for '"
                << QString::fromStdString(meta.table_name)
@@ -71,19 +78,93 @@ Error Session::AutoMigrate(const ModelMeta &meta) {
           << QString::fromStdString(meta.table_name) << "'.";
   return make_ok();
 }
+} // namespace
+
+Error Session::AutoMigrate(const ModelMeta &meta) {
+  StatementCacheInvalidator invalidate_statements{connection_name_};
+  if (!db_handle_.isOpen()) {
+    if (!db_handle_.open()) {
+      QSqlError err = db_handle_.lastError();
+      return Error(ErrorCode::ConnectionNotOpen,
+                   "Cannot AutoMigrate: Database connection is not open and "
+                   "failed to open: " +
+                       err.text().toStdString());
+    }
+  }
+  if (meta.table_name.empty()) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "Cannot AutoMigrate: ModelMeta has no table name.");
+  }
+  internal::MigrationContext context;
+  return migrateTable(*this, meta, db_handle_.driverName().toUpper(), context);
+}
 
-Error Session::AutoMigrate(const std::vector<const ModelMeta *> &metas_vec) {
+Error Session::AutoMigrate(const std::vector<const ModelMeta *> &metas_vec,
+                           bool force) {
+  if (!db_handle_.isOpen()) {
+    if (!db_handle_.open()) {
+      QSqlError err = db_handle_.lastError();
+      return Error(ErrorCode::ConnectionNotOpen,
+                   "Cannot AutoMigrate: Database connection is not open and "
+                   "failed to open: " +
+                       err.text().toStdString());
+    }
+  }
+  std::vector<const ModelMeta *> metas;
+  std::vector<std::string> table_names;
+  metas.reserve(metas_vec.size());
   for (const auto *m_ptr : metas_vec) {
-    if (m_ptr) {
-      if (auto e_obj = AutoMigrate(*m_ptr)) {
-        return e_obj;
-      }
-    } else {
+    if (!m_ptr) {
       qWarning() << "AutoMigrate (vector): Encountered a null ModelMeta "
                     "pointer. Skipping.";
+      continue;
+    }
+    if (m_ptr->table_name.empty()) {
+      return Error(ErrorCode::InvalidConfiguration,
+                   "Cannot AutoMigrate: ModelMeta has no table name.");
+    }
+    metas.push_back(m_ptr);
+    table_names.push_back(m_ptr->table_name);
+  }
+  const QString driverNameUpper = db_handle_.driverName().toUpper();
+
+  const QString state_key = internal::schemaStateKey(metas);
+  const QString schema_hash =
+      internal::computeSchemaHash(metas, driverNameUpper);
+  if (!force) {
+    std::optional<QString> stored_hash =
+        internal::readStoredSchemaHash(*this, state_key);
+    if (stored_hash && *stored_hash == schema_hash) {
+      qInfo() << "AutoMigrate: Schema unchanged since last migration, skipping"
+              << metas.size() << "models.";
+      return make_ok();
     }
   }
-  qInfo() << "AutoMigrate: Batch migration completed for" << metas_vec.size()
+
+  StatementCacheInvalidator invalidate_statements{connection_name_};
+  std::optional<internal::SchemaSnapshot> snapshot =
+      internal::loadSchemaSnapshot(*this, table_names, driverNameUpper);
+  if (!snapshot) {
+    qInfo() << "AutoMigrate: Schema snapshot unavailable for driver"
+            << driverNameUpper << "; introspecting table by table.";
+  }
+  internal::MigrationContext context;
+  context.snapshot = snapshot ? &*snapshot : nullptr;
+  for (const ModelMeta *meta : metas) {
+    if (auto e_obj = migrateTable(*this, *meta, driverNameUpper, context)) {
+      return e_obj;
+    }
+  }
+
+  if (context.ddl_failed) {
+    qWarning() << "AutoMigrate: Some DDL statements failed; the schema hash "
+                  "is not recorded so the next run compares again.";
+  } else if (Error store_err =
+                 internal::storeSchemaHash(*this, state_key, schema_hash)) {
+    qWarning() << "AutoMigrate: Failed to record schema hash: "
+               << QString::fromStdString(store_err.toString());
+  }
+  qInfo() << "AutoMigrate: Batch migration completed for" << metas.size()
           << "models.";
   return make_ok();
 }
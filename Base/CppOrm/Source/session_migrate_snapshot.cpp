@@ -0,0 +1,185 @@
+// cpporm/session_migrate_snapshot.cpp
+#include "cpporm/session.h"
+#include "cpporm/session_migrate_priv.h"
+
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+
+namespace cpporm {
+namespace internal {
+
+namespace {
+
+QString inPlaceholders(size_t count) {
+  QStringList parts;
+  parts.reserve(static_cast<qsizetype>(count));
+  for (size_t i = 0; i < count; ++i)
+    parts << "?";
+  return parts.join(", ");
+}
+
+// 列查询的结果列名与逐表内省一致，行解析复用 readDbColumnInfo
+QString columnsSnapshotSql(const QString &driverNameUpper,
+                           const QString &in_list) {
+  if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
+    return QString("SELECT TABLE_NAME AS table_name, COLUMN_NAME AS `Field`, "
+                   "COLUMN_TYPE AS `Type`, IS_NULLABLE AS `Null`, "
+                   "COLUMN_DEFAULT AS `Default`, "
+                   "COLLATION_NAME AS `Collation`, "
+                   "COLUMN_KEY AS `Key`, EXTRA AS `Extra` "
+                   "FROM information_schema.COLUMNS "
+                   "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME IN (%1) "
+                   "ORDER BY TABLE_NAME, ORDINAL_POSITION;")
+        .arg(in_list);
+  }
+  if (driverNameUpper == "QPSQL") {
+    return QString("SELECT table_name, column_name, data_type, udt_name, "
+                   "is_nullable, column_default, character_maximum_length, "
+                   "numeric_precision, numeric_scale, collation_name "
+                   "FROM information_schema.columns "
+                   "WHERE table_schema = current_schema() "
+                   "AND table_name IN (%1) "
+                   "ORDER BY table_name, ordinal_position;")
+        .arg(in_list);
+  }
+  if (driverNameUpper == "QSQLITE") {
+    // pragma 表值函数需要 SQLite 3.26+（table_xinfo）
+    return QString("SELECT m.name AS table_name, p.name AS name, "
+                   "p.type AS type, p.\"notnull\" AS \"notnull\", "
+                   "p.dflt_value AS dflt_value, p.pk AS pk "
+                   "FROM sqlite_master AS m "
+                   "JOIN pragma_table_xinfo(m.name) AS p "
+                   "WHERE m.type = 'table' AND m.name IN (%1) "
+                   "ORDER BY m.name, p.cid;")
+        .arg(in_list);
+  }
+  return QString();
+}
+
+// 各驱动统一输出 table_name, index_name, column_name, is_unique,
+// is_primary, index_type，列按索引内顺序排列
+QString indexesSnapshotSql(const QString &driverNameUpper,
+                           const QString &in_list) {
+  if (driverNameUpper == "QMYSQL" || driverNameUpper == "QMARIADB") {
+    return QString("SELECT TABLE_NAME AS table_name, INDEX_NAME AS index_name, "
+                   "COLUMN_NAME AS column_name, NON_UNIQUE = 0 AS is_unique, "
+                   "INDEX_NAME = 'PRIMARY' AS is_primary, "
+                   "INDEX_TYPE AS index_type "
+                   "FROM information_schema.STATISTICS "
+                   "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME IN (%1) "
+                   "ORDER BY TABLE_NAME, INDEX_NAME, SEQ_IN_INDEX;")
+        .arg(in_list);
+  }
+  if (driverNameUpper == "QPSQL") {
+    return QString("SELECT tbl.relname AS table_name, "
+                   "idx.relname AS index_name, att.attname AS column_name, "
+                   "i.indisunique AS is_unique, i.indisprimary AS is_primary, "
+                   "am.amname AS index_type, "
+                   "array_position(i.indkey, att.attnum) AS column_seq "
+                   "FROM pg_index i "
+                   "JOIN pg_class tbl ON tbl.oid = i.indrelid "
+                   "JOIN pg_class idx ON idx.oid = i.indexrelid "
+                   "JOIN pg_attribute att ON att.attrelid = tbl.oid AND "
+                   "att.attnum = ANY(i.indkey) "
+                   "LEFT JOIN pg_am am ON am.oid = idx.relam "
+                   "WHERE tbl.relname IN (%1) AND tbl.relnamespace = "
+                   "(SELECT oid FROM pg_namespace "
+                   "WHERE nspname = current_schema()) "
+                   "ORDER BY table_name, index_name, column_seq;")
+        .arg(in_list);
+  }
+  if (driverNameUpper == "QSQLITE") {
+    // 只取显式 CREATE INDEX 的索引（origin = 'c'），与逐表内省一致
+    return QString("SELECT m.name AS table_name, il.name AS index_name, "
+                   "ii.name AS column_name, il.\"unique\" AS is_unique, "
+                   "0 AS is_primary, '' AS index_type "
+                   "FROM sqlite_master AS m "
+                   "JOIN pragma_index_list(m.name) AS il "
+                   "JOIN pragma_index_info(il.name) AS ii "
+                   "WHERE m.type = 'table' AND il.origin = 'c' "
+                   "AND m.name IN (%1) "
+                   "ORDER BY m.name, il.name, ii.seqno;")
+        .arg(in_list);
+  }
+  return QString();
+}
+
+bool execSnapshotQuery(QSqlQuery &query, const QString &sql,
+                       const std::vector<std::string> &tables) {
+  query.setForwardOnly(true);
+  if (!query.prepare(sql)) {
+    qWarning() << "loadSchemaSnapshot: Failed to prepare schema query:"
+               << query.lastError().text() << "SQL:" << sql;
+    return false;
+  }
+  for (const std::string &table : tables)
+    query.addBindValue(QString::fromStdString(table));
+  if (!query.exec()) {
+    qWarning() << "loadSchemaSnapshot: Schema query failed:"
+               << query.lastError().text() << "SQL:" << sql;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+std::optional<SchemaSnapshot>
+loadSchemaSnapshot(Session &session, const std::vector<std::string> &tables,
+                   const QString &driverNameUpper) {
+  SchemaSnapshot snapshot;
+  if (tables.empty())
+    return snapshot;
+
+  const QString in_list = inPlaceholders(tables.size());
+  const QString columns_sql = columnsSnapshotSql(driverNameUpper, in_list);
+  const QString indexes_sql = indexesSnapshotSql(driverNameUpper, in_list);
+  if (columns_sql.isEmpty() || indexes_sql.isEmpty())
+    return std::nullopt;
+
+  QSqlQuery query(session.getDbHandle());
+  if (!execSnapshotQuery(query, columns_sql, tables))
+    return std::nullopt;
+  while (query.next()) {
+    DbColumnInfo column = readDbColumnInfo(query, driverNameUpper);
+    if (column.name.empty())
+      continue;
+    const std::string table =
+        query.value("table_name").toString().toStdString();
+    snapshot.tables.insert(table);
+    snapshot.columns[table][column.name] = std::move(column);
+  }
+
+  QSqlQuery index_query(session.getDbHandle());
+  if (!execSnapshotQuery(index_query, indexes_sql, tables))
+    return std::nullopt;
+  while (index_query.next()) {
+    const std::string table =
+        index_query.value("table_name").toString().toStdString();
+    const std::string index_name =
+        index_query.value("index_name").toString().toStdString();
+    DbIndexInfo &index = snapshot.indexes[table][index_name];
+    if (index.index_name.empty()) {
+      index.index_name = index_name;
+      index.is_unique = index_query.value("is_unique").toBool();
+      index.is_primary_key = index_query.value("is_primary").toBool();
+      index.type_method =
+          index_query.value("index_type").toString().toStdString();
+    }
+    index.column_names.push_back(
+        index_query.value("column_name").toString().toStdString());
+  }
+  // 主键不作为普通索引管理
+  for (auto &[table, indexes] : snapshot.indexes) {
+    std::erase_if(indexes, [](const auto &entry) {
+      return entry.second.is_primary_key || entry.second.column_names.empty();
+    });
+  }
+  return snapshot;
+}
+
+} // namespace internal
+} // namespace cpporm
@@ -1,5 +1,13 @@
-// cpporm/session_migrate_utils.cpp (新文件 - 目前为空或只包含辅助声明)
+// cpporm/session_migrate_utils.cpp
 #include "cpporm/session_migrate_priv.h" // For DbColumnInfo, DbIndexInfo potentially if utils are complex
+#include "cpporm/session.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <algorithm>
 
 // This file can contain utility functions shared across migration operations.
 // For example:
@@ -26,5 +34,122 @@ const QString &driverNameUpper) {
 // If common patterns emerge during their full implementation, they can be
 // refactored here.
 
+namespace {
+
+// 迁移逻辑（类型映射、比对规则）变化时递增，使已记录的 hash 全部失效
+constexpr const char *kSchemaHashVersion = "cpporm-schema-v1";
+constexpr const char *kSchemaStateTable = "cpporm_schema_state";
+
+void addHashPart(QCryptographicHash &hash, const std::string &part) {
+  hash.addData(QByteArray(part.data(), static_cast<qsizetype>(part.size())));
+  hash.addData(QByteArray(1, '\0')); // 分隔符，避免相邻字段拼接歧义
+}
+
+std::vector<const ModelMeta *>
+sortedByTableName(const std::vector<const ModelMeta *> &metas) {
+  std::vector<const ModelMeta *> sorted;
+  sorted.reserve(metas.size());
+  for (const ModelMeta *meta : metas) {
+    if (meta)
+      sorted.push_back(meta);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const ModelMeta *a, const ModelMeta *b) {
+              return a->table_name < b->table_name;
+            });
+  return sorted;
+}
+
+} // namespace
+
+QString computeSchemaHash(const std::vector<const ModelMeta *> &metas,
+                          const QString &driverNameUpper) {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  addHashPart(hash, kSchemaHashVersion);
+  addHashPart(hash, driverNameUpper.toStdString());
+  for (const ModelMeta *meta : sortedByTableName(metas)) {
+    addHashPart(hash, "table");
+    addHashPart(hash, meta->table_name);
+    for (const auto &field : meta->fields) {
+      if (has_flag(field.flags, FieldFlag::Association) ||
+          field.db_name.empty())
+        continue;
+      addHashPart(hash, field.db_name);
+      addHashPart(hash, Session::getSqlTypeForCppType(field, driverNameUpper));
+      addHashPart(hash, std::to_string(static_cast<uint32_t>(field.flags)));
+    }
+    for (const auto &index : meta->indexes) {
+      addHashPart(hash, "index");
+      addHashPart(hash, index.index_name);
+      for (const auto &column : index.db_column_names)
+        addHashPart(hash, column);
+      addHashPart(hash, index.is_unique ? "unique" : "");
+      addHashPart(hash, index.type_str);
+      addHashPart(hash, index.condition_str);
+    }
+    for (const auto &assoc : meta->associations) {
+      if (assoc.type != AssociationType::BelongsTo)
+        continue;
+      addHashPart(hash, "fk");
+      addHashPart(hash, assoc.foreign_key_db_name);
+      addHashPart(hash, assoc.target_model_pk_db_name);
+    }
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+QString schemaStateKey(const std::vector<const ModelMeta *> &metas) {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  for (const ModelMeta *meta : sortedByTableName(metas))
+    addHashPart(hash, meta->table_name);
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+std::optional<QString> readStoredSchemaHash(Session &session,
+                                            const QString &state_key) {
+  QSqlQuery query(session.getDbHandle());
+  // 状态表不存在（首次迁移）时查询失败，视为没有记录
+  if (!query.prepare(QString("SELECT schema_hash FROM %1 WHERE state_key = ?;")
+                         .arg(kSchemaStateTable)))
+    return std::nullopt;
+  query.addBindValue(state_key);
+  if (!query.exec() || !query.next())
+    return std::nullopt;
+  return query.value(0).toString();
+}
+
+Error storeSchemaHash(Session &session, const QString &state_key,
+                      const QString &schema_hash) {
+  auto [_, create_err] = execute_ddl_query(
+      session.getDbHandle(),
+      QString("CREATE TABLE IF NOT EXISTS %1 ("
+              "state_key VARCHAR(64) NOT NULL PRIMARY KEY, "
+              "schema_hash VARCHAR(64) NOT NULL);")
+          .arg(kSchemaStateTable));
+  if (create_err)
+    return create_err;
+
+  QSqlQuery query(session.getDbHandle());
+  query.prepare(
+      QString("DELETE FROM %1 WHERE state_key = ?;").arg(kSchemaStateTable));
+  query.addBindValue(state_key);
+  if (!query.exec()) {
+    return Error(ErrorCode::QueryExecutionError,
+                 "storeSchemaHash: Failed to clear previous schema hash: " +
+                     query.lastError().text().toStdString());
+  }
+  query.prepare(
+      QString("INSERT INTO %1 (state_key, schema_hash) VALUES (?, ?);")
+          .arg(kSchemaStateTable));
+  query.addBindValue(state_key);
+  query.addBindValue(schema_hash);
+  if (!query.exec()) {
+    return Error(ErrorCode::QueryExecutionError,
+                 "storeSchemaHash: Failed to record schema hash: " +
+                     query.lastError().text().toStdString());
+  }
+  return make_ok();
+}
+
 } // namespace internal
 } // namespace cpporm
\ No newline at end of file
@@ -0,0 +1,113 @@
+// cpporm/session_model_cache.cpp
+#include "cpporm/model_cache.h"
+#include "cpporm/query_builder.h"
+#include "cpporm/session.h"
+
+#include <QVariantList>
+#include <algorithm>
+
+namespace cpporm {
+
+void Session::EnableIdentityMap(bool enabled) {
+  identity_map_enabled_ = enabled;
+  if (!enabled)
+    identity_map_.clear();
+}
+
+void Session::InvalidateCache(const ModelMeta &meta) {
+  invalidateCachedTable(meta.table_name);
+}
+
+const QString &Session::cacheScope() {
+  if (cache_scope_.isEmpty()) {
+    cache_scope_ = QString("%1://%2@%3:%4/%5")
+                       .arg(db_handle_.driverName(), db_handle_.userName(),
+                            db_handle_.hostName(),
+                            QString::number(db_handle_.port()),
+                            db_handle_.databaseName());
+    // SQLite 的 :memory: 与空文件名（临时库）每个连接各是一个独立的库，
+    // 只靠库名会让不同连接共用缓存条目，因此再加上连接名区分
+    if (db_handle_.driverName().toUpper() == "QSQLITE") {
+      const QString database = db_handle_.databaseName();
+      if (database.isEmpty() || database == ":memory:")
+        cache_scope_ += "#" + db_handle_.connectionName();
+    }
+  }
+  return cache_scope_;
+}
+
+std::optional<internal::ModelCacheKey>
+Session::modelCacheKeyFor(const ModelMeta &meta,
+                          const std::vector<QueryValue> &pk_values) {
+  if (!identity_map_enabled_ && !internal::ModelCache::instance().enabled())
+    return std::nullopt;
+  if (meta.primary_keys_db_names.empty() ||
+      pk_values.size() != meta.primary_keys_db_names.size())
+    return std::nullopt;
+
+  internal::ModelCacheKey key;
+  key.meta = &meta;
+  key.primary_key.reserve(pk_values.size());
+  for (const QueryValue &value : pk_values) {
+    QVariantList subquery_bindings;
+    const QVariant variant = QueryBuilder::toQVariant(value, subquery_bindings);
+    if (!subquery_bindings.isEmpty())
+      return std::nullopt; // 子查询等非字面量主键
+    std::optional<internal::PreloadKey> normalized =
+        internal::makePreloadKeyFromVariant(variant);
+    if (!normalized)
+      return std::nullopt;
+    key.primary_key.push_back(std::move(*normalized));
+  }
+  key.scope = cacheScope();
+  return key;
+}
+
+std::shared_ptr<const ModelBase>
+Session::lookupCachedModel(const internal::ModelCacheKey &key) {
+  if (identity_map_enabled_) {
+    auto it = identity_map_.find(key);
+    if (it != identity_map_.end())
+      return it->second;
+  }
+  std::shared_ptr<const ModelBase> cached =
+      internal::ModelCache::instance().lookup(key);
+  if (cached && identity_map_enabled_)
+    identity_map_.emplace(key, cached);
+  return cached;
+}
+
+void Session::storeCachedModel(const internal::ModelCacheKey &key,
+                               std::shared_ptr<const ModelBase> model,
+                               uint64_t generation) {
+  if (identity_map_enabled_)
+    identity_map_[key] = model;
+  // 事务内读到的行可能尚未提交（或随后回滚），不进入进程级缓存
+  if (!is_explicit_transaction_handle_)
+    internal::ModelCache::instance().store(key, std::move(model), generation);
+}
+
+void Session::invalidateCachedTable(const std::string &table_name) {
+  if (table_name.empty())
+    return;
+  internal::ModelCache::instance().invalidateTable(cacheScope(), table_name);
+  if (is_explicit_transaction_handle_ &&
+      std::find(tx_written_tables_.begin(), tx_written_tables_.end(),
+                table_name) == tx_written_tables_.end())
+    tx_written_tables_.push_back(table_name);
+  std::erase_if(identity_map_, [&](const auto &entry) {
+    return entry.first.meta->table_name == table_name;
+  });
+}
+
+void Session::invalidateCachedTable(const QueryBuilder &qb) {
+  const FromClauseSource &source = qb.getFromClauseSource();
+  if (const auto *from_name = std::get_if<std::string>(&source);
+      from_name && !from_name->empty()) {
+    invalidateCachedTable(*from_name);
+  } else if (const ModelMeta *meta = qb.getModelMeta()) {
+    invalidateCachedTable(meta->table_name);
+  }
+}
+
+} // namespace cpporm
@@ -1,61 +1,75 @@
 // cpporm/session_preload_utils.cpp
+#include "cpporm/adaptive_batch_sizer.h"
 #include "cpporm/i_query_executor.h"
 #include "cpporm/model_base.h"
+#include "cpporm/preload_key.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h"
+#include "cpporm/row_mapper.h"
 #include "cpporm/session.h"
 
 #include <QDebug>
+#include <QSqlQuery>
+#include <QSqlRecord>
 #include <algorithm>
 #include <any>
-#include <map>
+#include <chrono>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
-#include <set>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace cpporm {
 
-static std::string
-any_to_string_for_map_key_in_preload_util(const std::any &val) {
-  if (!val.has_value())
-    return "__cpporm_NULL_KEY__";
-
-  const auto &type = val.type();
-  if (type == typeid(int))
-    return "i_" + std::to_string(std::any_cast<int>(val));
-  if (type == typeid(long long))
-    return "ll_" + std::to_string(std::any_cast<long long>(val));
-  if (type == typeid(unsigned int))
-    return "ui_" + std::to_string(std::any_cast<unsigned int>(val));
-  if (type == typeid(unsigned long long))
-    return "ull_" + std::to_string(std::any_cast<unsigned long long>(val));
-  if (type == typeid(std::string))
-    return "s_" + std::any_cast<std::string>(val);
-  if (type == typeid(const char *))
-    return "s_" + std::string(std::any_cast<const char *>(val));
-  if (type == typeid(QDateTime))
-    return "dt_" + std::any_cast<QDateTime>(val)
-                       .toUTC()
-                       .toString(Qt::ISODateWithMs)
-                       .toStdString();
-  if (type == typeid(QDate))
-    return "d_" + std::any_cast<QDate>(val).toString(Qt::ISODate).toStdString();
-  if (type == typeid(bool))
-    return "b_" + std::string(std::any_cast<bool>(val) ? "true" : "false");
-  if (type == typeid(double))
-    return "dbl_" + std::to_string(std::any_cast<double>(val));
-  if (type == typeid(float))
-    return "flt_" + std::to_string(std::any_cast<float>(val));
-
-  qWarning()
-      << "any_to_string_for_map_key_in_preload_util: Unsupported std::any type "
-      << " ('" << val.type().name()
-      << "') for map key generation during preload. ";
-  return "__cpporm_UNSUPPORTED_KEY_TYPE_" + std::string(val.type().name()) +
-         "__";
+namespace {
+
+// 预加载路径树：Preload("Orders") 与 Preload("Orders.Items") 共享
+// Orders 节点，同一关联在同一层只加载一次。
+struct PreloadPathNode {
+  std::string association_name;
+  std::vector<PreloadPathNode> children;
+};
+
+void addPreloadPath(std::vector<PreloadPathNode> &roots,
+                    const std::string &path) {
+  std::vector<PreloadPathNode> *level = &roots;
+  size_t segment_begin = 0;
+  while (segment_begin < path.size()) {
+    const size_t dot = path.find('.', segment_begin);
+    const size_t segment_end = dot == std::string::npos ? path.size() : dot;
+    const std::string segment =
+        path.substr(segment_begin, segment_end - segment_begin);
+    if (segment.empty())
+      break;
+    auto it = std::find_if(level->begin(), level->end(),
+                           [&segment](const PreloadPathNode &node) {
+                             return node.association_name == segment;
+                           });
+    if (it == level->end()) {
+      level->push_back(PreloadPathNode{segment, {}});
+      it = std::prev(level->end());
+    }
+    level = &it->children;
+    segment_begin = segment_end + 1;
+  }
+}
+
+std::string inClausePlaceholders(size_t count) {
+  std::string placeholders;
+  placeholders.reserve(count * 3);
+  for (size_t i = 0; i < count; ++i) {
+    placeholders += (i == 0 ? "?" : ", ?");
+  }
+  return placeholders;
 }
 
+} // namespace
+
 Error Session::processPreloadsInternal(
     const QueryBuilder &qb, std::vector<ModelBase *> &parent_models_raw_ptr) {
   const std::vector<PreloadRequest> &preload_requests = qb.getPreloadRequests();
@@ -72,39 +86,65 @@ Error Session::processPreloadsInternal(
     return make_ok();
   }
 
+  std::vector<PreloadPathNode> preload_tree;
   for (const auto &request : preload_requests) {
-    std::string association_to_load = request.association_cpp_field_name;
-    if (association_to_load.find('.') != std::string::npos) {
-      qWarning() << "Session::processPreloadsInternal: Nested preload paths "
-                    "(e.g., 'Orders.Items') are not yet fully supported. "
-                 << "Preloading only the first part of: '"
-                 << QString::fromStdString(association_to_load) << "'";
-      association_to_load =
-          association_to_load.substr(0, association_to_load.find('.'));
-    }
+    addPreloadPath(preload_tree, request.association_cpp_field_name);
+  }
 
-    const AssociationMeta *assoc_meta =
-        main_model_meta.findAssociationByCppName(association_to_load);
-    if (!assoc_meta) {
-      qWarning() << "Session::processPreloadsInternal: Association '"
-                 << QString::fromStdString(association_to_load)
-                 << "' not found in model '"
-                 << QString::fromStdString(main_model_meta.table_name)
-                 << "' for preloading.";
-      continue;
-    }
+  // 逐层加载：每个关联一次（按 IN 上限分块的）查询，下一层以本层加载到的
+  // 全部模型为父集合。
+  std::function<Error(const ModelMeta &, std::vector<ModelBase *> &,
+                      const std::vector<PreloadPathNode> &,
+                      const std::string &)>
+      preload_level;
+  preload_level = [this, &preload_level](
+                      const ModelMeta &level_meta,
+                      std::vector<ModelBase *> &level_parents,
+                      const std::vector<PreloadPathNode> &nodes,
+                      const std::string &path_prefix) -> Error {
+    for (const PreloadPathNode &node : nodes) {
+      const std::string path = path_prefix.empty()
+                                   ? node.association_name
+                                   : path_prefix + "." + node.association_name;
+      const AssociationMeta *assoc_meta =
+          level_meta.findAssociationByCppName(node.association_name);
+      if (!assoc_meta) {
+        qWarning() << "Session::processPreloadsInternal: Association '"
+                   << QString::fromStdString(path) << "' not found in model '"
+                   << QString::fromStdString(level_meta.table_name)
+                   << "' for preloading.";
+        continue;
+      }
+
+      std::vector<std::shared_ptr<ModelBase>> loaded_models;
+      Error err = executePreloadForAssociation(
+          *assoc_meta, level_meta, level_parents,
+          node.children.empty() ? nullptr : &loaded_models);
+      if (err) {
+        qWarning() << "Session::processPreloadsInternal: Error preloading "
+                      "association '"
+                   << QString::fromStdString(path)
+                   << "': " << QString::fromStdString(err.toString());
+        return err;
+      }
+      if (node.children.empty() || loaded_models.empty())
+        continue;
 
-    Error err = executePreloadForAssociation(*assoc_meta, main_model_meta,
-                                             parent_models_raw_ptr);
-    if (err) {
-      qWarning() << "Session::processPreloadsInternal: Error preloading "
-                    "association '"
-                 << QString::fromStdString(association_to_load)
-                 << "': " << QString::fromStdString(err.toString());
-      return err;
+      std::vector<ModelBase *> next_parents;
+      next_parents.reserve(loaded_models.size());
+      for (const auto &model : loaded_models) {
+        next_parents.push_back(model.get());
+      }
+      err = preload_level(loaded_models.front()->_getOwnModelMeta(),
+                          next_parents, node.children, path);
+      if (err)
+        return err;
     }
-  }
-  return make_ok();
+    return make_ok();
+  };
+
+  return preload_level(main_model_meta, parent_models_raw_ptr, preload_tree,
+                       "");
 }
 
 Error Session::processPreloads(
@@ -128,7 +168,8 @@ Error Session::processPreloads(
 
 Error Session::executePreloadForAssociation(
     const AssociationMeta &assoc_meta, const ModelMeta &parent_model_meta,
-    std::vector<ModelBase *> &parent_models_raw_ptr) {
+    std::vector<ModelBase *> &parent_models_raw_ptr,
+    std::vector<std::shared_ptr<ModelBase>> *loaded_models_out) {
 
   if (parent_models_raw_ptr.empty()) {
     return make_ok();
@@ -172,7 +213,9 @@ Error Session::executePreloadForAssociation(
   std::string target_model_key_db_name;
 
   if (assoc_meta.type == AssociationType::HasMany ||
-      assoc_meta.type == AssociationType::HasOne) {
+      assoc_meta.type == AssociationType::HasOne ||
+      assoc_meta.type == AssociationType::ManyToMany) {
+    // ManyToMany 的 foreign_key_db_name 是连接表中指向父模型的列
     const FieldMeta *pk_field_on_parent = nullptr;
     if (!assoc_meta.primary_key_db_name_on_current_model.empty()) {
       pk_field_on_parent = parent_model_meta.findFieldByDbName(
@@ -236,10 +279,6 @@ Error Session::executePreloadForAssociation(
                    "not specified or determinable for association '" +
                        assoc_meta.cpp_field_name + "'.");
     }
-  } else if (assoc_meta.type == AssociationType::ManyToMany) {
-    return Error(ErrorCode::UnsupportedFeature,
-                 "Preload Error: ManyToMany preloading for association '" +
-                     assoc_meta.cpp_field_name + "' is not yet implemented.");
   } else {
     return Error(ErrorCode::InternalError,
                  "Preload Error: Unknown association type for '" +
@@ -255,77 +294,114 @@ Error Session::executePreloadForAssociation(
                      target_model_key_db_name + "'.");
   }
 
-  std::vector<QueryValue> parent_key_values_for_in_clause;
-  parent_key_values_for_in_clause.reserve(parent_models_raw_ptr.size());
+  // 每个父模型的连接键只取一次；去重后的键即 IN 列表的参数
+  std::vector<std::optional<internal::PreloadKey>> parent_keys;
+  parent_keys.reserve(parent_models_raw_ptr.size());
+  std::unordered_set<internal::PreloadKey, internal::PreloadKeyHash>
+      seen_parent_keys;
+  std::vector<QueryValue> unique_key_values;
   for (const auto parent_model_ptr : parent_models_raw_ptr) {
-    if (parent_model_ptr) {
-      std::any key_any =
-          parent_model_ptr->getFieldValue(parent_model_key_cpp_name);
-      if (key_any.has_value()) {
-        QueryValue qv = Session::anyToQueryValueForSessionConvenience(key_any);
-        if (std::holds_alternative<std::nullptr_t>(qv) && key_any.has_value()) {
-          qWarning() << "Preload Warning: Unsupported parent key type ('"
-                     << key_any.type().name()
-                     << "') for IN clause when preloading '"
-                     << QString::fromStdString(assoc_meta.cpp_field_name)
-                     << "'. Skipping key value.";
-          continue;
-        }
-        if (!std::holds_alternative<std::nullptr_t>(qv)) {
-          parent_key_values_for_in_clause.push_back(qv);
-        }
-      }
+    if (!parent_model_ptr) {
+      parent_keys.emplace_back();
+      continue;
+    }
+    std::any key_any =
+        parent_model_ptr->getFieldValue(parent_model_key_cpp_name);
+    parent_keys.push_back(internal::makePreloadKey(key_any));
+    if (!parent_keys.back() ||
+        !seen_parent_keys.insert(*parent_keys.back()).second)
+      continue;
+    QueryValue qv = Session::anyToQueryValueForSessionConvenience(key_any);
+    if (std::holds_alternative<std::nullptr_t>(qv)) {
+      qWarning() << "Preload Warning: Unsupported parent key type ('"
+                 << key_any.type().name()
+                 << "') for IN clause when preloading '"
+                 << QString::fromStdString(assoc_meta.cpp_field_name)
+                 << "'. Skipping key value.";
+      continue;
     }
+    unique_key_values.push_back(std::move(qv));
   }
 
-  if (parent_key_values_for_in_clause.empty()) {
+  if (unique_key_values.empty()) {
     return make_ok();
   }
 
-  QueryBuilder qb_preload(this, this->connection_name_, &target_model_meta);
-
-  std::string quoted_target_key_db_name =
-      QueryBuilder::quoteSqlIdentifier(target_model_key_db_name);
-  if (parent_key_values_for_in_clause.empty()) {
-    return make_ok();
+  internal::PreloadBuckets associated_by_link_key;
+  associated_by_link_key.reserve(unique_key_values.size());
+  Error fetch_err =
+      assoc_meta.type == AssociationType::ManyToMany
+          ? fetchManyToManyPreload(assoc_meta, target_model_meta,
+                                   target_model_factory_fn, unique_key_values,
+                                   associated_by_link_key)
+          : fetchDirectPreload(assoc_meta, target_model_meta,
+                               target_model_key_db_name,
+                               target_model_factory_fn, unique_key_values,
+                               associated_by_link_key);
+  if (fetch_err) {
+    return fetch_err;
   }
-  std::string in_placeholders_sql_segment;
-  for (size_t i = 0; i < parent_key_values_for_in_clause.size(); ++i) {
-    in_placeholders_sql_segment += (i == 0 ? "?" : ", ?");
-  }
-  qb_preload.Where(quoted_target_key_db_name + " IN (" +
-                       in_placeholders_sql_segment + ")",
-                   parent_key_values_for_in_clause);
-
-  std::vector<std::unique_ptr<ModelBase>>
-      associated_results_unique_ptr_vec; // Correct type for FindImpl
-  Error find_err = this->FindImpl(qb_preload, associated_results_unique_ptr_vec,
-                                  target_model_factory_fn);
-
-  if (find_err) {
-    return Error(find_err.code,
-                 "Preload Error: Failed to fetch associated models for '" +
-                     assoc_meta.cpp_field_name + "' from table '" +
-                     target_model_meta.table_name + "': " + find_err.message);
+
+  if (loaded_models_out) {
+    // ManyToMany 中同一目标可能挂在多个父模型下，只输出一次
+    std::unordered_set<const ModelBase *> seen_loaded;
+    for (const auto &bucket : associated_by_link_key) {
+      for (const auto &model : bucket.second) {
+        if (seen_loaded.insert(model.get()).second)
+          loaded_models_out->push_back(model);
+      }
+    }
   }
 
-  if (associated_results_unique_ptr_vec.empty()) {
-    for (auto parent_model_ptr : parent_models_raw_ptr) {
-      if (!parent_model_ptr)
-        continue;
-      if (assoc_meta.type == AssociationType::HasMany &&
-          assoc_meta.data_setter_vector) {
-        std::vector<std::shared_ptr<ModelBase>> empty_vec;
-        assoc_meta.data_setter_vector(parent_model_ptr, empty_vec);
-      } else if ((assoc_meta.type == AssociationType::HasOne ||
-                  assoc_meta.type == AssociationType::BelongsTo) &&
-                 assoc_meta.data_setter_single) {
-        assoc_meta.data_setter_single(parent_model_ptr, nullptr);
+  std::vector<std::shared_ptr<ModelBase>> no_associated_models;
+  for (size_t i = 0; i < parent_models_raw_ptr.size(); ++i) {
+    ModelBase *parent_model_ptr = parent_models_raw_ptr[i];
+    if (!parent_model_ptr)
+      continue;
+    std::vector<std::shared_ptr<ModelBase>> *associated_for_this_parent =
+        &no_associated_models;
+    if (parent_keys[i]) {
+      auto it_found = associated_by_link_key.find(*parent_keys[i]);
+      if (it_found != associated_by_link_key.end())
+        associated_for_this_parent = &it_found->second;
+    }
+
+    if (assoc_meta.type == AssociationType::HasMany ||
+        assoc_meta.type == AssociationType::ManyToMany) {
+      if (assoc_meta.data_setter_vector) {
+        assoc_meta.data_setter_vector(parent_model_ptr,
+                                      *associated_for_this_parent);
+      } else {
+        qWarning() << "Preload: Missing vector setter for HasMany/ManyToMany "
+                      "association "
+                   << QString::fromStdString(assoc_meta.cpp_field_name)
+                   << " on parent "
+                   << QString::fromStdString(parent_model_meta.table_name);
       }
+    } else if (assoc_meta.data_setter_single) { // HasOne / BelongsTo
+      assoc_meta.data_setter_single(
+          parent_model_ptr, associated_for_this_parent->empty()
+                                ? nullptr
+                                : associated_for_this_parent->front());
+    } else {
+      qWarning() << "Preload: Missing single setter for HasOne/BelongsTo "
+                    "association "
+                 << QString::fromStdString(assoc_meta.cpp_field_name)
+                 << " on parent "
+                 << QString::fromStdString(parent_model_meta.table_name);
     }
-    return make_ok();
   }
+  return make_ok();
+}
 
+// HasMany/HasOne/BelongsTo：SELECT ... FROM target WHERE link_key IN (...)，
+// 结果按子模型自身的连接键分桶。
+Error Session::fetchDirectPreload(
+    const AssociationMeta &assoc_meta, const ModelMeta &target_model_meta,
+    const std::string &target_model_key_db_name,
+    const internal::ModelFactory &target_model_factory_fn,
+    const std::vector<QueryValue> &unique_key_values,
+    internal::PreloadBuckets &associated_by_link_key) {
   const FieldMeta *target_model_key_field_meta =
       target_model_meta.findFieldByDbName(target_model_key_db_name);
   if (!target_model_key_field_meta) {
@@ -336,98 +412,220 @@ Error Session::executePreloadForAssociation(
                      target_model_meta.table_name + "'. Cannot map results.");
   }
 
-  std::map<std::string, std::vector<std::shared_ptr<ModelBase>>>
-      map_associated_by_their_link_key_value;
-  for (auto &assoc_model_uptr : associated_results_unique_ptr_vec) {
-    if (assoc_model_uptr) {
-      std::any link_key_val_any = assoc_model_uptr->getFieldValue(
-          target_model_key_field_meta->cpp_name);
-      std::string link_key_val_str_key =
-          any_to_string_for_map_key_in_preload_util(link_key_val_any);
-
-      if (link_key_val_str_key.rfind("__cpporm_UNSUPPORTED_KEY_TYPE_", 0) ==
-              0 ||
-          link_key_val_str_key == "__cpporm_NULL_KEY__") {
-        // Corrected variable name: assoc_model_uptr is the current item.
-        const ModelMeta &t_assoc_meta =
-            assoc_model_uptr->_getOwnModelMeta(); // Was current_assoc_meta
-        const FieldMeta *current_assoc_pk_field =
-            t_assoc_meta.getPrimaryField(); // Use t_assoc_meta
-        std::string current_assoc_pk_val_str = "N/A_PK_FIELD";
-        if (current_assoc_pk_field) {
-          current_assoc_pk_val_str = any_to_string_for_map_key_in_preload_util(
-              assoc_model_uptr->getFieldValue(
-                  current_assoc_pk_field->cpp_name));
-        }
+  // IN 列表按驱动的占位符上限分块，块大小随查询耗时自适应
+  const std::string in_clause_prefix =
+      QueryBuilder::quoteSqlIdentifier(target_model_key_db_name) + " IN (";
+  internal::AdaptiveBatchSizer chunk_sizer(db_handle_.driverName().toUpper(),
+                                           1);
+
+  size_t chunk_begin = 0;
+  while (chunk_begin < unique_key_values.size()) {
+    const size_t chunk_end =
+        std::min(unique_key_values.size(),
+                 chunk_begin + chunk_sizer.nextBatchSize());
+    std::vector<QueryValue> chunk_values(
+        unique_key_values.begin() + chunk_begin,
+        unique_key_values.begin() + chunk_end);
+
+    QueryBuilder qb_preload(this, this->connection_name_, &target_model_meta);
+    qb_preload.Where(in_clause_prefix +
+                         inClausePlaceholders(chunk_values.size()) + ")",
+                     chunk_values);
+
+    std::vector<std::unique_ptr<ModelBase>> chunk_results;
+    const auto chunk_started_at = std::chrono::steady_clock::now();
+    Error find_err =
+        this->FindImpl(qb_preload, chunk_results, target_model_factory_fn);
+    if (find_err) {
+      return Error(find_err.code,
+                   "Preload Error: Failed to fetch associated models for '" +
+                       assoc_meta.cpp_field_name + "' from table '" +
+                       target_model_meta.table_name + "': " +
+                       find_err.message);
+    }
+    chunk_sizer.recordBatch(chunk_values.size(),
+                            std::chrono::steady_clock::now() -
+                                chunk_started_at);
 
-        qWarning() << "Preload Warning: Could not get or convert foreign key "
-                      "value to string for mapping associated model for "
+    for (auto &assoc_model_uptr : chunk_results) {
+      if (!assoc_model_uptr)
+        continue;
+      std::optional<internal::PreloadKey> link_key =
+          internal::makePreloadKey(assoc_model_uptr->getFieldValue(
+              target_model_key_field_meta->cpp_name));
+      if (!link_key) {
+        qWarning() << "Preload Warning: Associated model for"
                    << QString::fromStdString(assoc_meta.cpp_field_name)
-                   << ". Target model PK (if available): "
-                   << QString::fromStdString(current_assoc_pk_val_str);
+                   << "has a NULL or unsupported link key"
+                   << QString::fromStdString(target_model_key_db_name)
+                   << "; skipping it.";
         continue;
       }
-      map_associated_by_their_link_key_value[link_key_val_str_key].push_back(
-          std::move(assoc_model_uptr));
+      associated_by_link_key[*link_key].push_back(std::move(assoc_model_uptr));
     }
+    chunk_begin = chunk_end;
   }
-  associated_results_unique_ptr_vec.clear();
+  return make_ok();
+}
 
-  for (auto parent_model_ptr : parent_models_raw_ptr) {
-    if (!parent_model_ptr)
+// ManyToMany：每块一条 JOIN 查询
+//   SELECT target.*, jt.owner_fk AS owner FROM target
+//   INNER JOIN jt ON jt.target_fk = target.ref WHERE jt.owner_fk IN (...)
+// 结果按连接表中的父键分桶；同一目标被多个父模型引用时只实例化一次。
+Error Session::fetchManyToManyPreload(
+    const AssociationMeta &assoc_meta, const ModelMeta &target_model_meta,
+    const internal::ModelFactory &target_model_factory_fn,
+    const std::vector<QueryValue> &unique_key_values,
+    internal::PreloadBuckets &associated_by_link_key) {
+  static const std::string kOwnerKeyAlias = "cpporm_preload_owner_key";
+
+  const std::string &join_table = assoc_meta.join_table_name;
+  const std::string &join_owner_column = assoc_meta.foreign_key_db_name;
+  const std::string &join_target_column =
+      assoc_meta.join_table_target_key_db_name;
+  if (join_table.empty() || join_owner_column.empty() ||
+      join_target_column.empty()) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "Preload Error (ManyToMany): Join table or its key columns "
+                 "not specified for association '" +
+                     assoc_meta.cpp_field_name + "'.");
+  }
+  const std::string target_ref_db_name =
+      !assoc_meta.target_model_pk_db_name.empty()
+          ? assoc_meta.target_model_pk_db_name
+          : (target_model_meta.primary_keys_db_names.empty()
+                 ? std::string()
+                 : target_model_meta.primary_keys_db_names[0]);
+  const FieldMeta *target_ref_field =
+      target_model_meta.findFieldByDbName(target_ref_db_name);
+  if (!target_ref_field) {
+    return Error(ErrorCode::MappingError,
+                 "Preload Error (ManyToMany): Referenced key '" +
+                     target_ref_db_name + "' not found on target model '" +
+                     target_model_meta.table_name + "' for association '" +
+                     assoc_meta.cpp_field_name + "'.");
+  }
+
+  // 目标列全部带表名限定，避免与连接表中的同名列冲突
+  std::vector<std::string> select_list;
+  for (const auto &field : target_model_meta.fields) {
+    if (has_flag(field.flags, FieldFlag::Association) || field.db_name.empty())
       continue;
-    std::any parent_key_val_any =
-        parent_model_ptr->getFieldValue(parent_model_key_cpp_name);
-    std::string parent_key_val_str_key =
-        any_to_string_for_map_key_in_preload_util(parent_key_val_any);
-
-    auto it_found_associated =
-        map_associated_by_their_link_key_value.find(parent_key_val_str_key);
-
-    if (it_found_associated != map_associated_by_their_link_key_value.end()) {
-      std::vector<std::shared_ptr<ModelBase>>
-          &associated_for_this_parent_sptrs = it_found_associated->second;
-      if (assoc_meta.type == AssociationType::HasMany) {
-        if (assoc_meta.data_setter_vector) {
-          assoc_meta.data_setter_vector(parent_model_ptr,
-                                        associated_for_this_parent_sptrs);
-        } else {
-          qWarning()
-              << "Preload: Missing vector setter for HasMany association "
-              << QString::fromStdString(assoc_meta.cpp_field_name)
-              << " on parent "
-              << QString::fromStdString(parent_model_meta.table_name);
-        }
-      } else if (assoc_meta.type == AssociationType::HasOne ||
-                 assoc_meta.type == AssociationType::BelongsTo) {
-        if (assoc_meta.data_setter_single) {
-          if (!associated_for_this_parent_sptrs.empty()) {
-            assoc_meta.data_setter_single(
-                parent_model_ptr, associated_for_this_parent_sptrs.front());
-          } else {
-            assoc_meta.data_setter_single(parent_model_ptr, nullptr);
-          }
-        } else {
-          qWarning() << "Preload: Missing single setter for HasOne/BelongsTo "
-                        "association "
-                     << QString::fromStdString(assoc_meta.cpp_field_name)
-                     << " on parent "
-                     << QString::fromStdString(parent_model_meta.table_name);
+    select_list.push_back(QueryBuilder::quoteSqlIdentifier(
+        target_model_meta.table_name + "." + field.db_name));
+  }
+  select_list.push_back(
+      QueryBuilder::quoteSqlIdentifier(join_table + "." + join_owner_column) +
+      " AS " + QueryBuilder::quoteSqlIdentifier(kOwnerKeyAlias));
+  const std::string join_on =
+      QueryBuilder::quoteSqlIdentifier(join_table + "." + join_target_column) +
+      " = " +
+      QueryBuilder::quoteSqlIdentifier(target_model_meta.table_name + "." +
+                                       target_ref_db_name);
+  const std::string in_clause_prefix =
+      QueryBuilder::quoteSqlIdentifier(join_table + "." + join_owner_column) +
+      " IN (";
+
+  std::unordered_map<internal::PreloadKey, std::shared_ptr<ModelBase>,
+                     internal::PreloadKeyHash>
+      targets_by_key;
+  internal::AdaptiveBatchSizer chunk_sizer(db_handle_.driverName().toUpper(),
+                                           1);
+
+  size_t chunk_begin = 0;
+  while (chunk_begin < unique_key_values.size()) {
+    const size_t chunk_end =
+        std::min(unique_key_values.size(),
+                 chunk_begin + chunk_sizer.nextBatchSize());
+    std::vector<QueryValue> chunk_values(
+        unique_key_values.begin() + chunk_begin,
+        unique_key_values.begin() + chunk_end);
+
+    QueryBuilder qb_preload(this, this->connection_name_, &target_model_meta);
+    qb_preload.Select(select_list)
+        .InnerJoin(join_table, join_on)
+        .Where(in_clause_prefix + inClausePlaceholders(chunk_values.size()) +
+                   ")",
+               chunk_values);
+    auto [sql, params] = qb_preload.buildSelectSQL();
+    if (sql.isEmpty()) {
+      return Error(ErrorCode::StatementPreparationError,
+                   "Preload Error (ManyToMany): Failed to build SQL for '" +
+                       assoc_meta.cpp_field_name + "'.");
+    }
+
+    const auto chunk_started_at = std::chrono::steady_clock::now();
+    internal::StatementTimings timings;
+    auto [statement, exec_err] = execute_query_internal(
+        this->db_handle_, sql, params, /*forward_only=*/false, &timings);
+    QSqlQuery &query = *statement;
+    if (exec_err) {
+      return Error(exec_err.code,
+                   "Preload Error: Failed to fetch associated models for '" +
+                       assoc_meta.cpp_field_name + "' from table '" +
+                       target_model_meta.table_name + "': " +
+                       exec_err.message);
+    }
+
+    internal::StatementProfile profile(connection_name_, sql, timings);
+    const QSqlRecord record = query.record();
+    const int owner_key_index =
+        record.indexOf(QString::fromStdString(kOwnerKeyAlias));
+    if (owner_key_index < 0) {
+      return Error(ErrorCode::MappingError,
+                   "Preload Error (ManyToMany): Owner key column missing from "
+                   "result set for '" +
+                       assoc_meta.cpp_field_name + "'.");
+    }
+    const internal::RowMapper row_mapper(target_model_meta, record);
+    while (query.next()) {
+      std::optional<internal::PreloadKey> owner_key =
+          internal::makePreloadKeyFromVariant(query.value(owner_key_index));
+      if (!owner_key)
+        continue;
+      const auto map_started = profile.beginRow();
+      std::unique_ptr<ModelBase> target_model = target_model_factory_fn();
+      if (!target_model) {
+        return Error(ErrorCode::InternalError,
+                     "Preload Error (ManyToMany): Target model factory "
+                     "returned nullptr.");
+      }
+      row_mapper.mapRow(query, *target_model);
+
+      std::shared_ptr<ModelBase> *shared_target = nullptr;
+      std::shared_ptr<ModelBase> unkeyed_target;
+      std::optional<internal::PreloadKey> target_key =
+          internal::makePreloadKey(
+              target_model->getFieldValue(target_ref_field->cpp_name));
+      if (target_key) {
+        auto [it, inserted] = targets_by_key.try_emplace(*target_key);
+        if (!inserted) {
+          associated_by_link_key[*owner_key].push_back(it->second);
+          profile.endRow(map_started);
+          continue;
         }
+        shared_target = &it->second;
+      } else {
+        shared_target = &unkeyed_target;
       }
-    } else {
-      if (assoc_meta.type == AssociationType::HasMany &&
-          assoc_meta.data_setter_vector) {
-        std::vector<std::shared_ptr<ModelBase>> empty_sptr_vec;
-        assoc_meta.data_setter_vector(parent_model_ptr, empty_sptr_vec);
-      } else if ((assoc_meta.type == AssociationType::HasOne ||
-                  assoc_meta.type == AssociationType::BelongsTo) &&
-                 assoc_meta.data_setter_single) {
-        assoc_meta.data_setter_single(parent_model_ptr, nullptr);
+      Error hook_err = target_model->afterFind(*this);
+      if (hook_err) {
+        qWarning() << "cpporm Session::fetchManyToManyPreload: afterFind "
+                      "hook failed for an element: "
+                   << hook_err.toString().c_str();
       }
+      *shared_target = std::move(target_model);
+      associated_by_link_key[*owner_key].push_back(*shared_target);
+      profile.endRow(map_started);
     }
+    profile.endFetch();
+    query.finish();
+    chunk_sizer.recordBatch(chunk_values.size(),
+                            std::chrono::steady_clock::now() -
+                                chunk_started_at);
+    chunk_begin = chunk_end;
   }
   return make_ok();
 }
 
-} // namespace cpporm
\ No newline at end of file
+} // namespace cpporm
@@ -1,5 +1,6 @@
 // cpporm/session_raw_ops.cpp
 #include "cpporm/error.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/session.h"
 
 #include <QDebug>    // For qWarning
@@ -18,8 +19,9 @@ std::expected<long long, Error> Session::ExecRaw(const QString &sql,
   }
   // `execute_query_internal` is a static private helper method of Session,
   // defined in session.cpp
-  auto [query_obj, exec_err] =
+  auto [statement, exec_err] =
       execute_query_internal(this->db_handle_, sql, args);
+  QSqlQuery &query_obj = *statement;
 
   if (exec_err) {
     qWarning() << "Session::ExecRaw: Execution failed for SQL:" << sql
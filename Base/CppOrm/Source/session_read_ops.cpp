@@ -1,6 +1,8 @@
 // cpporm/session_read_ops.cpp
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h"
+#include "cpporm/row_mapper.h"
 #include "cpporm/session.h"
 // #include "cpporm/qt_db_manager.h" // 通常不需要
 
@@ -9,6 +11,7 @@
 #include <QSqlRecord>
 #include <QVariant>
 #include <algorithm>
+#include <limits>
 
 namespace cpporm {
 
@@ -33,21 +36,29 @@ Error Session::FirstImpl(const QueryBuilder &qb, ModelBase &result_model) {
                  "Failed to build SQL for First operation.");
   }
 
-  auto [query, exec_err] =
-      execute_query_internal(this->db_handle_, sql, params);
+  internal::StatementTimings timings;
+  auto [statement, exec_err] = execute_query_internal(
+      this->db_handle_, sql, params, /*forward_only=*/false, &timings);
+  QSqlQuery &query = *statement;
   if (exec_err) {
     return exec_err;
   }
 
+  internal::StatementProfile profile(connection_name_, sql, timings);
   if (query.next()) {
+    const auto map_started = profile.beginRow();
     Error map_err = mapRowToModel(query, result_model, *meta);
     if (map_err) {
       qWarning() << "cpporm Session::FirstImpl: Error mapping row:"
                  << map_err.toString().c_str();
       return map_err;
     }
+    // 只读一行：释放结果集，语句缓存中的同一条语句随即可被复用
+    query.finish();
     result_model._is_persisted = true;
     Error hook_err = result_model.afterFind(*this);
+    profile.endRow(map_started);
+    profile.endFetch();
     if (hook_err)
       return hook_err;
 
@@ -58,7 +69,9 @@ Error Session::FirstImpl(const QueryBuilder &qb, ModelBase &result_model) {
       // Convert ModelBase& to a vector of raw pointers for
       // processPreloadsInternal
       std::vector<ModelBase *> models_for_preload = {&result_model};
+      const auto preload_started = profile.beginPreload();
       Error preload_err = this->processPreloadsInternal(qb, models_for_preload);
+      profile.endPreload(preload_started);
       if (preload_err) {
         qWarning()
             << "Session::FirstImpl: Preloading failed after fetching model: "
@@ -102,26 +115,26 @@ Error Session::FindImpl(
                  "Failed to build SQL for Find operation.");
   }
 
-  auto [query, exec_err] =
-      execute_query_internal(this->db_handle_, sql, params);
+  internal::StatementTimings timings;
+  auto [statement, exec_err] = execute_query_internal(
+      this->db_handle_, sql, params, /*forward_only=*/false, &timings);
+  QSqlQuery &query = *statement;
   if (exec_err) {
     return exec_err;
   }
 
+  internal::StatementProfile profile(connection_name_, sql, timings);
   results_vector.clear();
+  // 列 → 字段映射只解析一次，逐行复用
+  const internal::RowMapper row_mapper(*meta_for_query, query.record());
   while (query.next()) {
+    const auto map_started = profile.beginRow();
     std::unique_ptr<ModelBase> new_element = element_type_factory();
     if (!new_element) {
       return Error(ErrorCode::InternalError,
                    "Element factory returned nullptr inside Find loop.");
     }
-    Error map_err = mapRowToModel(query, *new_element, *meta_for_query);
-    if (map_err) {
-      qWarning() << "cpporm Session::FindImpl: Error mapping row: "
-                 << map_err.toString().c_str() << ". SQL was: " << sql;
-      return map_err;
-    }
-    new_element->_is_persisted = true;
+    row_mapper.mapRow(query, *new_element);
     Error hook_err = new_element->afterFind(*this);
     if (hook_err) {
       qWarning()
@@ -129,12 +142,16 @@ Error Session::FindImpl(
           << hook_err.toString().c_str();
     }
     results_vector.push_back(std::move(new_element));
+    profile.endRow(map_started);
   }
+  profile.endFetch();
 
   // Preloading logic for FindImpl
   if (!results_vector.empty() && !qb.getPreloadRequests().empty()) {
     // processPreloads now correctly takes a vector of unique_ptr
+    const auto preload_started = profile.beginPreload();
     Error preload_err = this->processPreloads(qb, results_vector);
+    profile.endPreload(preload_started);
     if (preload_err) {
       return preload_err;
     }
@@ -142,6 +159,235 @@ Error Session::FindImpl(
   return make_ok();
 }
 
+Error Session::FindEachImpl(
+    const QueryBuilder &qb,
+    std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+    std::function<Error(ModelBase &)> row_callback) {
+  if (!element_type_factory || !row_callback) {
+    return Error(ErrorCode::InternalError,
+                 "FindEach requires an element factory and a row callback.");
+  }
+  const ModelMeta *meta_for_query = qb.getModelMeta();
+  if (!meta_for_query) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "FindEachImpl: ModelMeta not set in QueryBuilder.");
+  }
+  if (!qb.getPreloadRequests().empty()) {
+    qWarning() << "cpporm Session::FindEachImpl: Preload requests are ignored "
+                  "when streaming rows; use FindInBatches for preloading.";
+  }
+
+  auto [sql, params] = qb.buildSelectSQL();
+  if (sql.isEmpty()) {
+    return Error(ErrorCode::StatementPreparationError,
+                 "Failed to build SQL for FindEach operation.");
+  }
+
+  // forward-only：驱动无需为向后滚动缓存已读取的行
+  internal::StatementTimings timings;
+  auto [statement, exec_err] = execute_query_internal(
+      this->db_handle_, sql, params, /*forward_only=*/true, &timings);
+  QSqlQuery &query = *statement;
+  if (exec_err) {
+    return exec_err;
+  }
+
+  // 回调中的耗时计入 map
+  internal::StatementProfile profile(connection_name_, sql, timings);
+  const internal::RowMapper row_mapper(*meta_for_query, query.record());
+  while (query.next()) {
+    const auto map_started = profile.beginRow();
+    std::unique_ptr<ModelBase> element = element_type_factory();
+    if (!element) {
+      query.finish();
+      return Error(ErrorCode::InternalError,
+                   "Element factory returned nullptr inside FindEach loop.");
+    }
+    row_mapper.mapRow(query, *element);
+    Error hook_err = element->afterFind(*this);
+    if (hook_err) {
+      qWarning() << "cpporm Session::FindEachImpl: afterFind hook failed for "
+                    "an element: "
+                 << hook_err.toString().c_str();
+    }
+    Error callback_err = row_callback(*element);
+    profile.endRow(map_started);
+    if (callback_err) {
+      query.finish();
+      return callback_err;
+    }
+  }
+  return make_ok();
+}
+
+Error Session::ProjectImpl(
+    const QueryBuilder &qb,
+    std::function<Error(const QSqlQuery &)> row_callback) {
+  if (!row_callback) {
+    return Error(ErrorCode::InternalError,
+                 "Projection requires a row callback.");
+  }
+  if (!qb.getPreloadRequests().empty()) {
+    qWarning() << "cpporm Session::ProjectImpl: Preload requests are ignored "
+                  "for column projections.";
+  }
+
+  auto [sql, params] = qb.buildSelectSQL();
+  if (sql.isEmpty()) {
+    return Error(ErrorCode::StatementPreparationError,
+                 "Failed to build SQL for projection query.");
+  }
+
+  internal::StatementTimings timings;
+  auto [statement, exec_err] = execute_query_internal(
+      this->db_handle_, sql, params, /*forward_only=*/true, &timings);
+  QSqlQuery &query = *statement;
+  if (exec_err) {
+    return exec_err;
+  }
+
+  internal::StatementProfile profile(connection_name_, sql, timings);
+  while (query.next()) {
+    const auto map_started = profile.beginRow();
+    Error callback_err = row_callback(query);
+    profile.endRow(map_started);
+    if (callback_err) {
+      query.finish();
+      return callback_err;
+    }
+  }
+  return make_ok();
+}
+
+Error Session::FindInBatchesImpl(
+    const QueryBuilder &qb, size_t batch_size,
+    std::function<std::unique_ptr<ModelBase>()> element_type_factory,
+    std::function<Error(std::vector<std::unique_ptr<ModelBase>> &)>
+        batch_callback) {
+  if (!element_type_factory || !batch_callback) {
+    return Error(
+        ErrorCode::InternalError,
+        "FindInBatches requires an element factory and a batch callback.");
+  }
+  if (batch_size == 0) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "FindInBatches: batch_size must be greater than zero.");
+  }
+  batch_size = std::min<size_t>(batch_size,
+                                static_cast<size_t>(
+                                    std::numeric_limits<int>::max()));
+
+  const ModelMeta *meta = qb.getModelMeta();
+  if (!meta) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "FindInBatchesImpl: ModelMeta not set in QueryBuilder.");
+  }
+  if (meta->primary_keys_db_names.empty()) {
+    return Error(ErrorCode::InvalidConfiguration,
+                 "FindInBatches requires a model with a primary key. Table: " +
+                     meta->table_name);
+  }
+
+  const std::string qualifier =
+      QueryBuilder::quoteSqlIdentifier(qb.getFromSourceName().toStdString()) +
+      ".";
+  std::vector<std::string> pk_cpp_names;
+  std::string pk_columns_sql;
+  std::string pk_placeholders_sql;
+  std::string pk_order_sql;
+  for (const std::string &pk_db_name : meta->primary_keys_db_names) {
+    const FieldMeta *pk_field = meta->findFieldByDbName(pk_db_name);
+    if (!pk_field) {
+      return Error(ErrorCode::InternalError,
+                   "FindInBatches: primary key field meta not found for " +
+                       pk_db_name);
+    }
+    pk_cpp_names.push_back(pk_field->cpp_name);
+    const std::string column =
+        qualifier + QueryBuilder::quoteSqlIdentifier(pk_db_name);
+    if (!pk_columns_sql.empty()) {
+      pk_columns_sql += ", ";
+      pk_placeholders_sql += ", ";
+      pk_order_sql += ", ";
+    }
+    pk_columns_sql += column;
+    pk_placeholders_sql += "?";
+    pk_order_sql += column + " ASC";
+  }
+  // 复合主键使用行值比较 (a, b) > (?, ?)
+  const std::string keyset_condition_sql =
+      pk_cpp_names.size() == 1
+          ? pk_columns_sql + " > ?"
+          : "(" + pk_columns_sql + ") > (" + pk_placeholders_sql + ")";
+
+  QueryBuilder base_qb = qb;
+  QueryBuilderState &base_state = base_qb.getState_();
+  if (!base_state.or_conditions_.empty()) {
+    // OR 块与 WHERE 块在生成的 SQL 中是并列的，直接追加的键集条件只会约束
+    // WHERE 块；先把已有条件折叠为一个括号组。
+    auto [group_sql, group_args] = qb.buildConditionClauseGroup();
+    base_state.where_conditions_.clear();
+    base_state.or_conditions_.clear();
+    base_state.not_conditions_.clear();
+    if (!group_sql.empty())
+      base_qb.Where(group_sql, group_args);
+  }
+  if (!base_state.order_clause_.empty()) {
+    qWarning() << "cpporm Session::FindInBatchesImpl: existing ORDER BY"
+               << QString::fromStdString(base_state.order_clause_)
+               << "is replaced by primary key order.";
+  }
+  if (base_state.offset_val_ >= 0) {
+    qWarning() << "cpporm Session::FindInBatchesImpl: OFFSET is ignored for "
+                  "keyset pagination.";
+  }
+  const int total_limit = base_state.limit_val_;
+  base_qb.Order(pk_order_sql);
+  base_qb.Offset(-1);
+
+  std::vector<QueryValue> last_key_values;
+  std::vector<std::unique_ptr<ModelBase>> batch;
+  size_t delivered_rows = 0;
+  while (true) {
+    size_t page_size = batch_size;
+    if (total_limit >= 0) {
+      // 每页大小不超过剩余额度，delivered_rows 不会超过 total_limit
+      page_size = std::min(page_size,
+                           static_cast<size_t>(total_limit) - delivered_rows);
+      if (page_size == 0)
+        break;
+    }
+
+    QueryBuilder page_qb = base_qb;
+    if (!last_key_values.empty())
+      page_qb.Where(keyset_condition_sql, last_key_values);
+    page_qb.Limit(static_cast<int>(page_size));
+
+    Error find_err = this->FindImpl(page_qb, batch, element_type_factory);
+    if (find_err)
+      return find_err;
+    if (batch.empty())
+      break;
+
+    const size_t fetched_rows = batch.size();
+    // 回调可能转移元素所有权，游标须在回调前取出
+    last_key_values.clear();
+    const ModelBase &last_row = *batch.back();
+    for (const std::string &pk_cpp_name : pk_cpp_names) {
+      last_key_values.push_back(anyToQueryValueForSessionConvenience(
+          last_row.getFieldValue(pk_cpp_name)));
+    }
+
+    Error callback_err = batch_callback(batch);
+    if (callback_err)
+      return callback_err;
+    delivered_rows += fetched_rows;
+    if (fetched_rows < page_size)
+      break;
+  }
+  return make_ok();
+}
+
 std::expected<int64_t, Error> Session::CountImpl(const QueryBuilder &qb_const) {
   QueryBuilder qb = qb_const; // 创建可修改副本
   if (!qb.getGroupClause().empty()) {
@@ -166,20 +412,23 @@ std::expected<int64_t, Error> Session::CountImpl(const QueryBuilder &qb_const) {
     return std::unexpected(Error(ErrorCode::StatementPreparationError,
                                  "Failed to build SQL for Count operation."));
   }
-  auto [query, err] = execute_query_internal(this->db_handle_, sql, params);
+  auto [statement, err] = execute_query_internal(this->db_handle_, sql, params);
+  QSqlQuery &query = *statement;
   if (err) {
     return std::unexpected(err);
   }
   if (query.next()) {
     bool ok_conversion;
-    int64_t count_val = query.value(0).toLongLong(&ok_conversion);
+    const QVariant count_variant = query.value(0);
+    query.finish();
+    int64_t count_val = count_variant.toLongLong(&ok_conversion);
     if (ok_conversion) {
       return count_val;
     } else {
       return std::unexpected(
           Error(ErrorCode::MappingError,
                 "Failed to convert COUNT(*) result to integer. Value: " +
-                    query.value(0).toString().toStdString()));
+                    count_variant.toString().toStdString()));
     }
   } else {
     qWarning() << "cpporm Session::CountImpl: COUNT(*) query returned no rows "
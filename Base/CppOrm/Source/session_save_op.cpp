@@ -89,6 +89,22 @@ convertQStringVariantMapToStringQueryValueMapForSaveOpHelper(
   return result;
 }
 
+namespace {
+
+// current 为 extractModelData 提取的当前值，loaded 为快照中的值。
+// 类型不同（例如 DECIMAL 以字符串返回）时按已修改处理，宁可多写一列。
+// 加载时为 NULL 的列只有当前值仍为 NULL 才算未修改：非 optional 字段
+// 会把 NULL 映射成零值，无法区分用户是否显式赋了零值，因此照写。
+bool matchesLoadedValue(const QVariant &current, const QVariant &loaded) {
+  if (!loaded.isValid())
+    return false; // 该列未加载
+  if (loaded.isNull() || current.isNull())
+    return loaded.isNull() && current.isNull();
+  return current == loaded;
+}
+
+} // namespace
+
 std::expected<long long, Error> Session::SaveImpl(
     const QueryBuilder
         &qb_param, // QB used for model meta and potentially OnConflict from QB
@@ -158,8 +174,11 @@ std::expected<long long, Error> Session::SaveImpl(
       (model_instance._is_persisted || model_has_all_pks_set_and_non_default) &&
       has_defined_pk;
 
-  if (attempt_update) {                                   // Attempt an UPDATE
-    this->autoSetTimestamps(model_instance, meta, false); // Set updated_at
+  if (attempt_update) { // Attempt an UPDATE
+    hook_err = model_instance.beforeUpdate(*this);
+    if (hook_err)
+      return std::unexpected(hook_err);
+
     cpporm::internal::SessionModelDataForWrite data_to_write =
         this->extractModelData(model_instance, meta, true, true);
 
@@ -170,16 +189,31 @@ std::expected<long long, Error> Session::SaveImpl(
                 "values for WHERE clause."));
     }
 
-    bool has_fields_to_set = !data_to_write.fields_to_write.empty();
-    if (!has_fields_to_set) {
-      qInfo("SaveImpl (Update path): No fields (including timestamps) to "
-            "update for table %s. Skipping DB operation.",
-            meta.table_name.c_str());
-      // Still call hooks as the intent was to save/update
-      hook_err = model_instance.beforeUpdate(
-          *this); // Call beforeUpdate even if no DB op
-      if (hook_err)
-        return std::unexpected(hook_err);
+    // UpdatedAt 只在确有列需要写入时由 autoSetTimestamps 刷新，不参与脏比较
+    const FieldMeta *updated_at_field =
+        meta.findFieldWithFlag(FieldFlag::UpdatedAt);
+    if (updated_at_field && updated_at_field->cpp_type != typeid(QDateTime))
+      updated_at_field = nullptr;
+    if (updated_at_field) {
+      data_to_write.fields_to_write.erase(
+          QString::fromStdString(updated_at_field->db_name));
+    }
+
+    const bool dirty_tracked =
+        model_instance._isDirtyTracked() &&
+        &meta == &model_instance._getOwnModelMeta();
+    if (dirty_tracked) {
+      std::erase_if(data_to_write.fields_to_write, [&](const auto &pair) {
+        const FieldId id = meta.findFieldIdByDbName(pair.first.toStdString());
+        return id < model_instance._loaded_values.size() &&
+               matchesLoadedValue(pair.second,
+                                  model_instance._loaded_values[id]);
+      });
+    }
+
+    if (data_to_write.fields_to_write.empty() &&
+        (dirty_tracked || !updated_at_field)) {
+      // 与加载时相比没有变化：不发 UPDATE，也不刷新 UpdatedAt
       hook_err = model_instance.afterUpdate(*this);
       if (hook_err)
         return std::unexpected(hook_err);
@@ -189,9 +223,18 @@ std::expected<long long, Error> Session::SaveImpl(
       return 0LL; // 0 rows affected
     }
 
-    hook_err = model_instance.beforeUpdate(*this);
-    if (hook_err)
-      return std::unexpected(hook_err);
+    if (updated_at_field) {
+      this->autoSetTimestamps(model_instance, meta, false);
+      std::any updated_at_value =
+          updated_at_field->getter
+              ? updated_at_field->getter(&model_instance)
+              : model_instance.getFieldValue(updated_at_field->cpp_name);
+      if (updated_at_value.type() == typeid(QDateTime)) {
+        data_to_write.fields_to_write[QString::fromStdString(
+            updated_at_field->db_name)] =
+            QVariant(std::any_cast<QDateTime>(updated_at_value));
+      }
+    }
 
     QueryBuilder update_qb(this, this->connection_name_, &meta);
     for (const auto &pk_name_std : meta.primary_keys_db_names) {
@@ -237,8 +280,11 @@ std::expected<long long, Error> Session::SaveImpl(
     if (!update_result.has_value())
       return std::unexpected(update_result.error());
 
-    if (update_result.value() >= 0)
+    if (update_result.value() >= 0) {
       model_instance._is_persisted = true;
+      snapshotWrittenValues(model_instance, meta, data_to_write.fields_to_write,
+                            false);
+    }
 
     hook_err = model_instance.afterUpdate(*this);
     if (hook_err)
@@ -1,6 +1,7 @@
 // cpporm/session_static_utils.cpp
 #include "cpporm/error.h"      // For Error, make_ok
 #include "cpporm/model_base.h" // For FieldMeta in getSqlTypeForCppType
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/session.h"    // 主头文件
 
 #include <QDebug>
@@ -9,6 +10,8 @@
 #include <QSqlQuery> // For execute_query_internal
 #include <QVariant>
 #include <any> // For anyToQueryValueForSessionConvenience, qvariantToAny
+#include <memory>
+#include <optional>
 
 namespace cpporm {
 
@@ -194,45 +197,101 @@ QueryValue Session::anyToQueryValueForSessionConvenience(const std::any &val) {
 
 // --- Private Static execute_query_internal (implementation) ---
 // 这现在是 Session 类的私有静态成员，它的唯一定义在此处。
-std::pair<QSqlQuery, Error>
+// 相同连接、相同线程上的相同 SQL 复用 PreparedStatementCache 中已
+// prepare 的语句，只重新绑定参数；语句随返回的租约借出，租约结束时归还。
+std::pair<internal::StatementLease, Error>
 Session::execute_query_internal(QSqlDatabase db_conn_val_copy,
                                 const QString &sql,
-                                const QVariantList &bound_params) {
+                                const QVariantList &bound_params,
+                                bool forward_only,
+                                internal::StatementTimings *timings) {
+  auto &statement_cache = internal::PreparedStatementCache::instance();
+  auto &profiler = internal::QueryProfiler::instance();
+  const bool profiling = profiler.enabled();
+  internal::StatementTimings local_timings;
+  internal::StatementTimings &stmt_timings =
+      timings ? *timings : local_timings;
+  stmt_timings = {};
+  stmt_timings.bound_params = static_cast<int>(bound_params.size());
+  using Clock = internal::QueryProfiler::Clock;
+  auto elapsed_ns = [](Clock::time_point since) {
+    return static_cast<int64_t>((Clock::now() - since).count());
+  };
+  const QString connection_name = db_conn_val_copy.connectionName();
   if (!db_conn_val_copy.isOpen()) {
+    // 重连后旧连接上 prepare 的语句句柄全部失效
+    statement_cache.invalidate(connection_name);
     if (!db_conn_val_copy.open()) {
       QSqlError err = db_conn_val_copy.lastError();
-      return {QSqlQuery(db_conn_val_copy),
+      return {internal::StatementLease(
+                  std::make_unique<QSqlQuery>(db_conn_val_copy)),
               Error(ErrorCode::ConnectionNotOpen,
                     "execute_query_internal: Failed to open database for query "
                     "execution on connection '" +
-                        db_conn_val_copy.connectionName().toStdString() +
+                        connection_name.toStdString() +
                         "': " + err.text().toStdString(),
                     err.nativeErrorCode().toInt())};
     }
   }
-  QSqlQuery query(db_conn_val_copy);
-  query.prepare(sql);
-  QSqlError prepareError = query.lastError();
-  if (prepareError.type() != QSqlError::NoError &&
-      prepareError.type() != QSqlError::UnknownError) {
-    if (!query.isValid() || (prepareError.type() > QSqlError::NoError &&
-                             prepareError.type() < QSqlError::StatementError)) {
-      return {query, Error(ErrorCode::StatementPreparationError,
-                           "Failed to prepare SQL query: " +
-                               prepareError.text().toStdString() +
-                               " SQL: " + sql.toStdString(),
-                           prepareError.nativeErrorCode().toInt())};
+
+  // 流式结果会在调用方长时间持有，不放入缓存
+  internal::StatementLease statement;
+  if (!forward_only)
+    statement = statement_cache.acquire(connection_name, sql);
+  const bool reused_statement = static_cast<bool>(statement);
+  if (!reused_statement) {
+    auto fresh = std::make_unique<QSqlQuery>(db_conn_val_copy);
+    if (forward_only)
+      fresh->setForwardOnly(true);
+    const Clock::time_point prepare_started =
+        profiling ? Clock::now() : Clock::time_point{};
+    fresh->prepare(sql);
+    if (profiling)
+      stmt_timings.prepare_ns = elapsed_ns(prepare_started);
+    statement = forward_only ? internal::StatementLease(std::move(fresh))
+                             : statement_cache.adopt(connection_name, sql,
+                                                     std::move(fresh));
+    QSqlError prepareError = statement->lastError();
+    if (prepareError.type() != QSqlError::NoError &&
+        prepareError.type() != QSqlError::UnknownError) {
+      if (!statement->isValid() ||
+          (prepareError.type() > QSqlError::NoError &&
+           prepareError.type() < QSqlError::StatementError)) {
+        if (profiling)
+          profiler.recordExecution(connection_name, sql, stmt_timings,
+                                   /*succeeded=*/false,
+                                   /*defer_slow_check=*/false);
+        statement.discard();
+        return {std::move(statement),
+                Error(ErrorCode::StatementPreparationError,
+                      "Failed to prepare SQL query: " +
+                          prepareError.text().toStdString() +
+                          " SQL: " + sql.toStdString(),
+                      prepareError.nativeErrorCode().toInt())};
+      }
     }
   }
+  QSqlQuery &query = *statement;
+  // exec() 会重置绑定计数，复用的语句同样按顺序重新绑定即可
   for (const QVariant &param : bound_params) {
     query.addBindValue(param);
   }
-  if (!query.exec()) {
+  const Clock::time_point exec_started =
+      profiling ? Clock::now() : Clock::time_point{};
+  const bool exec_ok = query.exec();
+  if (profiling) {
+    stmt_timings.exec_ns = elapsed_ns(exec_started);
+    profiler.recordExecution(connection_name, sql, stmt_timings, exec_ok,
+                             /*defer_slow_check=*/timings != nullptr);
+  }
+  if (!exec_ok) {
+    // 执行失败的语句可能已处于异常状态（例如连接中断），下次重新 prepare
+    statement.discard();
     QSqlError err = query.lastError();
     QStringList params_str_list;
     for (const auto &v : bound_params)
       params_str_list << v.toString();
-    return {query,
+    return {std::move(statement),
             Error(ErrorCode::QueryExecutionError,
                   "SQL query execution failed: " + err.text().toStdString() +
                       " (Driver: " + err.driverText().toStdString() +
@@ -244,7 +303,7 @@ Session::execute_query_internal(QSqlDatabase db_conn_val_copy,
                       ? err.nativeErrorCode().toStdString()
                       : "")};
   }
-  return {query, make_ok()};
+  return {std::move(statement), make_ok()};
 }
 
 } // namespace cpporm
\ No newline at end of file
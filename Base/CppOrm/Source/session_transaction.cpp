@@ -62,7 +62,9 @@ std::expected<std::unique_ptr<Session>, Error> Session::Begin() {
     // It uses the same underlying connection (via a copy of db_handle_), but is
     // marked as transactional. The Session(QSqlDatabase) constructor sets
     // is_explicit_transaction_handle_ = true.
-    return std::make_unique<Session>(db_handle_);
+    auto tx_session = std::make_unique<Session>(db_handle_);
+    tx_session->pool_lease_ = pool_lease_;
+    return tx_session;
   } else {
     QSqlError q_error = db_handle_.lastError();
     return std::unexpected(
@@ -102,6 +104,11 @@ Error Session::Commit() {
 
   if (db_handle_.commit()) {
     is_explicit_transaction_handle_ = false; // Transaction successfully ended
+    std::vector<std::string> written_tables = std::move(tx_written_tables_);
+    tx_written_tables_.clear();
+    for (const std::string &table_name : written_tables) {
+      invalidateCachedTable(table_name);
+    }
     return make_ok();
   } else {
     QSqlError q_error = db_handle_.lastError();
@@ -143,6 +150,7 @@ Error Session::Rollback() {
 
   if (db_handle_.rollback()) {
     is_explicit_transaction_handle_ = false; // Transaction successfully ended
+    tx_written_tables_.clear();
     return make_ok();
   } else {
     QSqlError q_error = db_handle_.lastError();
@@ -0,0 +1,328 @@
+// cpporm/session_update_batch_ops.cpp
+#include "cpporm/adaptive_batch_sizer.h"
+#include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
+#include "cpporm/query_builder.h"
+#include "cpporm/session.h"
+
+#include <QDebug>
+#include <QSqlDriver>
+#include <QStringList>
+#include <QVariant>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace cpporm {
+
+namespace {
+
+QString quotedIdentifier(const std::string &name) {
+  return QString::fromStdString(QueryBuilder::quoteSqlIdentifier(name));
+}
+
+// 一行待更新的数据：主键值与 columns 顺序对应的新值
+struct UpdateBatchRow {
+  ModelBase *model;
+  QVariantList pk_values;
+  QVariantList column_values;
+};
+
+// MySQL/SQLite 及其他驱动：
+// UPDATE t SET c = CASE pk WHEN ? THEN ? ... END, ... WHERE pk IN (?, ...)
+// 复合主键时 CASE 分支为 WHEN a = ? AND b = ? THEN ?，WHERE 为 OR 组。
+// WHERE 只包含本批主键，因此 CASE 不需要 ELSE。
+QString buildCaseUpdateSql(const ModelMeta &meta,
+                           const std::vector<QString> &columns,
+                           const std::vector<UpdateBatchRow> &rows,
+                           size_t begin, size_t end, QVariantList &params) {
+  const size_t pk_count = meta.primary_keys_db_names.size();
+  QString pk_match; // 复合主键的 "a = ? AND b = ?"
+  if (pk_count > 1) {
+    QStringList parts;
+    for (const std::string &pk_name : meta.primary_keys_db_names) {
+      parts.append(quotedIdentifier(pk_name) + " = ?");
+    }
+    pk_match = parts.join(" AND ");
+  }
+
+  QStringList assignments;
+  for (size_t c = 0; c < columns.size(); ++c) {
+    QString expr = quotedIdentifier(columns[c].toStdString()) + " = CASE";
+    if (pk_count == 1)
+      expr += " " + quotedIdentifier(meta.primary_keys_db_names[0]);
+    for (size_t i = begin; i < end; ++i) {
+      expr += pk_count == 1 ? QString(" WHEN ?") : " WHEN " + pk_match;
+      expr += " THEN ?";
+      params.append(rows[i].pk_values);
+      params.append(rows[i].column_values[static_cast<qsizetype>(c)]);
+    }
+    expr += " END";
+    assignments.append(expr);
+  }
+
+  QString where;
+  if (pk_count == 1) {
+    QStringList placeholders;
+    for (size_t i = begin; i < end; ++i) {
+      placeholders.append("?");
+      params.append(rows[i].pk_values);
+    }
+    where = quotedIdentifier(meta.primary_keys_db_names[0]) + " IN (" +
+            placeholders.join(", ") + ")";
+  } else {
+    QStringList groups;
+    for (size_t i = begin; i < end; ++i) {
+      groups.append("(" + pk_match + ")");
+      params.append(rows[i].pk_values);
+    }
+    where = groups.join(" OR ");
+  }
+
+  return QString("UPDATE %1 SET %2 WHERE %3")
+      .arg(quotedIdentifier(meta.table_name), assignments.join(", "), where);
+}
+
+// PostgreSQL 的 VALUES 参数需要显式类型：取迁移使用的列类型，
+// SERIAL 类是建表简写而非真实类型，换成对应的整数类型
+QString pgCastType(const ModelMeta &meta, const std::string &db_name) {
+  const FieldMeta *field = meta.findFieldByDbName(db_name);
+  if (!field)
+    return "TEXT";
+  const QString type =
+      QString::fromStdString(Session::getSqlTypeForCppType(*field, "QPSQL"))
+          .trimmed();
+  const QString upper = type.toUpper();
+  if (upper.startsWith("BIGSERIAL"))
+    return "BIGINT";
+  if (upper.startsWith("SMALLSERIAL"))
+    return "SMALLINT";
+  if (upper.startsWith("SERIAL"))
+    return "INTEGER";
+  return type;
+}
+
+// PostgreSQL：
+// UPDATE t SET c = v.c, ... FROM (VALUES (?::int8, ?::text, ...), ...)
+//   AS v (pk, c, ...) WHERE t.pk = v.pk
+// 标识符用驱动的 escapeIdentifier 加双引号；每个参数带 ::type，
+// 否则 VALUES 中的参数会被推断为 text。
+QString buildValuesJoinUpdateSql(const QSqlDriver *driver,
+                                 const ModelMeta &meta,
+                                 const std::vector<QString> &columns,
+                                 const std::vector<UpdateBatchRow> &rows,
+                                 size_t begin, size_t end,
+                                 QVariantList &params) {
+  const QString table = driver->escapeIdentifier(
+      QString::fromStdString(meta.table_name), QSqlDriver::TableName);
+  const QString alias =
+      driver->escapeIdentifier("cpporm_v", QSqlDriver::TableName);
+  auto field_name = [driver](const QString &name) {
+    return driver->escapeIdentifier(name, QSqlDriver::FieldName);
+  };
+
+  QStringList value_columns;
+  QStringList row_placeholders;
+  for (const std::string &pk_name : meta.primary_keys_db_names) {
+    value_columns.append(field_name(QString::fromStdString(pk_name)));
+    row_placeholders.append("?::" + pgCastType(meta, pk_name));
+  }
+  QStringList assignments;
+  for (const QString &column : columns) {
+    const QString quoted = field_name(column);
+    value_columns.append(quoted);
+    row_placeholders.append("?::" + pgCastType(meta, column.toStdString()));
+    assignments.append(quoted + " = " + alias + "." + quoted);
+  }
+
+  const QString row_tuple = "(" + row_placeholders.join(", ") + ")";
+  QStringList tuples;
+  for (size_t i = begin; i < end; ++i) {
+    tuples.append(row_tuple);
+    params.append(rows[i].pk_values);
+    params.append(rows[i].column_values);
+  }
+
+  QStringList pk_join;
+  for (const std::string &pk_name : meta.primary_keys_db_names) {
+    const QString quoted = field_name(QString::fromStdString(pk_name));
+    pk_join.append(table + "." + quoted + " = " + alias + "." + quoted);
+  }
+
+  return QString("UPDATE %1 SET %2 FROM (VALUES %3) AS %4 (%5) WHERE %6")
+      .arg(table, assignments.join(", "), tuples.join(", "), alias,
+           value_columns.join(", "), pk_join.join(" AND "));
+}
+
+} // namespace
+
+std::expected<long long, Error>
+Session::UpdateBatch(const ModelMeta &meta,
+                     const std::vector<ModelBase *> &models,
+                     const std::vector<std::string> &columns,
+                     size_t batch_size_hint) {
+  if (meta.table_name.empty()) {
+    return std::unexpected(
+        Error(ErrorCode::InvalidConfiguration,
+              "UpdateBatch: ModelMeta does not have a valid table name."));
+  }
+  if (meta.primary_keys_db_names.empty()) {
+    return std::unexpected(
+        Error(ErrorCode::MappingError, "UpdateBatch: Model " +
+                                           meta.table_name +
+                                           " has no primary keys defined."));
+  }
+
+  // 解析要写入的列：接受数据库列名或 C++ 字段名，主键与关联字段不可更新
+  std::vector<QString> update_columns;
+  for (const std::string &name : columns) {
+    const FieldMeta *field = meta.findFieldByDbName(name);
+    if (!field)
+      field = meta.findFieldByCppName(name);
+    if (!field || has_flag(field->flags, FieldFlag::Association)) {
+      return std::unexpected(
+          Error(ErrorCode::MappingError, "UpdateBatch: Column '" + name +
+                                             "' is not a field of " +
+                                             meta.table_name + "."));
+    }
+    if (has_flag(field->flags, FieldFlag::PrimaryKey)) {
+      return std::unexpected(
+          Error(ErrorCode::InvalidConfiguration,
+                "UpdateBatch: Primary key column '" + field->db_name +
+                    "' cannot be updated."));
+    }
+    const QString db_name = QString::fromStdString(field->db_name);
+    if (std::find(update_columns.begin(), update_columns.end(), db_name) ==
+        update_columns.end())
+      update_columns.push_back(db_name);
+  }
+  if (!columns.empty()) {
+    // 与 Updates 一致：指定了列时仍自动刷新 UpdatedAt
+    if (const FieldMeta *updated_at =
+            meta.findFieldWithFlag(FieldFlag::UpdatedAt)) {
+      const QString db_name = QString::fromStdString(updated_at->db_name);
+      if (updated_at->cpp_type == typeid(QDateTime) &&
+          std::find(update_columns.begin(), update_columns.end(), db_name) ==
+              update_columns.end())
+        update_columns.push_back(db_name);
+    }
+  }
+
+  // 钩子与时间戳在写库前全部处理完，任一 before 钩子失败则不写入任何行
+  std::vector<UpdateBatchRow> rows;
+  rows.reserve(models.size());
+  for (ModelBase *model : models) {
+    if (!model)
+      continue;
+    Error hook_err = model->beforeSave(*this);
+    if (hook_err)
+      return std::unexpected(hook_err);
+    hook_err = model->beforeUpdate(*this);
+    if (hook_err)
+      return std::unexpected(hook_err);
+    autoSetTimestamps(*model, meta, false);
+
+    internal::SessionModelDataForWrite data =
+        extractModelData(*model, meta, true, true);
+    if (update_columns.empty()) {
+      // 未指定列：取第一个模型的全部可写非主键列
+      for (const auto &pair : data.fields_to_write) {
+        update_columns.push_back(pair.first);
+      }
+      if (update_columns.empty()) {
+        return std::unexpected(
+            Error(ErrorCode::MappingError,
+                  "UpdateBatch: model has no writable columns. Table: " +
+                      meta.table_name));
+      }
+    }
+
+    UpdateBatchRow row{model, {}, {}};
+    for (const std::string &pk_name : meta.primary_keys_db_names) {
+      auto it = data.primary_key_fields.find(QString::fromStdString(pk_name));
+      if (it == data.primary_key_fields.end()) {
+        return std::unexpected(
+            Error(ErrorCode::MappingError,
+                  "UpdateBatch: Primary key '" + pk_name +
+                      "' is not set on a model of " + meta.table_name + "."));
+      }
+      row.pk_values.append(it->second);
+    }
+    for (const QString &column : update_columns) {
+      auto it = data.fields_to_write.find(column);
+      row.column_values.append(it != data.fields_to_write.end() ? it->second
+                                                                : QVariant());
+    }
+    rows.push_back(std::move(row));
+  }
+  if (rows.empty())
+    return 0LL;
+
+  const QString driver_upper = db_handle_.driverName().toUpper();
+  const bool use_values_join = driver_upper == "QPSQL";
+  const size_t pk_count = meta.primary_keys_db_names.size();
+  // CASE 形式每列每行占 pk_count + 1 个参数，WHERE 再占 pk_count 个；
+  // VALUES 形式每行只占 pk_count + 列数 个参数
+  const size_t placeholders_per_row =
+      use_values_join ? pk_count + update_columns.size()
+                      : (pk_count + 1) * update_columns.size() + pk_count;
+  std::map<QString, QVariant> sample_row;
+  for (size_t c = 0; c < update_columns.size(); ++c) {
+    sample_row[update_columns[c]] =
+        rows.front().column_values[static_cast<qsizetype>(c)];
+  }
+  internal::AdaptiveBatchSizer batch_sizer(
+      driver_upper, placeholders_per_row,
+      internal::estimateRowBytes(sample_row), batch_size_hint);
+
+  long long total_rows_affected = 0;
+  size_t begin = 0;
+  while (begin < rows.size()) {
+    const size_t end =
+        std::min(rows.size(), begin + batch_sizer.nextBatchSize());
+    QVariantList params;
+    params.reserve(
+        static_cast<qsizetype>((end - begin) * placeholders_per_row));
+    const QString sql =
+        use_values_join
+            ? buildValuesJoinUpdateSql(db_handle_.driver(), meta,
+                                       update_columns, rows, begin, end,
+                                       params)
+            : buildCaseUpdateSql(meta, update_columns, rows, begin, end,
+                                 params);
+
+    const auto started_at = std::chrono::steady_clock::now();
+    auto [statement, exec_err] =
+        execute_query_internal(db_handle_, sql, params);
+    QSqlQuery &query = *statement;
+    invalidateCachedTable(meta.table_name);
+    if (exec_err)
+      return std::unexpected(exec_err);
+    batch_sizer.recordBatch(end - begin,
+                            std::chrono::steady_clock::now() - started_at);
+    total_rows_affected += query.numRowsAffected();
+    query.finish();
+
+    for (size_t i = begin; i < end; ++i) {
+      ModelBase *model = rows[i].model;
+      model->_is_persisted = true;
+      std::map<QString, QVariant> written;
+      for (size_t c = 0; c < update_columns.size(); ++c) {
+        written.emplace(update_columns[c],
+                        rows[i].column_values[static_cast<qsizetype>(c)]);
+      }
+      snapshotWrittenValues(*model, meta, written, false);
+      Error hook_err = model->afterUpdate(*this);
+      if (hook_err)
+        return std::unexpected(hook_err);
+      hook_err = model->afterSave(*this);
+      if (hook_err)
+        return std::unexpected(hook_err);
+    }
+    begin = end;
+  }
+  return total_rows_affected;
+}
+
+} // namespace cpporm
@@ -1,5 +1,6 @@
 // cpporm/session_update_ops.cpp
 #include "cpporm/model_base.h"
+#include "cpporm/prepared_statement_cache.h"
 #include "cpporm/query_builder.h"
 #include "cpporm/session.h"
 
@@ -62,8 +63,10 @@ Session::UpdatesImpl(const QueryBuilder &qb_const, // Renamed to avoid conflict
               "invalid (e.g., a subquery) or table name missing."));
   }
 
-  auto [query_obj, exec_err] =
+  auto [statement, exec_err] =
       execute_query_internal(this->db_handle_, sql, params);
+  QSqlQuery &query_obj = *statement;
+  invalidateCachedTable(qb);
   if (exec_err) {
     return std::unexpected(exec_err);
   }
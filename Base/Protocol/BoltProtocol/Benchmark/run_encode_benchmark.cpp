@@ -0,0 +1,155 @@
+// Micro-benchmark: encoding a repeated RUN message with serialize_run_message (the regular
+// path) versus serialize_run_message_prepared with a cached template and extra map (the path
+// sessions take when prepared_query_cache_size > 0).
+//
+// Usage: run_encode_benchmark [--iterations <n>]
+//
+// Numbers are only meaningful for before/after comparisons on the same machine; build in
+// Release and without the sanitizer flags from the top-level CMakeLists.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boltprotocol/bolt_errors_versions.h"
+#include "boltprotocol/message_defs.h"
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_writer.h"
+
+namespace {
+
+    using namespace boltprotocol;
+    using Clock = std::chrono::steady_clock;
+
+    // A typical parameterised write: a few scalars plus a short list, run against a named database
+    // with one bookmark, which is what the session sends for auto-commit queries.
+    RunMessageParams make_run_params() {
+        RunMessageParams params;
+        params.cypher_query = "MERGE (p:Person {id: $id}) SET p.name = $name, p.age = $age, p.score = $score, p.tags = $tags RETURN p.id";
+        params.parameters["id"] = Value(int64_t(42));
+        params.parameters["name"] = Value(std::string("Alice Example"));
+        params.parameters["age"] = Value(int64_t(37));
+        params.parameters["score"] = Value(0.875);
+        auto tags = std::make_shared<BoltList>();
+        tags->elements.emplace_back(std::string("admin"));
+        tags->elements.emplace_back(std::string("beta"));
+        params.parameters["tags"] = Value(tags);
+        params.db = "neo4j";
+        params.bookmarks = std::vector<std::string>{"FB:kcwQx0TTd8sIS9mLQF2+H58tVQ=="};
+        return params;
+    }
+
+    struct CaseResult {
+        BoltError error = BoltError::SUCCESS;
+        double ns_per_op = 0.0;
+        size_t bytes_per_op = 0;
+    };
+
+    // Mirrors the cache-disabled branch of PreparedRunCache::serialize: copy the extra inputs,
+    // attach query and parameters, encode everything.
+    CaseResult bench_regular(const RunMessageParams& source, const versions::Version& version, uint64_t iterations) {
+        CaseResult result;
+        std::vector<uint8_t> payload;
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            payload.clear();
+            RunMessageParams run_p = source;
+            PackStreamWriter writer(payload);
+            result.error = serialize_run_message(run_p, writer, version);
+            if (result.error != BoltError::SUCCESS) return result;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        result.ns_per_op = elapsed / static_cast<double>(iterations);
+        result.bytes_per_op = payload.size();
+        return result;
+    }
+
+    // Template and extra map are built once outside the timed loop, as on a cache hit.
+    CaseResult bench_prepared(const RunMessageParams& source, const versions::Version& version, uint64_t iterations) {
+        CaseResult result;
+        PreparedRunTemplate run_template;
+        result.error = prepare_run_template(source.cypher_query, source.parameters, run_template);
+        if (result.error != BoltError::SUCCESS) return result;
+        std::vector<uint8_t> extra_bytes;
+        PackStreamWriter extra_writer(extra_bytes);
+        result.error = serialize_run_extra_map(source, extra_writer, version);
+        if (result.error != BoltError::SUCCESS) return result;
+
+        std::vector<uint8_t> payload;
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            payload.clear();
+            result.error = serialize_run_message_prepared(run_template, source.parameters, extra_bytes, payload);
+            if (result.error != BoltError::SUCCESS) return result;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        result.ns_per_op = elapsed / static_cast<double>(iterations);
+        result.bytes_per_op = payload.size();
+        return result;
+    }
+
+    // Both paths must put the same bytes on the wire, otherwise the comparison is meaningless.
+    bool payloads_identical(const RunMessageParams& source, const versions::Version& version) {
+        std::vector<uint8_t> regular;
+        PackStreamWriter writer(regular);
+        if (serialize_run_message(source, writer, version) != BoltError::SUCCESS) return false;
+
+        PreparedRunTemplate run_template;
+        if (prepare_run_template(source.cypher_query, source.parameters, run_template) != BoltError::SUCCESS) return false;
+        std::vector<uint8_t> extra_bytes;
+        PackStreamWriter extra_writer(extra_bytes);
+        if (serialize_run_extra_map(source, extra_writer, version) != BoltError::SUCCESS) return false;
+        std::vector<uint8_t> prepared;
+        if (serialize_run_message_prepared(run_template, source.parameters, extra_bytes, prepared) != BoltError::SUCCESS) return false;
+        return regular == prepared;
+    }
+
+    void print_result(const char* name, const CaseResult& result) {
+        if (result.error != BoltError::SUCCESS) {
+            std::printf("%-24s error %d\n", name, static_cast<int>(result.error));
+            return;
+        }
+        std::printf("%-24s %10.1f ns/op %8zu bytes\n", name, result.ns_per_op, result.bytes_per_op);
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint64_t iterations = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--iterations <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) iterations = 1;
+
+#ifndef NDEBUG
+    std::fprintf(stderr, "warning: benchmark built without NDEBUG\n");
+#endif
+
+    const RunMessageParams source = make_run_params();
+    const versions::Version& version = versions::V5_4;
+    if (!payloads_identical(source, version)) {
+        std::fprintf(stderr, "regular and prepared RUN payloads differ\n");
+        return 1;
+    }
+
+    CaseResult regular = bench_regular(source, version, iterations);
+    CaseResult prepared = bench_prepared(source, version, iterations);
+    print_result("run/regular", regular);
+    print_result("run/prepared", prepared);
+    if (regular.error != BoltError::SUCCESS || prepared.error != BoltError::SUCCESS) return 1;
+    if (prepared.ns_per_op > 0.0) {
+        std::printf("speedup: %.2fx\n", regular.ns_per_op / prepared.ns_per_op);
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef BOLT_PROTOCOL_IMPL_DETAIL_PACKSTREAM_SIZE_UTILS_H
+#define BOLT_PROTOCOL_IMPL_DETAIL_PACKSTREAM_SIZE_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace boltprotocol {
+    namespace detail {
+
+        // Encoded size of an INT: 1 for TINY_INT, otherwise marker + INT_8/16/32/64 payload.
+        // The writers pick the marker by switching on this value, so sizing and encoding agree.
+        inline size_t packed_integer_size(int64_t int_value) {
+            if (int_value >= -16 && int_value <= 127) return 1;
+            if (int_value >= std::numeric_limits<int8_t>::min() && int_value <= std::numeric_limits<int8_t>::max()) return 2;
+            if (int_value >= std::numeric_limits<int16_t>::min() && int_value <= std::numeric_limits<int16_t>::max()) return 3;
+            if (int_value >= std::numeric_limits<int32_t>::min() && int_value <= std::numeric_limits<int32_t>::max()) return 5;
+            return 9;
+        }
+
+        // Marker byte plus size field of a string, list or map header: 1 (tiny), 2, 3 or 5.
+        inline size_t packed_collection_header_size(size_t count) {
+            if (count <= 0x0F) return 1;
+            if (count <= std::numeric_limits<uint8_t>::max()) return 2;
+            if (count <= std::numeric_limits<uint16_t>::max()) return 3;
+            return 5;
+        }
+
+        // Marker, size field and tag byte of a structure header: 2 (tiny), 3 or 4 (STRUCT_16).
+        // Callers reject more than 0xFFFF fields before encoding.
+        inline size_t packed_structure_header_size(size_t field_count) {
+            if (field_count <= 0x0F) return 2;
+            if (field_count <= std::numeric_limits<uint8_t>::max()) return 3;
+            return 4;
+        }
+
+    }  // namespace detail
+}  // namespace boltprotocol
+
+#endif  // BOLT_PROTOCOL_IMPL_DETAIL_PACKSTREAM_SIZE_UTILS_H
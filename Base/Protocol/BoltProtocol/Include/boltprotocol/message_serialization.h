@@ -27,6 +27,26 @@ namespace boltprotocol {
     BoltError serialize_logon_message(const LogonMessageParams& params, PackStreamWriter& writer);
     BoltError serialize_logoff_message(PackStreamWriter& writer);
 
+    // --- Pre-encoded RUN (prepared query templates) ---
+    // The static parts of a RUN message: the structure header, the encoded query string and the
+    // encoded parameter names (in std::map order). Executions only encode the parameter values.
+    struct PreparedRunTemplate {
+        std::string cypher_query;
+        std::vector<std::string> parameter_names;
+        std::vector<uint8_t> header_bytes;  // RUN structure marker + tag + encoded query string
+        std::vector<std::vector<uint8_t>> encoded_parameter_names;
+        size_t encoded_parameter_names_size = 0;
+    };
+
+    BoltError prepare_run_template(const std::string& cypher_query, const std::map<std::string, Value>& parameters, PreparedRunTemplate& out_template);
+    // True if `parameters` has exactly the template's parameter names.
+    bool run_template_matches(const PreparedRunTemplate& run_template, const std::map<std::string, Value>& parameters);
+    // Writes only RUN field 3 (the extra map); its bytes can be cached while the inputs are unchanged.
+    BoltError serialize_run_extra_map(const RunMessageParams& params, PackStreamWriter& writer, const versions::Version& target_bolt_version);
+    // Appends a complete RUN message to `out_buffer`, byte-identical to serialize_run_message.
+    // `encoded_extra_map` must come from serialize_run_extra_map.
+    BoltError serialize_run_message_prepared(const PreparedRunTemplate& run_template, const std::map<std::string, Value>& parameters, const std::vector<uint8_t>& encoded_extra_map, std::vector<uint8_t>& out_buffer);
+
     // --- Server Message Deserialization (Server -> Client) ---
     BoltError deserialize_success_message(PackStreamReader& reader, SuccessMessageParams& out_params);
     BoltError deserialize_failure_message(PackStreamReader& reader, FailureMessageParams& out_params);
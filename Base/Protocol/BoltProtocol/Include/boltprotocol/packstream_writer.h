@@ -25,6 +25,9 @@ namespace boltprotocol {
         PackStreamWriter(PackStreamWriter&&) = delete;
         PackStreamWriter& operator=(PackStreamWriter&&) = delete;
 
+        // List/map/structure 的最大嵌套深度，packed_size 使用同一上限
+        static constexpr uint32_t MAX_RECURSION_DEPTH = 100;  // 与 Reader 保持一致
+
         /**
          * @brief Writes a single PackStream Value to the output.
          * @param value The Value to serialize and write.
@@ -44,6 +47,10 @@ namespace boltprotocol {
         }
 
       private:
+        // Vector targets: sizes the value with packed_size, grows the buffer once and encodes
+        // through a raw cursor. Used for top-level writes; the buffer is restored on failure.
+        BoltError write_to_buffer_fast(const Value& value);
+
         // 底层IO辅助函数, 它们会设置 error_state_
         BoltError append_byte(uint8_t byte);
         BoltError append_bytes(const void* data, size_t size);
@@ -97,10 +104,20 @@ namespace boltprotocol {
         BoltError error_state_ = BoltError::SUCCESS;
 
         // 递归深度计数器
-        static constexpr uint32_t MAX_RECURSION_DEPTH = 100;  // 与 Reader 保持一致
         uint32_t current_recursion_depth_ = 0;
     };
 
+    /**
+     * @brief Computes the exact number of bytes PackStreamWriter::write would emit for a Value.
+     *        Walks the value without allocating; null shared_ptr members count as PackStream NULL.
+     *        Values that the writer would reject (e.g. oversized structures) are still sized by
+     *        their nominal encoding, so callers must not rely on this for validation.
+     * @param out_size Receives the encoded size; 0 on failure.
+     * @return BoltError::SUCCESS, or BoltError::RECURSION_DEPTH_EXCEEDED if lists, maps and
+     *         structures nest deeper than PackStreamWriter::MAX_RECURSION_DEPTH.
+     */
+    BoltError packed_size(const Value& value, size_t& out_size);
+
 }  // namespace boltprotocol
 
 #endif  // BOLT_PROTOCOL_IMPL_PACKSTREAM_WRITER_H
\ No newline at end of file
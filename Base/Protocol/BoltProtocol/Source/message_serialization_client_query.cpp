@@ -11,6 +11,76 @@
 
 namespace boltprotocol {
 
+    static void populate_run_extra_map(const RunMessageParams& params, const versions::Version& target_bolt_version, std::map<std::string, Value>& extra_pairs) {
+        // Populate extra_pairs from params based on target_bolt_version
+        if (target_bolt_version.major >= 3) {  // Bookmarks, tx_timeout, tx_metadata, mode introduced in Bolt 3
+            if (params.bookmarks.has_value() && !params.bookmarks.value().empty()) {
+                auto bookmarks_list_sptr = std::make_shared<BoltList>();
+                for (const auto& bm : params.bookmarks.value()) {
+                    bookmarks_list_sptr->elements.emplace_back(Value(bm));
+                }
+                extra_pairs.emplace("bookmarks", Value(bookmarks_list_sptr));
+            }
+            if (params.tx_timeout.has_value()) {
+                extra_pairs.emplace("tx_timeout", Value(params.tx_timeout.value()));
+            }
+            if (params.tx_metadata.has_value() && !params.tx_metadata.value().empty()) {
+                auto tx_meta_map_sptr = std::make_shared<BoltMap>();
+                tx_meta_map_sptr->pairs = params.tx_metadata.value();
+                extra_pairs.emplace("tx_metadata", Value(tx_meta_map_sptr));
+            }
+            if (params.mode.has_value()) {
+                extra_pairs.emplace("mode", Value(params.mode.value()));
+            }
+        }
+
+        if (target_bolt_version.major >= 4) {  // db introduced in Bolt 4.0
+            if (params.db.has_value()) {
+                extra_pairs.emplace("db", Value(params.db.value()));
+            }
+        }
+
+        if (target_bolt_version.major > 4 || (target_bolt_version.major == 4 && target_bolt_version.minor >= 4)) {  // imp_user for RUN introduced in Bolt 4.4
+            if (params.imp_user.has_value()) {
+                extra_pairs.emplace("imp_user", Value(params.imp_user.value()));
+            }
+        }
+
+        if (target_bolt_version.major > 5 || (target_bolt_version.major == 5 && target_bolt_version.minor >= 2)) {  // notifications introduced in Bolt 5.2
+            if (params.notifications_min_severity.has_value()) {
+                extra_pairs.emplace("notifications_minimum_severity", Value(params.notifications_min_severity.value()));
+            }
+            if (params.notifications_disabled_categories.has_value() && !params.notifications_disabled_categories.value().empty()) {
+                auto disabled_cat_list_sptr = std::make_shared<BoltList>();
+                for (const auto& cat : params.notifications_disabled_categories.value()) {
+                    disabled_cat_list_sptr->elements.emplace_back(Value(cat));
+                }
+                extra_pairs.emplace("notifications_disabled_categories", Value(disabled_cat_list_sptr));
+            }
+        }
+
+        // Add other custom fields
+        for (const auto& field_pair : params.other_extra_fields) {
+            extra_pairs.emplace(field_pair.first, field_pair.second);
+        }
+    }
+
+    BoltError serialize_run_extra_map(const RunMessageParams& params, PackStreamWriter& writer, const versions::Version& target_bolt_version) {
+        if (writer.has_error()) return writer.get_error();
+        std::shared_ptr<BoltMap> extra_map_sptr;
+        try {
+            extra_map_sptr = std::make_shared<BoltMap>();
+            populate_run_extra_map(params, target_bolt_version, extra_map_sptr->pairs);
+        } catch (const std::bad_alloc&) {
+            writer.set_error(BoltError::OUT_OF_MEMORY);
+            return BoltError::OUT_OF_MEMORY;
+        } catch (const std::exception& e_std) {
+            writer.set_error(BoltError::UNKNOWN_ERROR);
+            return BoltError::UNKNOWN_ERROR;
+        }
+        return writer.write(Value(std::move(extra_map_sptr)));
+    }
+
     BoltError serialize_run_message(const RunMessageParams& params, PackStreamWriter& writer, const versions::Version& target_bolt_version) {
         if (writer.has_error()) return writer.get_error();
         PackStreamStructure run_struct_obj;
@@ -32,57 +102,7 @@ namespace boltprotocol {
             extra_map_sptr = std::make_shared<BoltMap>();
             auto& extra_pairs = extra_map_sptr->pairs;
 
-            // Populate extra_pairs from params based on target_bolt_version
-            if (target_bolt_version.major >= 3) {  // Bookmarks, tx_timeout, tx_metadata, mode introduced in Bolt 3
-                if (params.bookmarks.has_value() && !params.bookmarks.value().empty()) {
-                    auto bookmarks_list_sptr = std::make_shared<BoltList>();
-                    for (const auto& bm : params.bookmarks.value()) {
-                        bookmarks_list_sptr->elements.emplace_back(Value(bm));
-                    }
-                    extra_pairs.emplace("bookmarks", Value(bookmarks_list_sptr));
-                }
-                if (params.tx_timeout.has_value()) {
-                    extra_pairs.emplace("tx_timeout", Value(params.tx_timeout.value()));
-                }
-                if (params.tx_metadata.has_value() && !params.tx_metadata.value().empty()) {
-                    auto tx_meta_map_sptr = std::make_shared<BoltMap>();
-                    tx_meta_map_sptr->pairs = params.tx_metadata.value();
-                    extra_pairs.emplace("tx_metadata", Value(tx_meta_map_sptr));
-                }
-                if (params.mode.has_value()) {
-                    extra_pairs.emplace("mode", Value(params.mode.value()));
-                }
-            }
-
-            if (target_bolt_version.major >= 4) {  // db introduced in Bolt 4.0
-                if (params.db.has_value()) {
-                    extra_pairs.emplace("db", Value(params.db.value()));
-                }
-            }
-
-            if (target_bolt_version.major > 4 || (target_bolt_version.major == 4 && target_bolt_version.minor >= 4)) {  // imp_user for RUN introduced in Bolt 4.4
-                if (params.imp_user.has_value()) {
-                    extra_pairs.emplace("imp_user", Value(params.imp_user.value()));
-                }
-            }
-
-            if (target_bolt_version.major > 5 || (target_bolt_version.major == 5 && target_bolt_version.minor >= 2)) {  // notifications introduced in Bolt 5.2
-                if (params.notifications_min_severity.has_value()) {
-                    extra_pairs.emplace("notifications_minimum_severity", Value(params.notifications_min_severity.value()));
-                }
-                if (params.notifications_disabled_categories.has_value() && !params.notifications_disabled_categories.value().empty()) {
-                    auto disabled_cat_list_sptr = std::make_shared<BoltList>();
-                    for (const auto& cat : params.notifications_disabled_categories.value()) {
-                        disabled_cat_list_sptr->elements.emplace_back(Value(cat));
-                    }
-                    extra_pairs.emplace("notifications_disabled_categories", Value(disabled_cat_list_sptr));
-                }
-            }
-
-            // Add other custom fields
-            for (const auto& field_pair : params.other_extra_fields) {
-                extra_pairs.emplace(field_pair.first, field_pair.second);
-            }
+            populate_run_extra_map(params, target_bolt_version, extra_pairs);
 
             run_struct_obj.fields.emplace_back(Value(extra_map_sptr));
 
@@ -0,0 +1,116 @@
+#include <exception>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "boltprotocol/detail/byte_order_utils.h"
+#include "boltprotocol/message_defs.h"
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_constants.h"
+#include "boltprotocol/packstream_writer.h"
+
+namespace boltprotocol {
+
+    namespace {
+        // RUN always carries three fields: query, parameters, extra.
+        constexpr uint8_t RUN_FIELD_COUNT = 3;
+
+        void append_map_header(size_t entry_count, std::vector<uint8_t>& out) {
+            if (entry_count <= 0x0F) {
+                out.push_back(static_cast<uint8_t>(MARKER_TINY_MAP_BASE | entry_count));
+            } else if (entry_count <= 0xFF) {
+                out.push_back(MARKER_MAP_8);
+                out.push_back(static_cast<uint8_t>(entry_count));
+            } else if (entry_count <= 0xFFFF) {
+                out.push_back(MARKER_MAP_16);
+                uint16_t be_size = detail::host_to_be(static_cast<uint16_t>(entry_count));
+                const auto* p = reinterpret_cast<const uint8_t*>(&be_size);
+                out.insert(out.end(), p, p + sizeof(be_size));
+            } else {
+                out.push_back(MARKER_MAP_32);
+                uint32_t be_size = detail::host_to_be(static_cast<uint32_t>(entry_count));
+                const auto* p = reinterpret_cast<const uint8_t*>(&be_size);
+                out.insert(out.end(), p, p + sizeof(be_size));
+            }
+        }
+    }  // namespace
+
+    BoltError prepare_run_template(const std::string& cypher_query, const std::map<std::string, Value>& parameters, PreparedRunTemplate& out_template) {
+        try {
+            PreparedRunTemplate prepared;
+            prepared.cypher_query = cypher_query;
+            prepared.header_bytes.push_back(static_cast<uint8_t>(MARKER_TINY_STRUCT_BASE | RUN_FIELD_COUNT));
+            prepared.header_bytes.push_back(static_cast<uint8_t>(MessageTag::RUN));
+            PackStreamWriter header_writer(prepared.header_bytes);
+            BoltError err = header_writer.write(Value(cypher_query));
+            if (err != BoltError::SUCCESS) return err;
+
+            prepared.parameter_names.reserve(parameters.size());
+            prepared.encoded_parameter_names.reserve(parameters.size());
+            for (const auto& [name, value] : parameters) {
+                (void)value;
+                std::vector<uint8_t> encoded_name;
+                PackStreamWriter name_writer(encoded_name);
+                err = name_writer.write(Value(name));
+                if (err != BoltError::SUCCESS) return err;
+                prepared.encoded_parameter_names_size += encoded_name.size();
+                prepared.parameter_names.push_back(name);
+                prepared.encoded_parameter_names.push_back(std::move(encoded_name));
+            }
+            out_template = std::move(prepared);
+        } catch (const std::bad_alloc&) {
+            return BoltError::OUT_OF_MEMORY;
+        } catch (const std::exception&) {
+            return BoltError::UNKNOWN_ERROR;
+        }
+        return BoltError::SUCCESS;
+    }
+
+    bool run_template_matches(const PreparedRunTemplate& run_template, const std::map<std::string, Value>& parameters) {
+        if (run_template.parameter_names.size() != parameters.size()) return false;
+        size_t i = 0;
+        for (const auto& [name, value] : parameters) {
+            (void)value;
+            if (run_template.parameter_names[i++] != name) return false;
+        }
+        return true;
+    }
+
+    BoltError serialize_run_message_prepared(const PreparedRunTemplate& run_template, const std::map<std::string, Value>& parameters, const std::vector<uint8_t>& encoded_extra_map, std::vector<uint8_t>& out_buffer) {
+        if (!run_template_matches(run_template, parameters)) {
+            return BoltError::INVALID_ARGUMENT;
+        }
+        try {
+            size_t values_size = 0;
+            for (const auto& [name, value] : parameters) {
+                (void)name;
+                size_t value_size = 0;
+                BoltError size_err = packed_size(value, value_size);
+                if (size_err != BoltError::SUCCESS) return size_err;
+                values_size += value_size;
+            }
+            out_buffer.reserve(out_buffer.size() + run_template.header_bytes.size() + 5 + run_template.encoded_parameter_names_size + values_size + encoded_extra_map.size());
+
+            out_buffer.insert(out_buffer.end(), run_template.header_bytes.begin(), run_template.header_bytes.end());
+            append_map_header(parameters.size(), out_buffer);
+
+            PackStreamWriter value_writer(out_buffer);
+            size_t i = 0;
+            for (const auto& [name, value] : parameters) {
+                (void)name;
+                const auto& encoded_name = run_template.encoded_parameter_names[i++];
+                out_buffer.insert(out_buffer.end(), encoded_name.begin(), encoded_name.end());
+                BoltError err = value_writer.write(value);
+                if (err != BoltError::SUCCESS) return err;
+            }
+
+            out_buffer.insert(out_buffer.end(), encoded_extra_map.begin(), encoded_extra_map.end());
+        } catch (const std::bad_alloc&) {
+            return BoltError::OUT_OF_MEMORY;
+        } catch (const std::exception&) {
+            return BoltError::UNKNOWN_ERROR;
+        }
+        return BoltError::SUCCESS;
+    }
+
+}  // namespace boltprotocol
@@ -97,6 +97,9 @@ namespace boltprotocol {
 
     BoltError PackStreamWriter::write(const Value& value) {
         if (has_error()) return error_state_;  // Already in error
+        if (buffer_ptr_ && current_recursion_depth_ == 0) {
+            return write_to_buffer_fast(value);
+        }
 
         // Visitor lambda to dispatch to internal type-specific writers
         auto visitor = [&](const auto& arg) -> BoltError {
@@ -5,6 +5,7 @@
 #include <string>  // For map keys
 #include <vector>
 
+#include "boltprotocol/detail/packstream_size_utils.h"
 #include "boltprotocol/message_defs.h"  // For BoltList, BoltMap, Value
 #include "boltprotocol/packstream_writer.h"
 
@@ -14,17 +15,22 @@ namespace boltprotocol {
         if (has_error()) return error_state_;
         BoltError err = BoltError::SUCCESS;
 
-        if (size <= 0x0F) {  // Tiny List
-            err = append_byte(MARKER_TINY_LIST_BASE | static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint8_t>::max()) {
-            err = append_byte(MARKER_LIST_8);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint16_t>::max()) {
-            err = append_byte(MARKER_LIST_16);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
-        } else {  // LIST_32
-            err = append_byte(MARKER_LIST_32);
-            if (err == BoltError::SUCCESS) err = append_network_int(size);
+        switch (detail::packed_collection_header_size(size)) {
+            case 1:  // Tiny List
+                err = append_byte(MARKER_TINY_LIST_BASE | static_cast<uint8_t>(size));
+                break;
+            case 2:
+                err = append_byte(MARKER_LIST_8);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
+                break;
+            case 3:
+                err = append_byte(MARKER_LIST_16);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
+                break;
+            default:
+                err = append_byte(MARKER_LIST_32);
+                if (err == BoltError::SUCCESS) err = append_network_int(size);
+                break;
         }
         return err;
     }
@@ -65,17 +71,22 @@ namespace boltprotocol {
         if (has_error()) return error_state_;
         BoltError err = BoltError::SUCCESS;
 
-        if (size <= 0x0F) {  // Tiny Map
-            err = append_byte(MARKER_TINY_MAP_BASE | static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint8_t>::max()) {
-            err = append_byte(MARKER_MAP_8);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint16_t>::max()) {
-            err = append_byte(MARKER_MAP_16);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
-        } else {  // MAP_32
-            err = append_byte(MARKER_MAP_32);
-            if (err == BoltError::SUCCESS) err = append_network_int(size);
+        switch (detail::packed_collection_header_size(size)) {
+            case 1:  // Tiny Map
+                err = append_byte(MARKER_TINY_MAP_BASE | static_cast<uint8_t>(size));
+                break;
+            case 2:
+                err = append_byte(MARKER_MAP_8);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
+                break;
+            case 3:
+                err = append_byte(MARKER_MAP_16);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
+                break;
+            default:
+                err = append_byte(MARKER_MAP_32);
+                if (err == BoltError::SUCCESS) err = append_network_int(size);
+                break;
         }
         return err;
     }
@@ -0,0 +1,235 @@
+#include <cstring>    // For memcpy
+#include <exception>  // For std::bad_alloc
+#include <limits>     // For std::numeric_limits
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "boltprotocol/detail/packstream_size_utils.h"
+#include "boltprotocol/message_defs.h"
+#include "boltprotocol/packstream_writer.h"
+
+namespace boltprotocol {
+
+    namespace {
+        // Encodes into memory that was already sized by packed_size. Each value checks the room
+        // it needs once, up front, and then stores its marker, size field and payload unchecked.
+        class RawBufferEncoder {
+          public:
+            RawBufferEncoder(uint8_t* begin, uint8_t* end, uint32_t max_depth) : pos_(begin), end_(end), max_depth_(max_depth) {
+            }
+
+            BoltError encode(const Value& value, uint32_t depth) {
+                return std::visit(
+                    [&](const auto& arg) -> BoltError {
+                        using T = std::decay_t<decltype(arg)>;
+                        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                            return put_marker(MARKER_NULL);
+                        } else if constexpr (std::is_same_v<T, bool>) {
+                            return put_marker(arg ? MARKER_TRUE : MARKER_FALSE);
+                        } else if constexpr (std::is_same_v<T, int64_t>) {
+                            return encode_integer(arg);
+                        } else if constexpr (std::is_same_v<T, double>) {
+                            if (!has_room(9)) return BoltError::SERIALIZATION_ERROR;
+                            uint64_t bits;
+                            static_assert(sizeof(double) == sizeof(uint64_t), "Double is not 64-bit.");
+                            std::memcpy(&bits, &arg, sizeof(bits));
+                            *pos_++ = MARKER_FLOAT64;
+                            put_be(bits);
+                            return BoltError::SUCCESS;
+                        } else if constexpr (std::is_same_v<T, std::string>) {
+                            return encode_string(arg);
+                        } else if constexpr (std::is_same_v<T, std::shared_ptr<BoltList>>) {
+                            if (!arg) return put_marker(MARKER_NULL);
+                            return encode_list(*arg, depth);
+                        } else if constexpr (std::is_same_v<T, std::shared_ptr<BoltMap>>) {
+                            if (!arg) return put_marker(MARKER_NULL);
+                            return encode_map(*arg, depth);
+                        } else if constexpr (std::is_same_v<T, std::shared_ptr<PackStreamStructure>>) {
+                            if (!arg) return put_marker(MARKER_NULL);
+                            return encode_structure(*arg, depth);
+                        } else {
+                            return BoltError::SERIALIZATION_ERROR;
+                        }
+                    },
+                    value);
+            }
+
+            uint8_t* position() const {
+                return pos_;
+            }
+
+          private:
+            bool has_room(size_t size) const {
+                return static_cast<size_t>(end_ - pos_) >= size;
+            }
+
+            template <typename U>
+            void put_be(U value) {
+                U be_value = detail::host_to_be(value);
+                std::memcpy(pos_, &be_value, sizeof(be_value));
+                pos_ += sizeof(be_value);
+            }
+
+            BoltError put_marker(uint8_t marker) {
+                if (!has_room(1)) return BoltError::SERIALIZATION_ERROR;
+                *pos_++ = marker;
+                return BoltError::SUCCESS;
+            }
+
+            // Writes a string/list/map header; the caller has already checked room for it.
+            void put_collection_header(size_t size, uint8_t tiny_base, uint8_t marker_8, uint8_t marker_16, uint8_t marker_32) {
+                switch (detail::packed_collection_header_size(size)) {
+                    case 1:
+                        *pos_++ = static_cast<uint8_t>(tiny_base | size);
+                        break;
+                    case 2:
+                        *pos_++ = marker_8;
+                        *pos_++ = static_cast<uint8_t>(size);
+                        break;
+                    case 3:
+                        *pos_++ = marker_16;
+                        put_be(static_cast<uint16_t>(size));
+                        break;
+                    default:
+                        *pos_++ = marker_32;
+                        put_be(static_cast<uint32_t>(size));
+                        break;
+                }
+            }
+
+            BoltError encode_integer(int64_t int_value) {
+                const size_t size = detail::packed_integer_size(int_value);
+                if (!has_room(size)) return BoltError::SERIALIZATION_ERROR;
+                switch (size) {
+                    case 1:  // Tiny Int
+                        *pos_++ = static_cast<uint8_t>(int_value);
+                        break;
+                    case 2:
+                        *pos_++ = MARKER_INT_8;
+                        *pos_++ = static_cast<uint8_t>(static_cast<int8_t>(int_value));
+                        break;
+                    case 3:
+                        *pos_++ = MARKER_INT_16;
+                        put_be(static_cast<uint16_t>(static_cast<int16_t>(int_value)));
+                        break;
+                    case 5:
+                        *pos_++ = MARKER_INT_32;
+                        put_be(static_cast<uint32_t>(static_cast<int32_t>(int_value)));
+                        break;
+                    default:
+                        *pos_++ = MARKER_INT_64;
+                        put_be(static_cast<uint64_t>(int_value));
+                        break;
+                }
+                return BoltError::SUCCESS;
+            }
+
+            BoltError encode_string(const std::string& str_value) {
+                const size_t len = str_value.size();
+                if (len > std::numeric_limits<uint32_t>::max()) return BoltError::SERIALIZATION_ERROR;
+                if (!has_room(detail::packed_collection_header_size(len) + len)) return BoltError::SERIALIZATION_ERROR;
+                put_collection_header(len, MARKER_TINY_STRING_BASE, MARKER_STRING_8, MARKER_STRING_16, MARKER_STRING_32);
+                if (len > 0) {
+                    std::memcpy(pos_, str_value.data(), len);
+                    pos_ += len;
+                }
+                return BoltError::SUCCESS;
+            }
+
+            BoltError encode_list(const BoltList& list_data, uint32_t depth) {
+                const size_t count = list_data.elements.size();
+                if (count > std::numeric_limits<uint32_t>::max()) return BoltError::SERIALIZATION_ERROR;
+                if (depth >= max_depth_) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                if (!has_room(detail::packed_collection_header_size(count))) return BoltError::SERIALIZATION_ERROR;
+                put_collection_header(count, MARKER_TINY_LIST_BASE, MARKER_LIST_8, MARKER_LIST_16, MARKER_LIST_32);
+                for (const auto& item : list_data.elements) {
+                    BoltError err = encode(item, depth + 1);
+                    if (err != BoltError::SUCCESS) return err;
+                }
+                return BoltError::SUCCESS;
+            }
+
+            BoltError encode_map(const BoltMap& map_data, uint32_t depth) {
+                const size_t count = map_data.pairs.size();
+                if (count > std::numeric_limits<uint32_t>::max()) return BoltError::SERIALIZATION_ERROR;
+                if (depth >= max_depth_) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                if (!has_room(detail::packed_collection_header_size(count))) return BoltError::SERIALIZATION_ERROR;
+                put_collection_header(count, MARKER_TINY_MAP_BASE, MARKER_MAP_8, MARKER_MAP_16, MARKER_MAP_32);
+                for (const auto& pair : map_data.pairs) {
+                    BoltError err = encode_string(pair.first);
+                    if (err != BoltError::SUCCESS) return err;
+                    err = encode(pair.second, depth + 1);
+                    if (err != BoltError::SUCCESS) return err;
+                }
+                return BoltError::SUCCESS;
+            }
+
+            BoltError encode_structure(const PackStreamStructure& struct_data, uint32_t depth) {
+                const size_t count = struct_data.fields.size();
+                if (count > std::numeric_limits<uint16_t>::max()) return BoltError::SERIALIZATION_ERROR;
+                if (depth >= max_depth_) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                const size_t header_size = detail::packed_structure_header_size(count);
+                if (!has_room(header_size)) return BoltError::SERIALIZATION_ERROR;
+                switch (header_size) {
+                    case 2:
+                        *pos_++ = static_cast<uint8_t>(MARKER_TINY_STRUCT_BASE | count);
+                        break;
+                    case 3:
+                        *pos_++ = MARKER_STRUCT_8;
+                        *pos_++ = static_cast<uint8_t>(count);
+                        break;
+                    default:
+                        *pos_++ = MARKER_STRUCT_16;
+                        put_be(static_cast<uint16_t>(count));
+                        break;
+                }
+                *pos_++ = struct_data.tag;
+                for (const auto& field : struct_data.fields) {
+                    BoltError err = encode(field, depth + 1);
+                    if (err != BoltError::SUCCESS) return err;
+                }
+                return BoltError::SUCCESS;
+            }
+
+            uint8_t* pos_;
+            uint8_t* end_;
+            uint32_t max_depth_;
+        };
+    }  // namespace
+
+    BoltError PackStreamWriter::write_to_buffer_fast(const Value& value) {
+        std::vector<uint8_t>& buffer = *buffer_ptr_;
+        const size_t start_size = buffer.size();
+        size_t value_size = 0;
+        BoltError size_err = packed_size(value, value_size);
+        if (size_err != BoltError::SUCCESS) {
+            set_error(size_err);
+            return error_state_;
+        }
+
+        try {
+            buffer.resize(start_size + value_size);  // Single allocation for the whole value tree
+        } catch (const std::bad_alloc&) {
+            set_error(BoltError::OUT_OF_MEMORY);
+            return error_state_;
+        } catch (const std::exception&) {
+            set_error(BoltError::UNKNOWN_ERROR);
+            return error_state_;
+        }
+
+        RawBufferEncoder encoder(buffer.data() + start_size, buffer.data() + buffer.size(), MAX_RECURSION_DEPTH);
+        BoltError err = encoder.encode(value, 0);
+        if (err == BoltError::SUCCESS && encoder.position() != buffer.data() + buffer.size()) {
+            err = BoltError::SERIALIZATION_ERROR;  // packed_size and the encoder disagree
+        }
+        if (err != BoltError::SUCCESS) {
+            buffer.resize(start_size);
+            set_error(err);
+            return error_state_;
+        }
+        return BoltError::SUCCESS;
+    }
+
+}  // namespace boltprotocol
@@ -2,6 +2,7 @@
 #include <exception>  // For std::bad_alloc (though less direct here)
 #include <limits>     // For std::numeric_limits
 
+#include "boltprotocol/detail/packstream_size_utils.h"
 #include "boltprotocol/message_defs.h"       // For BoltError (though packstream_writer.h includes it)
 #include "boltprotocol/packstream_writer.h"  // For PackStreamWriter class declaration and constants
 // byte_order_utils.h is included via packstream_writer.h -> detail/byte_order_utils.h
@@ -22,20 +23,26 @@ namespace boltprotocol {
         if (has_error()) return error_state_;
         BoltError err = BoltError::SUCCESS;  // Initialize err
 
-        if (int_value >= -16 && int_value <= 127) {  // Tiny Int
-            err = append_byte(static_cast<uint8_t>(int_value));
-        } else if (int_value >= std::numeric_limits<int8_t>::min() && int_value <= std::numeric_limits<int8_t>::max()) {
-            err = append_byte(MARKER_INT_8);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int8_t>(int_value));
-        } else if (int_value >= std::numeric_limits<int16_t>::min() && int_value <= std::numeric_limits<int16_t>::max()) {
-            err = append_byte(MARKER_INT_16);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int16_t>(int_value));
-        } else if (int_value >= std::numeric_limits<int32_t>::min() && int_value <= std::numeric_limits<int32_t>::max()) {
-            err = append_byte(MARKER_INT_32);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int32_t>(int_value));
-        } else {  // INT_64
-            err = append_byte(MARKER_INT_64);
-            if (err == BoltError::SUCCESS) err = append_network_int(int_value);
+        switch (detail::packed_integer_size(int_value)) {
+            case 1:  // Tiny Int
+                err = append_byte(static_cast<uint8_t>(int_value));
+                break;
+            case 2:
+                err = append_byte(MARKER_INT_8);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int8_t>(int_value));
+                break;
+            case 3:
+                err = append_byte(MARKER_INT_16);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int16_t>(int_value));
+                break;
+            case 5:
+                err = append_byte(MARKER_INT_32);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<int32_t>(int_value));
+                break;
+            default:  // INT_64
+                err = append_byte(MARKER_INT_64);
+                if (err == BoltError::SUCCESS) err = append_network_int(int_value);
+                break;
         }
         return err;  // Return the result of the last append operation
     }
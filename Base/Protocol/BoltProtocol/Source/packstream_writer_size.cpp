@@ -0,0 +1,78 @@
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "boltprotocol/detail/packstream_size_utils.h"
+#include "boltprotocol/message_defs.h"
+#include "boltprotocol/packstream_writer.h"
+
+namespace boltprotocol {
+
+    namespace {
+        size_t string_size(const std::string& str_value) {
+            return detail::packed_collection_header_size(str_value.size()) + str_value.size();
+        }
+
+        // Nesting is bounded like PackStreamWriter::write so a deep or cyclic value fails
+        // with RECURSION_DEPTH_EXCEEDED instead of exhausting the stack.
+        BoltError add_packed_size(const Value& value, uint32_t depth, size_t& total) {
+            return std::visit(
+                [&](const auto& arg) -> BoltError {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, bool>) {
+                        total += 1;
+                    } else if constexpr (std::is_same_v<T, int64_t>) {
+                        total += detail::packed_integer_size(arg);
+                    } else if constexpr (std::is_same_v<T, double>) {
+                        total += 9;
+                    } else if constexpr (std::is_same_v<T, std::string>) {
+                        total += string_size(arg);
+                    } else if constexpr (std::is_same_v<T, std::shared_ptr<BoltList>>) {
+                        if (!arg) {
+                            total += 1;
+                            return BoltError::SUCCESS;
+                        }
+                        if (depth >= PackStreamWriter::MAX_RECURSION_DEPTH) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                        total += detail::packed_collection_header_size(arg->elements.size());
+                        for (const auto& item : arg->elements) {
+                            BoltError err = add_packed_size(item, depth + 1, total);
+                            if (err != BoltError::SUCCESS) return err;
+                        }
+                    } else if constexpr (std::is_same_v<T, std::shared_ptr<BoltMap>>) {
+                        if (!arg) {
+                            total += 1;
+                            return BoltError::SUCCESS;
+                        }
+                        if (depth >= PackStreamWriter::MAX_RECURSION_DEPTH) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                        total += detail::packed_collection_header_size(arg->pairs.size());
+                        for (const auto& pair : arg->pairs) {
+                            total += string_size(pair.first);
+                            BoltError err = add_packed_size(pair.second, depth + 1, total);
+                            if (err != BoltError::SUCCESS) return err;
+                        }
+                    } else if constexpr (std::is_same_v<T, std::shared_ptr<PackStreamStructure>>) {
+                        if (!arg) {
+                            total += 1;
+                            return BoltError::SUCCESS;
+                        }
+                        if (depth >= PackStreamWriter::MAX_RECURSION_DEPTH) return BoltError::RECURSION_DEPTH_EXCEEDED;
+                        total += detail::packed_structure_header_size(arg->fields.size());
+                        for (const auto& field : arg->fields) {
+                            BoltError err = add_packed_size(field, depth + 1, total);
+                            if (err != BoltError::SUCCESS) return err;
+                        }
+                    }
+                    return BoltError::SUCCESS;
+                },
+                value);
+        }
+    }  // namespace
+
+    BoltError packed_size(const Value& value, size_t& out_size) {
+        size_t total = 0;
+        BoltError err = add_packed_size(value, 0, total);
+        out_size = err == BoltError::SUCCESS ? total : 0;
+        return err;
+    }
+
+}  // namespace boltprotocol
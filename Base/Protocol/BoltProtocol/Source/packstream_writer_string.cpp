@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>  // For buffer_ptr_ if used (though append_bytes handles it)
 
+#include "boltprotocol/detail/packstream_size_utils.h"
 #include "boltprotocol/message_defs.h"
 #include "boltprotocol/packstream_writer.h"
 
@@ -12,17 +13,22 @@ namespace boltprotocol {
         if (has_error()) return error_state_;
         BoltError err = BoltError::SUCCESS;
 
-        if (size <= 0x0F) {  // Tiny String (0x80 to 0x8F)
-            err = append_byte(MARKER_TINY_STRING_BASE | static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint8_t>::max()) {
-            err = append_byte(MARKER_STRING_8);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
-        } else if (size <= std::numeric_limits<uint16_t>::max()) {
-            err = append_byte(MARKER_STRING_16);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
-        } else {  // STRING_32 (uint32_t max is handled by PackStream spec)
-            err = append_byte(MARKER_STRING_32);
-            if (err == BoltError::SUCCESS) err = append_network_int(size);  // size is already uint32_t
+        switch (detail::packed_collection_header_size(size)) {
+            case 1:  // Tiny String
+                err = append_byte(MARKER_TINY_STRING_BASE | static_cast<uint8_t>(size));
+                break;
+            case 2:
+                err = append_byte(MARKER_STRING_8);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
+                break;
+            case 3:
+                err = append_byte(MARKER_STRING_16);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
+                break;
+            default:
+                err = append_byte(MARKER_STRING_32);
+                if (err == BoltError::SUCCESS) err = append_network_int(size);
+                break;
         }
         return err;
     }
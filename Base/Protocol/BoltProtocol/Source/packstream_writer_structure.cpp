@@ -3,6 +3,7 @@
 #include <memory>     // For std::shared_ptr (used in Value variant)
 #include <vector>
 
+#include "boltprotocol/detail/packstream_size_utils.h"
 #include "boltprotocol/message_defs.h"  // For PackStreamStructure, Value
 #include "boltprotocol/packstream_writer.h"
 
@@ -12,23 +13,26 @@ namespace boltprotocol {
         if (has_error()) return error_state_;
         BoltError err = BoltError::SUCCESS;
 
-        if (size <= 0x0F) {  // Tiny Struct (0xB0 to 0xBF)
-            err = append_byte(MARKER_TINY_STRUCT_BASE | static_cast<uint8_t>(size));
-            if (err == BoltError::SUCCESS) err = append_byte(tag);
-        } else if (size <= std::numeric_limits<uint8_t>::max()) {  // Struct 8
-            err = append_byte(MARKER_STRUCT_8);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
-            if (err == BoltError::SUCCESS) err = append_byte(tag);
-        } else if (size <= std::numeric_limits<uint16_t>::max()) {  // Struct 16
-            err = append_byte(MARKER_STRUCT_16);
-            if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
-            if (err == BoltError::SUCCESS) err = append_byte(tag);
-        } else {
+        if (size > std::numeric_limits<uint16_t>::max()) {
             // PackStream v1 (which Bolt uses) does not define STRUCT_32.
             // Maximum number of fields for a structure is 65535 (0xFFFF).
             set_error(BoltError::SERIALIZATION_ERROR);  // Structure too large for PackStream v1 encoding
             return error_state_;
         }
+        switch (detail::packed_structure_header_size(size)) {
+            case 2:  // Tiny Struct (0xB0 to 0xBF)
+                err = append_byte(MARKER_TINY_STRUCT_BASE | static_cast<uint8_t>(size));
+                break;
+            case 3:  // Struct 8
+                err = append_byte(MARKER_STRUCT_8);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint8_t>(size));
+                break;
+            default:  // Struct 16
+                err = append_byte(MARKER_STRUCT_16);
+                if (err == BoltError::SUCCESS) err = append_network_int(static_cast<uint16_t>(size));
+                break;
+        }
+        if (err == BoltError::SUCCESS) err = append_byte(tag);
         return err;
     }
 
@@ -0,0 +1,116 @@
+#ifndef NEO4J_BOLT_TRANSPORT_ASYNC_QUERY_PIPELINE_H
+#define NEO4J_BOLT_TRANSPORT_ASYNC_QUERY_PIPELINE_H
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boltprotocol/message_defs.h"
+
+namespace neo4j_bolt_transport {
+
+    class AsyncSessionHandle;
+
+    // Buffered outcome of one pipelined query.
+    struct PipelinedQueryResult {
+        std::vector<std::string> field_names;
+        std::vector<boltprotocol::RecordMessageParams> records;
+        boltprotocol::SuccessMessageParams run_summary_raw;
+        boltprotocol::SuccessMessageParams pull_summary_raw;
+        boltprotocol::FailureMessageParams failure_raw;  // Populated when the server reported FAILURE
+        std::string error_message;
+        bool transaction_aborted = false;  // The caller's explicit transaction failed; see reset_async()
+    };
+
+    // Multiplexes independent queries over the single stream of an AsyncSessionHandle.
+    //
+    // Every run_async call appends a RUN + PULL(all) pair to a write queue and returns an awaitable
+    // that completes when that query's replies have been read. One writer coroutine drains the
+    // queue and one reader coroutine dispatches replies strictly in send order, so callers never
+    // wait for each other's round trips, only for their own replies.
+    //
+    // A server FAILURE fails only its own query; queries already queued behind it are IGNORED by the
+    // server and fail too. Outside an explicit transaction a RESET is then queued automatically so
+    // later queries succeed. Inside one the pipeline never resets on its own, since that would
+    // silently roll back the caller's earlier writes: the failed and ignored queries, and every
+    // later run_async call, report transaction_aborted until the caller calls reset_async(), which
+    // rolls the transaction back and clears the session's transaction state.
+    // Network errors fail every outstanding query and close the stream.
+    //
+    // Must be created via std::make_shared. The session must outlive the pipeline and must not be
+    // used for anything else while queries are outstanding.
+    class AsyncQueryPipeline : public std::enable_shared_from_this<AsyncQueryPipeline> {
+      public:
+        explicit AsyncQueryPipeline(AsyncSessionHandle& session, size_t max_queries_in_flight = 64);
+
+        AsyncQueryPipeline(const AsyncQueryPipeline&) = delete;
+        AsyncQueryPipeline& operator=(const AsyncQueryPipeline&) = delete;
+
+        boost::asio::awaitable<std::pair<boltprotocol::BoltError, PipelinedQueryResult>> run_async(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters = {});
+
+        // Queues a RESET behind the outstanding queries and waits for it. Rolls back any open
+        // explicit transaction and clears a transaction_aborted state.
+        boost::asio::awaitable<std::pair<boltprotocol::BoltError, std::string>> reset_async();
+
+        size_t queries_in_flight() const {
+            return queries_in_flight_;
+        }
+        bool is_broken() const {
+            return broken_;
+        }
+        bool is_transaction_aborted() const {
+            return transaction_aborted_;
+        }
+
+      private:
+        struct PendingRequest {
+            enum class Kind { QUERY, RESET };
+
+            PendingRequest(Kind k, const boost::asio::any_io_executor& executor);
+
+            Kind kind;
+            boost::asio::steady_timer done_signal;  // Never expires; cancel() wakes the waiter
+            bool completed = false;
+            int summaries_expected;
+            int summaries_received = 0;
+            bool updates_bookmarks = false;
+            bool in_transaction = false;
+            boltprotocol::BoltError error = boltprotocol::BoltError::SUCCESS;
+            PipelinedQueryResult result;
+        };
+
+        static boost::asio::awaitable<void> _write_loop(std::shared_ptr<AsyncQueryPipeline> self);
+        static boost::asio::awaitable<void> _read_loop(std::shared_ptr<AsyncQueryPipeline> self);
+
+        void _enqueue(std::shared_ptr<PendingRequest> request, std::vector<std::vector<uint8_t>> payloads);
+        std::shared_ptr<PendingRequest> _queue_reset();
+        void _complete_front();
+        void _fail_all(boltprotocol::BoltError error, const std::string& message);
+        void _on_static_op_error(boltprotocol::BoltError error, const std::string& message);
+
+        AsyncSessionHandle& session_;
+        size_t max_queries_in_flight_;
+        size_t queries_in_flight_ = 0;
+
+        std::deque<std::shared_ptr<PendingRequest>> awaiting_replies_;  // In send order
+        std::deque<std::vector<uint8_t>> outbox_;
+        bool writer_active_ = false;
+        bool reader_active_ = false;
+        bool reset_queued_ = false;
+        bool transaction_aborted_ = false;  // FAILURE inside an explicit transaction, awaiting reset_async()
+        bool broken_ = false;
+
+        boost::asio::steady_timer capacity_signal_;  // Never expires; cancel() wakes callers waiting for room
+        boltprotocol::BoltError last_io_error_ = boltprotocol::BoltError::SUCCESS;
+        std::string last_io_error_message_;
+    };
+
+}  // namespace neo4j_bolt_transport
+
+#endif  // NEO4J_BOLT_TRANSPORT_ASYNC_QUERY_PIPELINE_H
@@ -12,9 +12,12 @@
 
 #include "async_transaction_context.h"
 #include "boltprotocol/message_defs.h"
+#include "bulk_write.h"
 #include "config/session_parameters.h"
 #include "internal/async_types.h"
+#include "internal/prepared_run_cache.h"
 #include "neo4j_bolt_transport/config/transport_config.h"  // For AsyncTransactionConfigOverrides, if defined here
+#include "record_sink.h"
 #include "result_summary.h"
 
 // Conditional include for OpenSSL headers
@@ -28,6 +31,7 @@ namespace neo4j_bolt_transport {
 
     class Neo4jBoltTransport;
     class AsyncResultStream;
+    class AsyncQueryPipeline;
 
     struct AsyncTransactionConfigOverrides {  // Assuming this is the agreed upon location
         std::optional<std::map<std::string, boltprotocol::Value>> metadata;
@@ -51,6 +55,15 @@ namespace neo4j_bolt_transport {
 
         boost::asio::awaitable<std::pair<boltprotocol::BoltError, std::unique_ptr<AsyncResultStream>>> run_query_stream_async(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters = {});
 
+        // Push-style variant: each RECORD is decoded into a reused buffer and passed to `sink` directly
+        // from the receive loop; no AsyncResultStream or BoltRecord is built. Also usable inside an explicit transaction.
+        boost::asio::awaitable<std::pair<boltprotocol::BoltError, ResultSummary>> run_query_stream_async(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, const RecordSink& sink);
+
+        // Async counterpart of SessionHandle::run_bulk_write: UNWIND batches sized by BulkWriteOptions,
+        // with up to max_batches_in_flight RUN/DISCARD pairs written before the oldest reply is awaited.
+        // A failed write drains the outstanding replies and closes the stream.
+        boost::asio::awaitable<std::pair<boltprotocol::BoltError, BulkWriteResult>> run_bulk_write_async(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options = {});
+
         // --- Explicit Transaction Management ---
         boost::asio::awaitable<boltprotocol::BoltError> begin_transaction_async(const std::optional<AsyncTransactionConfigOverrides>& tx_config = std::nullopt);
 
@@ -88,6 +101,7 @@ namespace neo4j_bolt_transport {
       private:
         friend class AsyncResultStream;
         friend class AsyncTransactionContext;
+        friend class AsyncQueryPipeline;
 
         boost::asio::awaitable<boltprotocol::BoltError> send_goodbye_if_appropriate_async();
         void mark_closed();
@@ -102,6 +116,9 @@ namespace neo4j_bolt_transport {
 
         void _update_bookmarks_from_summary(const boltprotocol::SuccessMessageParams& summary_params);
 
+        // Encodes a complete RUN for the current stream through the session's prepared-query cache.
+        boltprotocol::BoltError _serialize_run_cached(const boltprotocol::RunMessageParams& run_params, std::vector<uint8_t>& out_payload);
+
         Neo4jBoltTransport* transport_manager_;
         config::SessionParameters session_params_;
         std::unique_ptr<internal::ActiveAsyncStreamContext> stream_context_;
@@ -116,6 +133,8 @@ namespace neo4j_bolt_transport {
 
         boltprotocol::BoltError last_error_code_ = boltprotocol::BoltError::SUCCESS;
         std::string last_error_message_;
+
+        internal::PreparedRunCache prepared_run_cache_;
     };
 
 }  // namespace neo4j_bolt_transport
@@ -0,0 +1,94 @@
+#ifndef NEO4J_BOLT_TRANSPORT_BULK_WRITE_H
+#define NEO4J_BOLT_TRANSPORT_BULK_WRITE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "boltprotocol/message_defs.h"
+
+namespace neo4j_bolt_transport {
+
+    // One parameter set of a bulk write. Inside the statement it is visible as `row`,
+    // e.g. "MERGE (p:Person {id: row.id}) SET p.name = row.name".
+    using BulkRow = std::map<std::string, boltprotocol::Value>;
+
+    // Pull-style producer: fills `out_row` and returns true, or returns false once exhausted.
+    // Rows are consumed lazily, so the full input never has to be materialised at once.
+    using BulkRowSource = std::function<bool(BulkRow& out_row)>;
+
+    struct BulkWriteOptions {
+        // Upper bound on the packed size of the rows list of a single batch. A row that on its own
+        // exceeds the budget is still sent, alone in its batch.
+        size_t max_batch_bytes = 1024 * 1024;
+        // Optional upper bound on rows per batch (0 = limited by bytes only).
+        size_t max_batch_rows = 0;
+        // How many RUN/DISCARD pairs may be on the wire before the oldest reply is awaited.
+        size_t max_batches_in_flight = 4;
+        // 0: every batch is its own auto-commit transaction.
+        // N: batches are grouped into explicit transactions of N batches each.
+        // Ignored when the session is already inside an explicit transaction.
+        size_t batches_per_commit = 0;
+        // Name of the list parameter the rows are bound to.
+        std::string rows_parameter = "rows";
+        // Parameters shared by every batch, sent alongside the rows list.
+        std::map<std::string, boltprotocol::Value> shared_parameters;
+    };
+
+    struct BulkWriteResult {
+        uint64_t rows_submitted = 0;
+        uint64_t rows_acknowledged = 0;
+        uint64_t batches_submitted = 0;
+        uint64_t batches_acknowledged = 0;
+        uint64_t transactions_committed = 0;
+    };
+
+    // Convenience source over an in-memory vector; the vector must outlive the write.
+    BulkRowSource make_bulk_row_source(const std::vector<BulkRow>& rows);
+
+    namespace internal {
+
+        // Wraps the per-row statement as "UNWIND $<rows_parameter> AS row <row_cypher>".
+        std::string make_unwind_cypher(const std::string& row_cypher, const std::string& rows_parameter);
+
+        // Cuts a row source into batches under BulkWriteOptions limits, sizing each row with
+        // boltprotocol::packed_size so batches stay below the byte budget without a trial encode.
+        class BulkBatchBuilder {
+          public:
+            explicit BulkBatchBuilder(const BulkWriteOptions& options);
+
+            // Collects the next batch. Returns the number of rows gathered; 0 means the source is drained
+            // or a row could not be encoded, in which case error() says why and the batch is dropped.
+            size_t next_batch(const BulkRowSource& source);
+
+            // Builds the RUN parameters for the current batch (shared parameters + rows list)
+            // and resets the builder for the next batch.
+            std::map<std::string, boltprotocol::Value> take_parameters();
+
+            size_t current_batch_bytes() const {
+                return batch_bytes_;
+            }
+            boltprotocol::BoltError error() const {
+                return error_;
+            }
+
+          private:
+            const BulkWriteOptions& options_;
+            std::shared_ptr<boltprotocol::BoltList> rows_;
+            size_t batch_bytes_ = 0;
+            std::optional<boltprotocol::Value> carry_over_;
+            size_t carry_over_bytes_ = 0;
+            bool source_drained_ = false;
+            boltprotocol::BoltError error_ = boltprotocol::BoltError::SUCCESS;
+        };
+
+    }  // namespace internal
+
+}  // namespace neo4j_bolt_transport
+
+#endif  // NEO4J_BOLT_TRANSPORT_BULK_WRITE_H
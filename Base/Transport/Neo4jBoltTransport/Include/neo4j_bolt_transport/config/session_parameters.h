@@ -1,6 +1,7 @@
 #ifndef NEO4J_BOLT_TRANSPORT_CONFIG_SESSION_PARAMETERS_H
 #define NEO4J_BOLT_TRANSPORT_CONFIG_SESSION_PARAMETERS_H
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <optional>
@@ -25,6 +26,12 @@ namespace neo4j_bolt_transport {
             // Drivers often have a default like 1000.
             int64_t default_fetch_size = 1000;
 
+            // Maximum number of distinct Cypher strings whose RUN encoding is kept pre-encoded
+            // by the session (query bytes + parameter names), least recently used evicted first.
+            // Applies to every RUN of SessionHandle and AsyncSessionHandle, including pipelined
+            // and bulk-write batches. 0 disables the cache.
+            size_t prepared_query_cache_size = 128;
+
             SessionParameters() = default;
 
             static SessionParameters for_database(const std::string& db_name) {
@@ -53,6 +60,10 @@ namespace neo4j_bolt_transport {
                 default_fetch_size = size;
                 return *this;
             }
+            SessionParameters& with_prepared_query_cache_size(size_t size) {
+                prepared_query_cache_size = size;
+                return *this;
+            }
         };
 
     }  // namespace config
@@ -39,6 +39,7 @@ namespace neo4j_bolt_transport {
     class SessionHandle;
     class AsyncSessionHandle;
     class AsyncResultStream;
+    class AsyncQueryPipeline;
 
     namespace internal {
 
@@ -103,6 +104,12 @@ namespace neo4j_bolt_transport {
             using MessageHandler = std::function<boltprotocol::BoltError(boltprotocol::MessageTag tag, const std::vector<uint8_t>& payload, BoltPhysicalConnection& connection)>;
             boltprotocol::BoltError send_request_receive_stream(const std::vector<uint8_t>& request_payload, MessageHandler record_handler, boltprotocol::SuccessMessageParams& out_summary, boltprotocol::FailureMessageParams& out_failure);
             boltprotocol::BoltError send_request_receive_summary(const std::vector<uint8_t>& request_payload, boltprotocol::SuccessMessageParams& out_summary, boltprotocol::FailureMessageParams& out_failure);
+            // Pipelining: queue a request without waiting for its reply, then collect the replies
+            // one summary at a time, in send order. Only summary-only requests (RUN, DISCARD, BEGIN,
+            // COMMIT, ...) may be pipelined this way; RECORD responses are treated as a protocol error.
+            boltprotocol::BoltError send_request_pipelined(const std::vector<uint8_t>& request_payload);
+            boltprotocol::BoltError receive_pipelined_summary(boltprotocol::SuccessMessageParams& out_summary, boltprotocol::FailureMessageParams& out_failure);
+            size_t get_pending_pipelined_responses() const;
             boltprotocol::BoltError perform_reset();
             boltprotocol::BoltError perform_logon(const boltprotocol::LogonMessageParams& logon_params, boltprotocol::SuccessMessageParams& out_success);
             boltprotocol::BoltError perform_logoff(boltprotocol::SuccessMessageParams& out_success);
@@ -116,6 +123,13 @@ namespace neo4j_bolt_transport {
             static boost::asio::awaitable<std::pair<boltprotocol::BoltError, ResultSummary>> send_request_receive_summary_async_static(
                 internal::ActiveAsyncStreamContext& stream_ctx, const std::vector<uint8_t>& request_payload, const BoltConnectionConfig& conn_config_ref, std::shared_ptr<spdlog::logger> logger_ref, std::function<void(boltprotocol::BoltError, const std::string&)> error_handler);
 
+            // Reads the next summary (SUCCESS/FAILURE/IGNORED) without sending anything first; used to
+            // collect replies of requests that were pipelined with _send_chunked_payload_async_static_helper.
+            static boost::asio::awaitable<std::pair<boltprotocol::BoltError, ResultSummary>> receive_summary_async_static(internal::ActiveAsyncStreamContext& stream_ctx,
+                                                                                                                          const BoltConnectionConfig& conn_config_ref,
+                                                                                                                          std::shared_ptr<spdlog::logger> logger_ref,
+                                                                                                                          std::function<void(boltprotocol::BoltError, const std::string&)> error_handler);
+
             static boost::asio::awaitable<boltprotocol::BoltError> send_goodbye_async_static(internal::ActiveAsyncStreamContext& stream_ctx,
                                                                                              const BoltConnectionConfig& conn_config_ref,
                                                                                              std::shared_ptr<spdlog::logger> logger_ref,
@@ -130,6 +144,7 @@ namespace neo4j_bolt_transport {
           private:
             friend class neo4j_bolt_transport::SessionHandle;
             friend class neo4j_bolt_transport::AsyncSessionHandle;
+            friend class neo4j_bolt_transport::AsyncQueryPipeline;
 
             // --- Static Private Asynchronous Chunking Helpers ---
             static boost::asio::awaitable<boltprotocol::BoltError> _send_chunked_payload_async_static_helper(
@@ -217,6 +232,8 @@ namespace neo4j_bolt_transport {
             boltprotocol::BoltError last_error_code_ = boltprotocol::BoltError::SUCCESS;
             std::string last_error_message_;
 
+            size_t pending_pipelined_responses_ = 0;
+
             static std::atomic<uint64_t> next_connection_id_counter_;
         };
 
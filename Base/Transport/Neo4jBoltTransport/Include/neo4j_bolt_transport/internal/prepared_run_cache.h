@@ -0,0 +1,68 @@
+#ifndef NEO4J_BOLT_TRANSPORT_INTERNAL_PREPARED_RUN_CACHE_H
+#define NEO4J_BOLT_TRANSPORT_INTERNAL_PREPARED_RUN_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "boltprotocol/message_defs.h"
+#include "boltprotocol/message_serialization.h"
+
+namespace neo4j_bolt_transport {
+    namespace internal {
+
+        // Per-session RUN encoder. The query string and parameter names are encoded once per Cypher
+        // string and kept in LRU order up to `capacity` entries; the extra map is encoded once per
+        // distinct session/tx configuration. Capacity 0 encodes every RUN directly.
+        //
+        // Not thread-safe: each session owns one and uses it from a single caller at a time.
+        class PreparedRunCache {
+          public:
+            explicit PreparedRunCache(size_t capacity = 0) : capacity_(capacity) {
+            }
+
+            PreparedRunCache(PreparedRunCache&&) = default;
+            PreparedRunCache& operator=(PreparedRunCache&&) = default;
+            PreparedRunCache(const PreparedRunCache&) = delete;
+            PreparedRunCache& operator=(const PreparedRunCache&) = delete;
+
+            // Appends a RUN message to `out_payload`, byte-identical to serialize_run_message.
+            // Only field 3 is taken from `extra_source`; its cypher_query and parameters are ignored.
+            boltprotocol::BoltError serialize(const std::string& cypher,
+                                              const std::map<std::string, boltprotocol::Value>& parameters,
+                                              const boltprotocol::RunMessageParams& extra_source,
+                                              const boltprotocol::versions::Version& bolt_version,
+                                              std::vector<uint8_t>& out_payload);
+
+            size_t capacity() const {
+                return capacity_;
+            }
+            size_t size() const {
+                return lru_.size();
+            }
+
+          private:
+            using TemplateList = std::list<boltprotocol::PreparedRunTemplate>;  // Most recently used first
+
+            const boltprotocol::PreparedRunTemplate* _lookup_template(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, boltprotocol::BoltError& out_err);
+            const std::vector<uint8_t>* _lookup_extra_map(const boltprotocol::RunMessageParams& extra_source, const boltprotocol::versions::Version& bolt_version, std::vector<uint8_t>& scratch, boltprotocol::BoltError& out_err);
+
+            size_t capacity_;
+            TemplateList lru_;
+            // Keys view the cypher_query of their list node, which list moves and splices keep in place.
+            std::unordered_map<std::string_view, TemplateList::iterator> index_;
+
+            boltprotocol::RunMessageParams cached_extra_source_;
+            boltprotocol::versions::Version cached_extra_version_;
+            std::vector<uint8_t> cached_extra_bytes_;
+        };
+
+    }  // namespace internal
+}  // namespace neo4j_bolt_transport
+
+#endif  // NEO4J_BOLT_TRANSPORT_INTERNAL_PREPARED_RUN_CACHE_H
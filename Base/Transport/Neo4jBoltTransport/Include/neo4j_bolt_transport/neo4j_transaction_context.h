@@ -11,6 +11,7 @@
 #include "boltprotocol/message_defs.h"  // For Value, SuccessMessageParams, FailureMessageParams
 // BoltRecord and BoltResultStream are needed for the 'run' method's return type
 #include "bolt_record.h"
+#include "bulk_write.h"
 #include "result_stream.h"
 
 namespace neo4j_bolt_transport {
@@ -43,6 +44,10 @@ namespace neo4j_bolt_transport {
                                                                     boltprotocol::SuccessMessageParams& out_summary,
                                                                     boltprotocol::FailureMessageParams& out_failure);
 
+        // Writes many parameter sets as pipelined UNWIND batches within the current transaction.
+        // See SessionHandle::run_bulk_write; batches_per_commit is ignored here.
+        std::pair<std::pair<boltprotocol::BoltError, std::string>, BulkWriteResult> run_bulk_write(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options = {});
+
         // Note: A full-fledged TransactionContext in official drivers often mirrors
         // many methods of the Session object (like run, commit, rollback, close).
         // However, for the managed transaction function pattern, the Session handles
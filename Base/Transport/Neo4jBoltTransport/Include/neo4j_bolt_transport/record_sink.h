@@ -0,0 +1,84 @@
+#ifndef NEO4J_BOLT_TRANSPORT_RECORD_SINK_H
+#define NEO4J_BOLT_TRANSPORT_RECORD_SINK_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "boltprotocol/message_defs.h"
+
+namespace neo4j_bolt_transport {
+
+    // Non-owning view over a single decoded RECORD.
+    // It is only valid for the duration of the sink call that receives it: the field storage
+    // is reused for the next record, so copy out whatever must outlive the callback.
+    class BoltRecordView {
+      public:
+        BoltRecordView(const std::vector<boltprotocol::Value>& fields, const std::vector<std::string>& field_names) : fields_(fields), field_names_(field_names) {
+        }
+
+        size_t field_count() const noexcept {
+            return fields_.size();
+        }
+        const std::vector<std::string>& field_names() const noexcept {
+            return field_names_;
+        }
+        const std::vector<boltprotocol::Value>& values() const noexcept {
+            return fields_;
+        }
+
+        // Returns nullptr if the index is out of range.
+        const boltprotocol::Value* get(size_t index) const noexcept {
+            return index < fields_.size() ? &fields_[index] : nullptr;
+        }
+
+        // Returns nullptr if the field name is unknown.
+        const boltprotocol::Value* get(const std::string& field_name) const noexcept {
+            for (size_t i = 0; i < field_names_.size(); ++i) {
+                if (field_names_[i] == field_name) {
+                    return get(i);
+                }
+            }
+            return nullptr;
+        }
+
+        // Typed access by index, same strict type matching as BoltRecord::get_as.
+        template <typename T>
+        std::pair<boltprotocol::BoltError, T> get_as(size_t index) const {
+            const boltprotocol::Value* value = get(index);
+            if (!value) {
+                return {boltprotocol::BoltError::INVALID_ARGUMENT, T{}};
+            }
+            if (const T* typed = std::get_if<T>(value)) {
+                return {boltprotocol::BoltError::SUCCESS, *typed};
+            }
+            return {boltprotocol::BoltError::DESERIALIZATION_ERROR, T{}};
+        }
+
+        template <typename T>
+        std::pair<boltprotocol::BoltError, T> get_as(const std::string& field_name) const {
+            const boltprotocol::Value* value = get(field_name);
+            if (!value) {
+                return {boltprotocol::BoltError::INVALID_ARGUMENT, T{}};
+            }
+            if (const T* typed = std::get_if<T>(value)) {
+                return {boltprotocol::BoltError::SUCCESS, *typed};
+            }
+            return {boltprotocol::BoltError::DESERIALIZATION_ERROR, T{}};
+        }
+
+      private:
+        const std::vector<boltprotocol::Value>& fields_;
+        const std::vector<std::string>& field_names_;
+    };
+
+    // Push-style consumer invoked once per RECORD straight from the receive loop.
+    // Return SUCCESS to keep streaming. Any other code aborts the query; since the remaining
+    // records cannot be skipped on the wire, the underlying connection is discarded.
+    using RecordSink = std::function<boltprotocol::BoltError(const BoltRecordView& record)>;
+
+}  // namespace neo4j_bolt_transport
+
+#endif  // NEO4J_BOLT_TRANSPORT_RECORD_SINK_H
@@ -7,12 +7,17 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "boltprotocol/message_defs.h"
+#include "boltprotocol/message_serialization.h"
+#include "bulk_write.h"
 #include "config/session_parameters.h"
 #include "internal/bolt_physical_connection.h"
+#include "internal/prepared_run_cache.h"
 #include "neo4j_transaction_work.h"
+#include "record_sink.h"
 #include "result_stream.h"  // Includes ResultSummary transitively
 
 namespace neo4j_bolt_transport {
@@ -64,6 +69,21 @@ namespace neo4j_bolt_transport {
                                                                                  const std::optional<TransactionConfigOverrides>& tx_config_overrides = std::nullopt  // Replaced tx_metadata_override
         );
 
+        // Push-style execution: every RECORD is decoded into a reused buffer and handed to `sink`
+        // from inside the PULL receive loop, without building BoltRecord objects or buffering.
+        // Works both for auto-commit queries and inside an explicit transaction.
+        std::pair<std::pair<boltprotocol::BoltError, std::string>, ResultSummary> run_query_stream(const std::string& cypher,
+                                                                                                   const std::map<std::string, boltprotocol::Value>& parameters,
+                                                                                                   const RecordSink& sink,
+                                                                                                   const std::optional<TransactionConfigOverrides>& tx_config_overrides = std::nullopt);
+
+        // Bulk write: rows from `source` are packed into batches of "UNWIND $rows AS row <row_cypher>"
+        // sized by BulkWriteOptions, and up to max_batches_in_flight RUN/DISCARD pairs are pipelined
+        // before waiting for replies. Runs inside the current explicit transaction if there is one.
+        // On failure the remaining replies are drained and the session is invalidated; the result
+        // counters report how far the write got.
+        std::pair<std::pair<boltprotocol::BoltError, std::string>, BulkWriteResult> run_bulk_write(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options = {});
+
         const std::vector<std::string>& get_last_bookmarks() const;
         void update_bookmarks(const std::vector<std::string>& new_bookmarks);
 
@@ -86,9 +106,23 @@ namespace neo4j_bolt_transport {
                                                                                  boltprotocol::SuccessMessageParams& out_run_summary_raw,
                                                                                  boltprotocol::FailureMessageParams& out_failure_details_raw);
 
+        void _fill_auto_commit_run_context(boltprotocol::RunMessageParams& run_p,
+                                           const boltprotocol::versions::Version& bolt_version,
+                                           const std::optional<std::map<std::string, boltprotocol::Value>>& tx_metadata,
+                                           const std::optional<std::chrono::milliseconds>& tx_timeout) const;
+
+        // Encodes a RUN through the prepared-query cache: the query string and parameter names are
+        // encoded once per Cypher string, the extra map once per distinct session/tx configuration.
+        boltprotocol::BoltError _serialize_run_cached(const std::string& cypher,
+                                                      const std::map<std::string, boltprotocol::Value>& parameters,
+                                                      const boltprotocol::RunMessageParams& extra_source,
+                                                      const boltprotocol::versions::Version& bolt_version,
+                                                      std::vector<uint8_t>& out_payload);
+
         std::pair<boltprotocol::BoltError, std::string> _prepare_explicit_tx_run(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, boltprotocol::SuccessMessageParams& out_run_summary_raw, boltprotocol::FailureMessageParams& out_failure_details_raw);
 
         std::pair<boltprotocol::BoltError, std::string> _stream_pull_records(std::optional<int64_t> qid, int64_t n, std::vector<boltprotocol::RecordMessageParams>& out_records, boltprotocol::SuccessMessageParams& out_pull_summary_raw);
+        std::pair<boltprotocol::BoltError, std::string> _stream_pull_with_handler(std::optional<int64_t> qid, int64_t n, internal::BoltPhysicalConnection::MessageHandler record_handler, boltprotocol::SuccessMessageParams& out_pull_summary_raw);
         std::pair<boltprotocol::BoltError, std::string> _stream_discard_records(std::optional<int64_t> qid, int64_t n, boltprotocol::SuccessMessageParams& out_discard_summary_raw);
 
         void _release_connection_to_pool(bool mark_healthy = true);
@@ -107,6 +141,8 @@ namespace neo4j_bolt_transport {
         std::vector<std::string> current_bookmarks_;
         bool is_closed_ = false;
         bool connection_is_valid_ = true;
+
+        internal::PreparedRunCache prepared_run_cache_;
     };
 
 }  // namespace neo4j_bolt_transport
@@ -0,0 +1,336 @@
+#include "neo4j_bolt_transport/async_query_pipeline.h"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/system_executor.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_reader.h"
+#include "boltprotocol/packstream_writer.h"
+#include "neo4j_bolt_transport/async_session_handle.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/internal/bolt_physical_connection.h"
+#include "neo4j_bolt_transport/neo4j_bolt_transport.h"
+
+namespace neo4j_bolt_transport {
+
+    namespace {
+        boost::asio::any_io_executor pipeline_executor_for(Neo4jBoltTransport* transport_manager, internal::ActiveAsyncStreamContext* stream_ctx) {
+            if (stream_ctx) {
+                return stream_ctx->get_executor();
+            }
+            if (transport_manager) {
+                return transport_manager->get_io_context().get_executor();
+            }
+            return boost::asio::system_executor();
+        }
+
+        std::shared_ptr<spdlog::logger> pipeline_logger_for(Neo4jBoltTransport* transport_manager) {
+            if (transport_manager && transport_manager->get_config().logger) {
+                return transport_manager->get_config().logger;
+            }
+            return nullptr;
+        }
+    }  // namespace
+
+    AsyncQueryPipeline::PendingRequest::PendingRequest(Kind k, const boost::asio::any_io_executor& executor) : kind(k), done_signal(executor), summaries_expected(k == Kind::QUERY ? 2 : 1) {
+        done_signal.expires_at(boost::asio::steady_timer::time_point::max());
+    }
+
+    AsyncQueryPipeline::AsyncQueryPipeline(AsyncSessionHandle& session, size_t max_queries_in_flight)
+        : session_(session), max_queries_in_flight_(max_queries_in_flight > 0 ? max_queries_in_flight : 1), capacity_signal_(pipeline_executor_for(session.transport_manager_, session.stream_context_.get())) {
+        capacity_signal_.expires_at(boost::asio::steady_timer::time_point::max());
+    }
+
+    boost::asio::awaitable<std::pair<boltprotocol::BoltError, PipelinedQueryResult>> AsyncQueryPipeline::run_async(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters) {
+        auto self = shared_from_this();
+        auto logger = pipeline_logger_for(session_.transport_manager_);
+
+        // Apply back-pressure before touching the queues; every wake-up re-checks the limit.
+        while (!broken_ && queries_in_flight_ >= max_queries_in_flight_) {
+            boost::system::error_code ignored_ec;
+            co_await capacity_signal_.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ignored_ec));
+        }
+
+        PipelinedQueryResult early_result;
+        if (broken_ || !session_.is_valid() || !session_.stream_context_) {
+            early_result.error_message = broken_ ? "Pipeline is broken: " + last_io_error_message_ : "Pipeline session is invalid or closed.";
+            co_return std::make_pair(broken_ ? last_io_error_ : boltprotocol::BoltError::NETWORK_ERROR, std::move(early_result));
+        }
+        // The server ignores everything until RESET anyway; failing here keeps the cause visible.
+        if (transaction_aborted_) {
+            early_result.error_message = "Explicit transaction was aborted by an earlier pipelined failure; call reset_async() to roll it back.";
+            early_result.transaction_aborted = true;
+            co_return std::make_pair(boltprotocol::BoltError::UNKNOWN_ERROR, std::move(early_result));
+        }
+
+        internal::ActiveAsyncStreamContext& ctx = *session_.stream_context_;
+        const bool in_tx = session_.in_explicit_transaction_.load(std::memory_order_acquire);
+        boltprotocol::RunMessageParams run_params = session_._prepare_run_message_params(cypher, parameters, in_tx);
+
+        std::vector<uint8_t> run_payload;
+        boltprotocol::BoltError err = session_._serialize_run_cached(run_params, run_payload);
+        if (err != boltprotocol::BoltError::SUCCESS) {
+            early_result.error_message = "Failed to serialize RUN message (pipeline): " + error::bolt_error_to_string(err);
+            co_return std::make_pair(err, std::move(early_result));
+        }
+
+        // PULL without qid always refers to the RUN written just before it.
+        boltprotocol::PullMessageParams pull_params;
+        pull_params.n = -1;
+        std::vector<uint8_t> pull_payload;
+        boltprotocol::PackStreamWriter pull_writer(pull_payload);
+        err = boltprotocol::serialize_pull_message(pull_params, pull_writer);
+        if (err != boltprotocol::BoltError::SUCCESS) {
+            early_result.error_message = "Failed to serialize PULL message (pipeline): " + error::bolt_error_to_string(err);
+            co_return std::make_pair(err, std::move(early_result));
+        }
+
+        auto request = std::make_shared<PendingRequest>(PendingRequest::Kind::QUERY, ctx.get_executor());
+        std::vector<std::vector<uint8_t>> payloads;
+        payloads.push_back(std::move(run_payload));
+        payloads.push_back(std::move(pull_payload));
+        request->updates_bookmarks = !in_tx;
+        request->in_transaction = in_tx;
+        ++queries_in_flight_;
+        _enqueue(request, std::move(payloads));
+        if (logger) logger->trace("[AsyncPipeline] Query queued: {:.50}... ({} in flight)", cypher, queries_in_flight_);
+
+        if (!request->completed) {
+            boost::system::error_code ignored_ec;
+            co_await request->done_signal.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ignored_ec));
+        }
+
+        co_return std::make_pair(request->error, std::move(request->result));
+    }
+
+    void AsyncQueryPipeline::_enqueue(std::shared_ptr<PendingRequest> request, std::vector<std::vector<uint8_t>> payloads) {
+        // Replies arrive in write order, so the request and its payloads are queued together
+        // without suspending in between.
+        awaiting_replies_.push_back(std::move(request));
+        for (auto& payload : payloads) {
+            outbox_.push_back(std::move(payload));
+        }
+
+        auto executor = session_.stream_context_->get_executor();
+        if (!writer_active_) {
+            writer_active_ = true;
+            boost::asio::co_spawn(executor, _write_loop(shared_from_this()), boost::asio::detached);
+        }
+        if (!reader_active_) {
+            reader_active_ = true;
+            boost::asio::co_spawn(executor, _read_loop(shared_from_this()), boost::asio::detached);
+        }
+    }
+
+    std::shared_ptr<AsyncQueryPipeline::PendingRequest> AsyncQueryPipeline::_queue_reset() {
+        std::vector<uint8_t> reset_payload;
+        boltprotocol::PackStreamWriter reset_writer(reset_payload);
+        if (boltprotocol::serialize_reset_message(reset_writer) != boltprotocol::BoltError::SUCCESS) {
+            _fail_all(boltprotocol::BoltError::SERIALIZATION_ERROR, "Failed to serialize pipelined RESET.");
+            return nullptr;
+        }
+        reset_queued_ = true;
+        std::vector<std::vector<uint8_t>> payloads;
+        payloads.push_back(std::move(reset_payload));
+        auto request = std::make_shared<PendingRequest>(PendingRequest::Kind::RESET, session_.stream_context_->get_executor());
+        _enqueue(request, std::move(payloads));
+        return request;
+    }
+
+    void AsyncQueryPipeline::_complete_front() {
+        auto request = std::move(awaiting_replies_.front());
+        awaiting_replies_.pop_front();
+        if (request->kind == PendingRequest::Kind::RESET) {
+            reset_queued_ = false;
+            request->completed = true;
+            request->done_signal.cancel();
+            if (request->error != boltprotocol::BoltError::SUCCESS) {
+                _fail_all(request->error, "Pipelined RESET was rejected: " + request->result.error_message);
+                return;
+            }
+            // RESET rolls back any open transaction on the server; keep the session in step so the
+            // next query is not sent as part of a transaction that no longer exists.
+            transaction_aborted_ = false;
+            if (session_.in_explicit_transaction_.exchange(false, std::memory_order_acq_rel)) {
+                session_.last_tx_run_qid_.reset();
+                if (auto logger = pipeline_logger_for(session_.transport_manager_)) logger->info("[AsyncPipeline] RESET rolled back the explicit transaction.");
+            }
+            return;
+        }
+        // Bookmarks are applied here, in reply order, rather than when each caller resumes.
+        if (request->error == boltprotocol::BoltError::SUCCESS && request->updates_bookmarks) {
+            session_._update_bookmarks_from_summary(request->result.pull_summary_raw);
+        }
+        --queries_in_flight_;
+        request->completed = true;
+        request->done_signal.cancel();
+        capacity_signal_.cancel();
+    }
+
+    boost::asio::awaitable<std::pair<boltprotocol::BoltError, std::string>> AsyncQueryPipeline::reset_async() {
+        auto self = shared_from_this();
+        if (broken_ || !session_.is_valid() || !session_.stream_context_) {
+            co_return std::make_pair(broken_ ? last_io_error_ : boltprotocol::BoltError::NETWORK_ERROR, broken_ ? "Pipeline is broken: " + last_io_error_message_ : std::string("Pipeline session is invalid or closed."));
+        }
+        auto request = _queue_reset();
+        if (!request) {
+            co_return std::make_pair(last_io_error_, last_io_error_message_);
+        }
+        if (!request->completed) {
+            boost::system::error_code ignored_ec;
+            co_await request->done_signal.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ignored_ec));
+        }
+        co_return std::make_pair(request->error, request->result.error_message);
+    }
+
+    void AsyncQueryPipeline::_fail_all(boltprotocol::BoltError error, const std::string& message) {
+        if (!broken_) {
+            broken_ = true;
+            last_io_error_ = error;
+            last_io_error_message_ = message;
+            if (auto logger = pipeline_logger_for(session_.transport_manager_)) logger->error("[AsyncPipeline] Pipeline broken, failing {} outstanding queries: {}", queries_in_flight_, message);
+            session_.last_error_code_ = error;
+            session_.last_error_message_ = message;
+            if (session_.stream_context_) {
+                std::visit(
+                    [](auto& s_ref) {
+                        boost::system::error_code ignored_ec;
+                        s_ref.lowest_layer().close(ignored_ec);
+                    },
+                    session_.stream_context_->stream);
+            }
+        }
+        outbox_.clear();
+        while (!awaiting_replies_.empty()) {
+            auto request = std::move(awaiting_replies_.front());
+            awaiting_replies_.pop_front();
+            if (request->error == boltprotocol::BoltError::SUCCESS) {
+                request->error = error;
+                request->result.error_message = message;
+            }
+            if (request->kind == PendingRequest::Kind::QUERY) --queries_in_flight_;
+            request->completed = true;
+            request->done_signal.cancel();
+        }
+        capacity_signal_.cancel();
+    }
+
+    void AsyncQueryPipeline::_on_static_op_error(boltprotocol::BoltError error, const std::string& message) {
+        last_io_error_ = error;
+        last_io_error_message_ = message;
+    }
+
+    boost::asio::awaitable<void> AsyncQueryPipeline::_write_loop(std::shared_ptr<AsyncQueryPipeline> self) {
+        auto logger = pipeline_logger_for(self->session_.transport_manager_);
+        auto error_handler = [self](boltprotocol::BoltError reason, const std::string& message) { self->_on_static_op_error(reason, message); };
+
+        while (!self->outbox_.empty() && !self->broken_) {
+            std::vector<uint8_t> payload = std::move(self->outbox_.front());
+            self->outbox_.pop_front();
+            boltprotocol::BoltError err = co_await internal::BoltPhysicalConnection::_send_chunked_payload_async_static_helper(*self->session_.stream_context_, std::move(payload), self->session_.stream_context_->original_config, logger, error_handler);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                self->_fail_all(err, "Pipelined write failed: " + self->last_io_error_message_);
+                break;
+            }
+        }
+        self->writer_active_ = false;
+    }
+
+    boost::asio::awaitable<void> AsyncQueryPipeline::_read_loop(std::shared_ptr<AsyncQueryPipeline> self) {
+        auto logger = pipeline_logger_for(self->session_.transport_manager_);
+        auto error_handler = [self](boltprotocol::BoltError reason, const std::string& message) { self->_on_static_op_error(reason, message); };
+
+        while (!self->awaiting_replies_.empty() && !self->broken_) {
+            auto [recv_err, payload] = co_await internal::BoltPhysicalConnection::_receive_chunked_payload_async_static_helper(*self->session_.stream_context_, self->session_.stream_context_->original_config, logger, error_handler);
+            if (self->broken_) break;
+            if (recv_err != boltprotocol::BoltError::SUCCESS) {
+                self->_fail_all(recv_err, "Pipelined read failed: " + self->last_io_error_message_);
+                break;
+            }
+            if (payload.empty()) continue;  // NOOP
+            if (self->awaiting_replies_.empty()) {
+                self->_fail_all(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "Unsolicited message received by pipeline.");
+                break;
+            }
+
+            boltprotocol::PackStreamReader peek_reader(payload);
+            uint8_t raw_tag = 0;
+            uint32_t num_fields = 0;
+            boltprotocol::BoltError peek_err = boltprotocol::peek_message_structure_header(peek_reader, raw_tag, num_fields);
+            if (peek_err != boltprotocol::BoltError::SUCCESS) {
+                self->_fail_all(peek_err, "Failed to peek tag of pipelined reply.");
+                break;
+            }
+            auto tag = static_cast<boltprotocol::MessageTag>(raw_tag);
+            PendingRequest& front = *self->awaiting_replies_.front();
+            boltprotocol::PackStreamReader reader(payload);
+
+            if (tag == boltprotocol::MessageTag::RECORD) {
+                if (front.kind != PendingRequest::Kind::QUERY || front.summaries_received != 1) {
+                    self->_fail_all(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "RECORD received outside of a PULL in pipeline.");
+                    break;
+                }
+                boltprotocol::RecordMessageParams record;
+                if (boltprotocol::deserialize_record_message(reader, record) != boltprotocol::BoltError::SUCCESS) {
+                    self->_fail_all(boltprotocol::BoltError::DESERIALIZATION_ERROR, "Failed to deserialize pipelined RECORD.");
+                    break;
+                }
+                front.result.records.push_back(std::move(record));
+                continue;
+            }
+
+            if (tag == boltprotocol::MessageTag::SUCCESS) {
+                boltprotocol::SuccessMessageParams& target = front.summaries_received == 0 ? front.result.run_summary_raw : front.result.pull_summary_raw;
+                if (boltprotocol::deserialize_success_message(reader, target) != boltprotocol::BoltError::SUCCESS) {
+                    self->_fail_all(boltprotocol::BoltError::DESERIALIZATION_ERROR, "Failed to deserialize pipelined SUCCESS.");
+                    break;
+                }
+                if (front.kind == PendingRequest::Kind::QUERY && front.summaries_received == 0) {
+                    auto it_fields = target.metadata.find("fields");
+                    if (it_fields != target.metadata.end() && std::holds_alternative<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second)) {
+                        const auto& list_ptr = std::get<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second);
+                        if (list_ptr) {
+                            for (const auto& field_val : list_ptr->elements) {
+                                if (std::holds_alternative<std::string>(field_val)) front.result.field_names.push_back(std::get<std::string>(field_val));
+                            }
+                        }
+                    }
+                }
+            } else if (tag == boltprotocol::MessageTag::FAILURE) {
+                if (boltprotocol::deserialize_failure_message(reader, front.result.failure_raw) != boltprotocol::BoltError::SUCCESS) {
+                    self->_fail_all(boltprotocol::BoltError::DESERIALIZATION_ERROR, "Failed to deserialize pipelined FAILURE.");
+                    break;
+                }
+                front.error = boltprotocol::BoltError::UNKNOWN_ERROR;
+                front.result.error_message = "Server FAILURE (pipeline): " + error::format_server_failure(front.result.failure_raw);
+                if (logger) logger->warn("[AsyncPipeline] {}", front.result.error_message);
+                if (front.kind == PendingRequest::Kind::QUERY && front.in_transaction) {
+                    // Resetting here would roll back the caller's earlier writes behind their back.
+                    self->transaction_aborted_ = true;
+                    front.result.transaction_aborted = true;
+                } else if (!self->reset_queued_ && front.kind == PendingRequest::Kind::QUERY) {
+                    self->_queue_reset();
+                    if (self->broken_) break;
+                }
+            } else if (tag == boltprotocol::MessageTag::IGNORED) {
+                if (front.error == boltprotocol::BoltError::SUCCESS) {
+                    front.error = boltprotocol::BoltError::UNKNOWN_ERROR;
+                    front.result.error_message = "Query ignored by server after an earlier pipelined failure.";
+                }
+                if (front.in_transaction && self->transaction_aborted_) front.result.transaction_aborted = true;
+            } else {
+                self->_fail_all(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "Unexpected tag " + std::to_string(static_cast<int>(tag)) + " in pipeline.");
+                break;
+            }
+
+            if (++front.summaries_received == front.summaries_expected) {
+                self->_complete_front();
+            }
+        }
+        self->reader_active_ = false;
+    }
+
+}  // namespace neo4j_bolt_transport
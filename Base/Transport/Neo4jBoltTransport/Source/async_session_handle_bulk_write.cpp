@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_writer.h"
+#include "neo4j_bolt_transport/async_session_handle.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/internal/bolt_physical_connection.h"
+#include "neo4j_bolt_transport/neo4j_bolt_transport.h"
+
+namespace neo4j_bolt_transport {
+
+    boost::asio::awaitable<std::pair<boltprotocol::BoltError, BulkWriteResult>> AsyncSessionHandle::run_bulk_write_async(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options) {
+        std::shared_ptr<spdlog::logger> logger = nullptr;
+        if (transport_manager_ && transport_manager_->get_config().logger) {
+            logger = transport_manager_->get_config().logger;
+        }
+        BulkWriteResult result;
+
+        if (!is_valid() || !stream_context_) {
+            if (logger) logger->warn("[AsyncSessionBulk] run_bulk_write_async called on invalid or closed session.");
+            co_return std::make_pair(boltprotocol::BoltError::NETWORK_ERROR, result);
+        }
+        if (close_initiated_.load(std::memory_order_acquire)) {
+            co_return std::make_pair(boltprotocol::BoltError::INVALID_ARGUMENT, result);
+        }
+        if (!source || row_cypher.empty() || options.rows_parameter.empty() || options.max_batch_bytes == 0) {
+            co_return std::make_pair(boltprotocol::BoltError::INVALID_ARGUMENT, result);
+        }
+
+        const bool caller_tx = in_explicit_transaction_.load(std::memory_order_acquire);
+        const bool grouped_commits = !caller_tx && options.batches_per_commit > 0;
+        const size_t max_in_flight = std::max<size_t>(1, options.max_batches_in_flight);
+        const std::string batch_cypher = internal::make_unwind_cypher(row_cypher, options.rows_parameter);
+
+        auto static_op_error_handler = [this, logger_copy = logger](boltprotocol::BoltError reason, const std::string& message) {
+            // Keep the first error: replies drained after a failure only report IGNORED.
+            if (this->last_error_code_ == boltprotocol::BoltError::SUCCESS) {
+                this->last_error_code_ = reason;
+                this->last_error_message_ = message;
+            }
+            if (logger_copy) logger_copy->error("[AsyncSessionBulk:StaticOpErrHandler] Error: {} - {}", static_cast<int>(reason), message);
+        };
+        last_error_code_ = boltprotocol::BoltError::SUCCESS;
+        last_error_message_ = "";
+
+        std::vector<uint8_t> discard_payload_bytes;
+        {
+            boltprotocol::DiscardMessageParams discard_p;
+            discard_p.n = -1;
+            boltprotocol::PackStreamWriter discard_writer(discard_payload_bytes);
+            boltprotocol::BoltError serialize_err = boltprotocol::serialize_discard_message(discard_p, discard_writer);
+            if (serialize_err != boltprotocol::BoltError::SUCCESS) {
+                static_op_error_handler(serialize_err, "Failed to serialize DISCARD message (bulk): " + error::bolt_error_to_string(serialize_err));
+                co_return std::make_pair(last_error_code_, result);
+            }
+        }
+
+        // Row counts of batches whose RUN/DISCARD replies are outstanding, oldest first.
+        std::deque<uint64_t> in_flight_rows;
+        size_t pending_replies = 0;
+        bool own_tx_open = false;
+        size_t batches_in_current_tx = 0;
+        bool failed = false;
+
+        internal::BulkBatchBuilder builder(options);
+        while (!failed) {
+            size_t batch_rows = builder.next_batch(source);
+            if (batch_rows == 0) {
+                if (builder.error() != boltprotocol::BoltError::SUCCESS) {
+                    static_op_error_handler(builder.error(), "Failed to encode bulk write row: " + error::bolt_error_to_string(builder.error()));
+                    failed = true;
+                }
+                break;
+            }
+            size_t batch_bytes = builder.current_batch_bytes();
+
+            if (grouped_commits && !own_tx_open) {
+                boltprotocol::BoltError begin_err = co_await begin_transaction_async();
+                if (begin_err != boltprotocol::BoltError::SUCCESS) {
+                    co_return std::make_pair(begin_err, result);
+                }
+                own_tx_open = true;
+            }
+
+            const bool in_tx = in_explicit_transaction_.load(std::memory_order_acquire);
+            boltprotocol::RunMessageParams run_params = _prepare_run_message_params(batch_cypher, {}, in_tx);
+            run_params.parameters = builder.take_parameters();
+
+            std::vector<uint8_t> run_payload_bytes;
+            run_payload_bytes.reserve(batch_bytes + batch_cypher.size() + 64);
+            boltprotocol::BoltError serialize_err = _serialize_run_cached(run_params, run_payload_bytes);
+            if (serialize_err != boltprotocol::BoltError::SUCCESS) {
+                static_op_error_handler(serialize_err, "Failed to serialize RUN message (bulk): " + error::bolt_error_to_string(serialize_err));
+                failed = true;
+                break;
+            }
+
+            boltprotocol::BoltError send_err = co_await internal::BoltPhysicalConnection::_send_chunked_payload_async_static_helper(*stream_context_, std::move(run_payload_bytes), stream_context_->original_config, logger, static_op_error_handler);
+            if (send_err == boltprotocol::BoltError::SUCCESS) {
+                ++pending_replies;
+                send_err = co_await internal::BoltPhysicalConnection::_send_chunked_payload_async_static_helper(*stream_context_, discard_payload_bytes, stream_context_->original_config, logger, static_op_error_handler);
+            }
+            if (send_err != boltprotocol::BoltError::SUCCESS) {
+                failed = true;
+                break;
+            }
+            ++pending_replies;
+            in_flight_rows.push_back(batch_rows);
+            result.rows_submitted += batch_rows;
+            ++result.batches_submitted;
+            ++batches_in_current_tx;
+
+            // Wait for the oldest batches while the window is full, or for all of them before a commit.
+            const bool commit_due = grouped_commits && batches_in_current_tx >= options.batches_per_commit;
+            while (!in_flight_rows.empty() && (in_flight_rows.size() >= max_in_flight || commit_due)) {
+                auto [run_err, run_summary] = co_await internal::BoltPhysicalConnection::receive_summary_async_static(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+                --pending_replies;
+                auto [discard_err, discard_summary] = co_await internal::BoltPhysicalConnection::receive_summary_async_static(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+                --pending_replies;
+                if (run_err != boltprotocol::BoltError::SUCCESS || discard_err != boltprotocol::BoltError::SUCCESS) {
+                    failed = true;
+                    break;
+                }
+                if (!in_tx) {
+                    _update_bookmarks_from_summary(discard_summary.raw_params());
+                }
+                result.rows_acknowledged += in_flight_rows.front();
+                ++result.batches_acknowledged;
+                in_flight_rows.pop_front();
+            }
+            if (failed) break;
+
+            if (commit_due) {
+                own_tx_open = false;
+                boltprotocol::BoltError commit_err = co_await commit_transaction_async();
+                if (commit_err != boltprotocol::BoltError::SUCCESS) {
+                    co_return std::make_pair(commit_err, result);
+                }
+                ++result.transactions_committed;
+                batches_in_current_tx = 0;
+            }
+        }
+
+        while (!failed && !in_flight_rows.empty()) {
+            auto [run_err, run_summary] = co_await internal::BoltPhysicalConnection::receive_summary_async_static(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+            --pending_replies;
+            auto [discard_err, discard_summary] = co_await internal::BoltPhysicalConnection::receive_summary_async_static(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+            --pending_replies;
+            if (run_err != boltprotocol::BoltError::SUCCESS || discard_err != boltprotocol::BoltError::SUCCESS) {
+                failed = true;
+                break;
+            }
+            if (!caller_tx && !own_tx_open) {
+                _update_bookmarks_from_summary(discard_summary.raw_params());
+            }
+            result.rows_acknowledged += in_flight_rows.front();
+            ++result.batches_acknowledged;
+            in_flight_rows.pop_front();
+        }
+
+        if (failed) {
+            // Read the replies still on the wire so the failure surfaces cleanly, then drop the stream:
+            // the server side is left in a failed state that only a RESET or a new connection clears.
+            while (pending_replies > 0 && stream_context_) {
+                auto [drain_err, ignored_summary] = co_await internal::BoltPhysicalConnection::receive_summary_async_static(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+                --pending_replies;
+                if (drain_err == boltprotocol::BoltError::NETWORK_ERROR) break;
+            }
+            // Closing the stream ends whatever transaction was open on it, the caller's included.
+            in_explicit_transaction_.store(false, std::memory_order_release);
+            last_tx_run_qid_.reset();
+            std::visit(
+                [](auto& s_ref) {
+                    boost::system::error_code ignored_ec;
+                    s_ref.lowest_layer().close(ignored_ec);
+                },
+                stream_context_->stream);
+            if (logger) logger->warn("[AsyncSessionBulk] Bulk write failed after {} of {} rows acknowledged: {}", result.rows_acknowledged, result.rows_submitted, last_error_message_);
+            co_return std::make_pair(last_error_code_ != boltprotocol::BoltError::SUCCESS ? last_error_code_ : boltprotocol::BoltError::UNKNOWN_ERROR, result);
+        }
+
+        if (own_tx_open) {
+            boltprotocol::BoltError commit_err = co_await commit_transaction_async();
+            if (commit_err != boltprotocol::BoltError::SUCCESS) {
+                co_return std::make_pair(commit_err, result);
+            }
+            ++result.transactions_committed;
+        }
+
+        if (logger) logger->debug("[AsyncSessionBulk] Bulk write finished: {} rows in {} batches, {} commits.", result.rows_acknowledged, result.batches_acknowledged, result.transactions_committed);
+        co_return std::make_pair(boltprotocol::BoltError::SUCCESS, result);
+    }
+
+}  // namespace neo4j_bolt_transport
@@ -21,8 +21,8 @@ namespace neo4j_bolt_transport {
           current_bookmarks_(session_params_.initial_bookmarks),  // Initialize from session params
           is_closed_(false),
           close_initiated_(false),
-          in_explicit_transaction_(false)  // Initialize in_explicit_transaction_
-    {
+          in_explicit_transaction_(false),  // Initialize in_explicit_transaction_
+          prepared_run_cache_(session_params_.prepared_query_cache_size) {
         if (!transport_manager_) {
             last_error_code_ = boltprotocol::BoltError::INVALID_ARGUMENT;
             last_error_message_ = "AsyncSessionHandle created with null transport_manager.";
@@ -93,7 +93,8 @@ namespace neo4j_bolt_transport {
           in_explicit_transaction_(other.in_explicit_transaction_.load(std::memory_order_acquire)),
           last_tx_run_qid_(other.last_tx_run_qid_),
           last_error_code_(other.last_error_code_),
-          last_error_message_(std::move(other.last_error_message_)) {
+          last_error_message_(std::move(other.last_error_message_)),
+          prepared_run_cache_(std::move(other.prepared_run_cache_)) {
         other.transport_manager_ = nullptr;
         other.is_closed_.store(true, std::memory_order_release);
         other.close_initiated_.store(true, std::memory_order_release);
@@ -124,6 +125,7 @@ namespace neo4j_bolt_transport {
             last_tx_run_qid_ = other.last_tx_run_qid_;
             last_error_code_ = other.last_error_code_;
             last_error_message_ = std::move(other.last_error_message_);
+            prepared_run_cache_ = std::move(other.prepared_run_cache_);
 
             other.transport_manager_ = nullptr;
             other.is_closed_.store(true, std::memory_order_release);
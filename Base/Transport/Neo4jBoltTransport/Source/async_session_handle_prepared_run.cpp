@@ -0,0 +1,16 @@
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_writer.h"
+#include "neo4j_bolt_transport/async_session_handle.h"
+
+namespace neo4j_bolt_transport {
+
+    boltprotocol::BoltError AsyncSessionHandle::_serialize_run_cached(const boltprotocol::RunMessageParams& run_params, std::vector<uint8_t>& out_payload) {
+        const boltprotocol::versions::Version& bolt_version = stream_context_->negotiated_bolt_version;
+        if (prepared_run_cache_.capacity() == 0) {
+            boltprotocol::PackStreamWriter writer(out_payload);
+            return boltprotocol::serialize_run_message(run_params, writer, bolt_version);
+        }
+        return prepared_run_cache_.serialize(run_params.cypher_query, run_params.parameters, run_params, bolt_version, out_payload);
+    }
+
+}  // namespace neo4j_bolt_transport
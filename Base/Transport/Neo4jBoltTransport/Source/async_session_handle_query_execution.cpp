@@ -40,8 +40,7 @@ namespace neo4j_bolt_transport {
         boltprotocol::RunMessageParams run_params = _prepare_run_message_params(cypher, parameters, false);
 
         std::vector<uint8_t> run_payload_bytes;
-        boltprotocol::PackStreamWriter run_writer(run_payload_bytes);
-        boltprotocol::BoltError serialize_err = boltprotocol::serialize_run_message(run_params, run_writer, stream_context_->negotiated_bolt_version);
+        boltprotocol::BoltError serialize_err = _serialize_run_cached(run_params, run_payload_bytes);
         if (serialize_err != boltprotocol::BoltError::SUCCESS) {
             last_error_code_ = serialize_err;
             last_error_message_ = "Failed to serialize RUN message: " + error::bolt_error_to_string(serialize_err);
@@ -139,8 +138,7 @@ namespace neo4j_bolt_transport {
 
         boltprotocol::RunMessageParams run_params = _prepare_run_message_params(cypher, parameters, false);
         std::vector<uint8_t> run_payload_bytes;
-        boltprotocol::PackStreamWriter run_writer(run_payload_bytes);
-        boltprotocol::BoltError serialize_err = boltprotocol::serialize_run_message(run_params, run_writer, stream_context_->negotiated_bolt_version);
+        boltprotocol::BoltError serialize_err = _serialize_run_cached(run_params, run_payload_bytes);
 
         if (serialize_err != boltprotocol::BoltError::SUCCESS) {
             last_error_code_ = serialize_err;
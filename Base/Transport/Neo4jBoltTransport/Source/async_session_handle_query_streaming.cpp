@@ -0,0 +1,183 @@
+#include <utility>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_reader.h"
+#include "boltprotocol/packstream_writer.h"
+#include "neo4j_bolt_transport/async_session_handle.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/internal/bolt_physical_connection.h"
+#include "neo4j_bolt_transport/neo4j_bolt_transport.h"
+
+namespace neo4j_bolt_transport {
+
+    boost::asio::awaitable<std::pair<boltprotocol::BoltError, ResultSummary>> AsyncSessionHandle::run_query_stream_async(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, const RecordSink& sink) {
+        std::shared_ptr<spdlog::logger> logger = nullptr;
+        if (transport_manager_ && transport_manager_->get_config().logger) {
+            logger = transport_manager_->get_config().logger;
+        }
+        std::string server_addr = stream_context_ ? (stream_context_->original_config.target_host + ":" + std::to_string(stream_context_->original_config.target_port)) : "unknown_async_sink_run";
+        auto make_summary = [&](boltprotocol::SuccessMessageParams&& raw) {
+            return ResultSummary(std::move(raw), stream_context_ ? stream_context_->negotiated_bolt_version : boltprotocol::versions::Version(0, 0), stream_context_ ? stream_context_->utc_patch_active : false, server_addr, session_params_.database_name);
+        };
+
+        if (!is_valid() || !stream_context_) {
+            if (logger) logger->warn("[AsyncSessionExecSink] run_query_stream_async called on invalid or closed session.");
+            co_return std::make_pair(boltprotocol::BoltError::NETWORK_ERROR, make_summary({}));
+        }
+        if (close_initiated_.load(std::memory_order_acquire)) {
+            if (logger) logger->warn("[AsyncSessionExecSink] run_query_stream_async called after close_async initiated.");
+            co_return std::make_pair(boltprotocol::BoltError::INVALID_ARGUMENT, make_summary({}));
+        }
+        if (!sink) {
+            co_return std::make_pair(boltprotocol::BoltError::INVALID_ARGUMENT, make_summary({}));
+        }
+
+        const bool in_tx = in_explicit_transaction_.load(std::memory_order_acquire);
+        if (logger) logger->debug("[AsyncSessionExecSink] run_query_stream_async: Cypher: {:.50}... (explicit tx: {})", cypher, in_tx);
+
+        boltprotocol::RunMessageParams run_params = _prepare_run_message_params(cypher, parameters, in_tx);
+        std::vector<uint8_t> run_payload_bytes;
+        boltprotocol::BoltError serialize_err = _serialize_run_cached(run_params, run_payload_bytes);
+        if (serialize_err != boltprotocol::BoltError::SUCCESS) {
+            last_error_code_ = serialize_err;
+            last_error_message_ = "Failed to serialize RUN message (sink): " + error::bolt_error_to_string(serialize_err);
+            if (logger) logger->error("[AsyncSessionExecSink] {}", last_error_message_);
+            co_return std::make_pair(last_error_code_, make_summary({}));
+        }
+
+        auto static_op_error_handler = [this, logger_copy = logger](boltprotocol::BoltError reason, const std::string& message) {
+            this->last_error_code_ = reason;
+            this->last_error_message_ = message;
+            if (logger_copy) logger_copy->error("[AsyncSessionExecSink:StaticOpErrHandler] Error: {} - {}", static_cast<int>(reason), message);
+        };
+
+        auto [run_summary_err, run_result_summary_obj] = co_await internal::BoltPhysicalConnection::send_request_receive_summary_async_static(*stream_context_, run_payload_bytes, stream_context_->original_config, logger, static_op_error_handler);
+        if (run_summary_err != boltprotocol::BoltError::SUCCESS) {
+            co_return std::make_pair(last_error_code_, std::move(run_result_summary_obj));
+        }
+
+        const auto& run_meta = run_result_summary_obj.raw_params().metadata;
+        std::vector<std::string> field_names;
+        auto it_fields = run_meta.find("fields");
+        if (it_fields != run_meta.end() && std::holds_alternative<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second)) {
+            const auto& list_ptr = std::get<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second);
+            if (list_ptr) {
+                field_names.reserve(list_ptr->elements.size());
+                for (const auto& field_val : list_ptr->elements) {
+                    if (std::holds_alternative<std::string>(field_val)) {
+                        field_names.push_back(std::get<std::string>(field_val));
+                    }
+                }
+            }
+        }
+
+        std::optional<int64_t> qid_for_pull;
+        auto it_qid = run_meta.find("qid");
+        if (it_qid != run_meta.end() && std::holds_alternative<int64_t>(it_qid->second) && stream_context_->negotiated_bolt_version.major >= 4) {
+            qid_for_pull = std::get<int64_t>(it_qid->second);
+        }
+        if (in_tx) {
+            last_tx_run_qid_ = qid_for_pull;
+        }
+
+        int64_t fetch_n = session_params_.default_fetch_size > 0 ? session_params_.default_fetch_size : 1000;
+        if (session_params_.default_fetch_size == -1) fetch_n = -1;
+
+        boltprotocol::SuccessMessageParams final_meta = run_result_summary_obj.raw_params();
+        boltprotocol::RecordMessageParams reusable_record;
+        uint64_t records_delivered = 0;
+        bool server_has_more = true;
+
+        while (server_has_more) {
+            boltprotocol::PullMessageParams pull_params;
+            pull_params.n = fetch_n;
+            pull_params.qid = qid_for_pull;
+            std::vector<uint8_t> pull_payload_bytes;
+            boltprotocol::PackStreamWriter pull_writer(pull_payload_bytes);
+            serialize_err = boltprotocol::serialize_pull_message(pull_params, pull_writer);
+            if (serialize_err != boltprotocol::BoltError::SUCCESS) {
+                static_op_error_handler(serialize_err, "Failed to serialize PULL message (sink): " + error::bolt_error_to_string(serialize_err));
+                co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+            }
+
+            boltprotocol::BoltError send_err = co_await internal::BoltPhysicalConnection::_send_chunked_payload_async_static_helper(*stream_context_, std::move(pull_payload_bytes), stream_context_->original_config, logger, static_op_error_handler);
+            if (send_err != boltprotocol::BoltError::SUCCESS) {
+                co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+            }
+
+            bool pull_summary_received = false;
+            while (!pull_summary_received) {
+                auto [recv_err, response_payload] = co_await internal::BoltPhysicalConnection::_receive_chunked_payload_async_static_helper(*stream_context_, stream_context_->original_config, logger, static_op_error_handler);
+                if (recv_err != boltprotocol::BoltError::SUCCESS) {
+                    co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                }
+                if (response_payload.empty()) {
+                    continue;  // NOOP
+                }
+
+                boltprotocol::PackStreamReader peek_reader(response_payload);
+                uint8_t raw_tag_byte_peek = 0;
+                uint32_t num_fields_peek = 0;
+                boltprotocol::BoltError peek_err = boltprotocol::peek_message_structure_header(peek_reader, raw_tag_byte_peek, num_fields_peek);
+                if (peek_err != boltprotocol::BoltError::SUCCESS) {
+                    static_op_error_handler(peek_err, "Failed to peek tag in PULL response (sink)");
+                    co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                }
+                auto tag = static_cast<boltprotocol::MessageTag>(raw_tag_byte_peek);
+
+                boltprotocol::PackStreamReader reader(response_payload);
+                if (tag == boltprotocol::MessageTag::RECORD) {
+                    boltprotocol::BoltError deser_err = boltprotocol::deserialize_record_message(reader, reusable_record);
+                    if (deser_err != boltprotocol::BoltError::SUCCESS) {
+                        static_op_error_handler(deser_err, "Failed to deserialize RECORD in PULL (sink)");
+                        co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                    }
+                    ++records_delivered;
+                    boltprotocol::BoltError sink_err = sink(BoltRecordView(reusable_record.fields, field_names));
+                    if (sink_err != boltprotocol::BoltError::SUCCESS) {
+                        // The rest of the reply is still on the wire, so this stream cannot be reused.
+                        static_op_error_handler(sink_err, "Record sink aborted the stream after " + std::to_string(records_delivered) + " records.");
+                        std::visit(
+                            [](auto& s_ref) {
+                                boost::system::error_code ignored_ec;
+                                s_ref.lowest_layer().close(ignored_ec);
+                            },
+                            stream_context_->stream);
+                        co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                    }
+                } else if (tag == boltprotocol::MessageTag::SUCCESS) {
+                    final_meta.metadata.clear();
+                    boltprotocol::BoltError deser_err = boltprotocol::deserialize_success_message(reader, final_meta);
+                    if (deser_err != boltprotocol::BoltError::SUCCESS) {
+                        static_op_error_handler(deser_err, "Failed to deserialize SUCCESS from PULL (sink)");
+                        co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                    }
+                    auto it_has_more = final_meta.metadata.find("has_more");
+                    server_has_more = it_has_more != final_meta.metadata.end() && std::holds_alternative<bool>(it_has_more->second) && std::get<bool>(it_has_more->second);
+                    pull_summary_received = true;
+                } else if (tag == boltprotocol::MessageTag::FAILURE) {
+                    boltprotocol::FailureMessageParams pull_failure_meta;
+                    boltprotocol::BoltError deser_err = boltprotocol::deserialize_failure_message(reader, pull_failure_meta);
+                    if (deser_err != boltprotocol::BoltError::SUCCESS) {
+                        static_op_error_handler(deser_err, "Failed to deserialize FAILURE from PULL (sink)");
+                    } else {
+                        static_op_error_handler(boltprotocol::BoltError::UNKNOWN_ERROR, "Server FAILURE during PULL (sink): " + error::format_server_failure(pull_failure_meta));
+                    }
+                    co_return std::make_pair(last_error_code_, make_summary(boltprotocol::SuccessMessageParams{std::move(pull_failure_meta.metadata)}));
+                } else {
+                    static_op_error_handler(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "Unexpected tag " + std::to_string(static_cast<int>(tag)) + " during PULL (sink)");
+                    co_return std::make_pair(last_error_code_, make_summary(std::move(final_meta)));
+                }
+            }
+        }
+
+        last_error_code_ = boltprotocol::BoltError::SUCCESS;
+        last_error_message_ = "";
+        if (!in_tx) {
+            _update_bookmarks_from_summary(final_meta);
+        }
+        if (logger) logger->debug("[AsyncSessionExecSink] run_query_stream_async delivered {} records.", records_delivered);
+        co_return std::make_pair(boltprotocol::BoltError::SUCCESS, make_summary(std::move(final_meta)));
+    }
+
+}  // namespace neo4j_bolt_transport
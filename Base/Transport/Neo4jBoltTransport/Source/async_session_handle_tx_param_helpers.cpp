@@ -40,9 +40,34 @@ namespace neo4j_bolt_transport {
         return begin_p;
     }
 
-    // _prepare_run_message_params is now moved to/defined in async_session_handle_query_execution.cpp
-    // as it's used by both auto-commit and explicit-tx run methods which are in that file or
-    // async_session_handle_explicit_tx_query.cpp respectively.
-    // The version in async_session_handle.h now has the bool is_in_explicit_tx parameter.
+    // This helper prepares parameters for a RUN message.
+    // Inside an explicit transaction the RUN carries no extra fields; those were sent with BEGIN.
+    boltprotocol::RunMessageParams AsyncSessionHandle::_prepare_run_message_params(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, bool is_in_explicit_tx) {
+        boltprotocol::RunMessageParams run_p;
+        run_p.cypher_query = cypher;
+        run_p.parameters = parameters;
+        if (is_in_explicit_tx) {
+            return run_p;
+        }
+
+        if (!current_bookmarks_.empty()) {
+            run_p.bookmarks = current_bookmarks_;
+        }
+        if (session_params_.database_name.has_value()) {
+            run_p.db = session_params_.database_name;
+        }
+        if (session_params_.impersonated_user.has_value()) {
+            run_p.imp_user = session_params_.impersonated_user;
+        }
+        if (stream_context_ && stream_context_->negotiated_bolt_version < boltprotocol::versions::V5_0) {
+            if (session_params_.default_access_mode == config::AccessMode::READ) {
+                run_p.mode = "r";
+            }
+        }
+        if (transport_manager_ && transport_manager_->get_config().explicit_transaction_timeout_default_ms > 0) {
+            run_p.tx_timeout = static_cast<int64_t>(transport_manager_->get_config().explicit_transaction_timeout_default_ms);
+        }
+        return run_p;
+    }
 
 }  // namespace neo4j_bolt_transport
\ No newline at end of file
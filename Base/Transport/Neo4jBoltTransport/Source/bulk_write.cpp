@@ -0,0 +1,91 @@
+#include "neo4j_bolt_transport/bulk_write.h"
+
+#include <utility>
+
+#include "boltprotocol/packstream_writer.h"
+
+namespace neo4j_bolt_transport {
+
+    BulkRowSource make_bulk_row_source(const std::vector<BulkRow>& rows) {
+        auto next_index = std::make_shared<size_t>(0);
+        return [&rows, next_index](BulkRow& out_row) {
+            if (*next_index >= rows.size()) {
+                return false;
+            }
+            out_row = rows[(*next_index)++];
+            return true;
+        };
+    }
+
+    namespace internal {
+
+        std::string make_unwind_cypher(const std::string& row_cypher, const std::string& rows_parameter) {
+            std::string cypher;
+            cypher.reserve(row_cypher.size() + rows_parameter.size() + 20);
+            cypher.append("UNWIND $").append(rows_parameter).append(" AS row ").append(row_cypher);
+            return cypher;
+        }
+
+        BulkBatchBuilder::BulkBatchBuilder(const BulkWriteOptions& options) : options_(options), rows_(std::make_shared<boltprotocol::BoltList>()) {
+        }
+
+        size_t BulkBatchBuilder::next_batch(const BulkRowSource& source) {
+            if (error_ != boltprotocol::BoltError::SUCCESS) {
+                return 0;
+            }
+            if (carry_over_.has_value()) {
+                rows_->elements.push_back(std::move(*carry_over_));
+                batch_bytes_ += carry_over_bytes_;
+                carry_over_.reset();
+                carry_over_bytes_ = 0;
+            }
+
+            BulkRow row;
+            while (!source_drained_) {
+                if (options_.max_batch_rows > 0 && rows_->elements.size() >= options_.max_batch_rows) {
+                    break;
+                }
+                row.clear();
+                if (!source(row)) {
+                    source_drained_ = true;
+                    break;
+                }
+
+                auto row_map = std::make_shared<boltprotocol::BoltMap>();
+                row_map->pairs = std::move(row);
+                boltprotocol::Value row_value(std::move(row_map));
+                // A row that cannot be sized (e.g. nested past the writer's depth limit) could not be
+                // encoded either; stop here instead of sending a partial batch.
+                size_t row_bytes = 0;
+                boltprotocol::BoltError size_err = boltprotocol::packed_size(row_value, row_bytes);
+                if (size_err != boltprotocol::BoltError::SUCCESS) {
+                    error_ = size_err;
+                    rows_->elements.clear();
+                    batch_bytes_ = 0;
+                    return 0;
+                }
+
+                if (!rows_->elements.empty() && batch_bytes_ + row_bytes > options_.max_batch_bytes) {
+                    // Keep the row for the next batch rather than overshoot the budget.
+                    carry_over_ = std::move(row_value);
+                    carry_over_bytes_ = row_bytes;
+                    break;
+                }
+                rows_->elements.push_back(std::move(row_value));
+                batch_bytes_ += row_bytes;
+            }
+            return rows_->elements.size();
+        }
+
+        std::map<std::string, boltprotocol::Value> BulkBatchBuilder::take_parameters() {
+            std::map<std::string, boltprotocol::Value> params = options_.shared_parameters;
+            params[options_.rows_parameter] = std::move(rows_);
+            rows_ = std::make_shared<boltprotocol::BoltList>();
+            rows_->elements.reserve(options_.max_batch_rows);
+            batch_bytes_ = 0;
+            return params;
+        }
+
+    }  // namespace internal
+
+}  // namespace neo4j_bolt_transport
@@ -62,7 +62,8 @@ namespace neo4j_bolt_transport {
               creation_timestamp_(other.creation_timestamp_),
               // last_used_timestamp_ is atomic
               last_error_code_(other.last_error_code_),
-              last_error_message_(std::move(other.last_error_message_)) {
+              last_error_message_(std::move(other.last_error_message_)),
+              pending_pipelined_responses_(other.pending_pipelined_responses_) {
             current_state_.store(other.current_state_.load(std::memory_order_relaxed), std::memory_order_relaxed);
             last_used_timestamp_.store(other.last_used_timestamp_.load(std::memory_order_relaxed), std::memory_order_relaxed);
 
@@ -109,6 +110,7 @@ namespace neo4j_bolt_transport {
                 last_used_timestamp_.store(other.last_used_timestamp_.load(std::memory_order_relaxed), std::memory_order_relaxed);
                 last_error_code_ = other.last_error_code_;
                 last_error_message_ = std::move(other.last_error_message_);
+                pending_pipelined_responses_ = other.pending_pipelined_responses_;
 
                 // Invalidate 'other'
                 other.id_ = static_cast<uint64_t>(-1);
@@ -80,6 +80,7 @@ namespace neo4j_bolt_transport {
             server_agent_string_.clear();
             server_assigned_conn_id_.clear();
             utc_patch_active_ = false;
+            pending_pipelined_responses_ = 0;
 
             // 6. Reset error state, unless in destructor of an already defunct connection
             //    or if we want to preserve the "original sin" error.
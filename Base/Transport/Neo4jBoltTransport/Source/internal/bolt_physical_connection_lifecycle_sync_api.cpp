@@ -1,6 +1,7 @@
 #include <vector>
 
 #include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_reader.h"
 #include "boltprotocol/packstream_writer.h"
 #include "neo4j_bolt_transport/error/neo4j_error_util.h"
 #include "neo4j_bolt_transport/internal/bolt_physical_connection.h"
@@ -121,6 +122,62 @@ namespace neo4j_bolt_transport {
             return boltprotocol::BoltError::SUCCESS;
         }
 
+        boltprotocol::BoltError BoltPhysicalConnection::perform_reset() {
+            // RESET is the one request a connection in FAILED_SERVER_REPORTED still accepts; any
+            // pipelined replies must have been drained by the caller first.
+            InternalState current_s = current_state_.load(std::memory_order_relaxed);
+            if ((current_s != InternalState::READY && current_s != InternalState::FAILED_SERVER_REPORTED) || pending_pipelined_responses_ != 0) {
+                if (logger_) logger_->warn("[ConnLCSync {}] perform_reset called in invalid state: {} (pending: {})", id_, _get_current_state_as_string(), pending_pipelined_responses_);
+                return last_error_code_ != boltprotocol::BoltError::SUCCESS ? last_error_code_ : boltprotocol::BoltError::NETWORK_ERROR;
+            }
+
+            std::vector<uint8_t> reset_payload;
+            boltprotocol::PackStreamWriter writer(reset_payload);
+            boltprotocol::BoltError err = boltprotocol::serialize_reset_message(writer);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                _mark_as_defunct_internal(err, "Failed to serialize RESET.");
+                return last_error_code_;
+            }
+            mark_as_used();
+            err = _send_chunked_payload_sync(reset_payload);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                // _send_chunked_payload_sync calls _mark_as_defunct_internal
+                return last_error_code_;
+            }
+            current_state_.store(InternalState::AWAITING_SUMMARY, std::memory_order_relaxed);
+
+            std::vector<uint8_t> response_payload;
+            while (true) {  // Loop to skip NOOPs
+                err = _receive_chunked_payload_sync(response_payload);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    // _receive_chunked_payload_sync calls _mark_as_defunct_internal
+                    return last_error_code_;
+                }
+                if (!response_payload.empty()) break;
+            }
+
+            boltprotocol::MessageTag tag;
+            err = _peek_message_tag(response_payload, tag);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                _mark_as_defunct_internal(err, "Failed to peek tag for RESET response.");
+                return last_error_code_;
+            }
+            boltprotocol::PackStreamReader reader(response_payload);
+            boltprotocol::SuccessMessageParams reset_success;
+            if (tag != boltprotocol::MessageTag::SUCCESS || boltprotocol::deserialize_success_message(reader, reset_success) != boltprotocol::BoltError::SUCCESS) {
+                // A connection that cannot be reset cannot be trusted with another request.
+                _mark_as_defunct_internal(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "RESET was not acknowledged with SUCCESS.");
+                return last_error_code_;
+            }
+
+            InternalState expected_awaiting = InternalState::AWAITING_SUMMARY;
+            current_state_.compare_exchange_strong(expected_awaiting, InternalState::READY, std::memory_order_acq_rel, std::memory_order_relaxed);
+            last_error_code_ = boltprotocol::BoltError::SUCCESS;
+            last_error_message_.clear();
+            if (logger_) logger_->trace("[ConnLCSync {}] RESET acknowledged.", id_);
+            return boltprotocol::BoltError::SUCCESS;
+        }
+
         boltprotocol::BoltError BoltPhysicalConnection::ping(std::chrono::milliseconds timeout) {
             if (logger_) logger_->debug("[ConnLCSync {}] Pinging (sync) connection (via RESET). Timeout hint: {}ms", id_, timeout.count());
             return perform_reset();
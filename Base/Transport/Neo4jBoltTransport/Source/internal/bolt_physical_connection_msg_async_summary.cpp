@@ -32,6 +32,16 @@ namespace neo4j_bolt_transport {
                 co_return std::make_pair(err, default_summary_on_error);
             }
 
+            co_return co_await BoltPhysicalConnection::receive_summary_async_static(stream_ctx, conn_config_ref, logger_ref, error_handler);
+        }
+
+        boost::asio::awaitable<std::pair<boltprotocol::BoltError, ResultSummary>> BoltPhysicalConnection::receive_summary_async_static(internal::ActiveAsyncStreamContext& stream_ctx,
+                                                                                                                                       const BoltConnectionConfig& conn_config_ref,
+                                                                                                                                       std::shared_ptr<spdlog::logger> logger_ref,
+                                                                                                                                       std::function<void(boltprotocol::BoltError, const std::string&)> error_handler) {
+            ResultSummary default_summary_on_error({}, stream_ctx.negotiated_bolt_version, stream_ctx.utc_patch_active, conn_config_ref.target_host + ":" + std::to_string(conn_config_ref.target_port), std::nullopt);
+            boltprotocol::BoltError err = boltprotocol::BoltError::SUCCESS;
+
             std::vector<uint8_t> response_payload;
             while (true) {
                 auto [recv_err, current_payload] = co_await BoltPhysicalConnection::_receive_chunked_payload_async_static_helper(stream_ctx, conn_config_ref, logger_ref, error_handler);
@@ -81,6 +91,15 @@ namespace neo4j_bolt_transport {
                 std::string server_fail_detail = error::format_server_failure(failure_meta);
                 if (error_handler) error_handler(boltprotocol::BoltError::UNKNOWN_ERROR, "Async Static: Server failure: " + server_fail_detail);
                 co_return std::make_pair(boltprotocol::BoltError::UNKNOWN_ERROR, ResultSummary(boltprotocol::SuccessMessageParams{std::move(failure_meta.metadata)}, stream_ctx.negotiated_bolt_version, stream_ctx.utc_patch_active, server_addr_str, std::nullopt));
+            } else if (tag == boltprotocol::MessageTag::IGNORED) {
+                // Seen when an earlier pipelined request failed; the caller drains these before RESET.
+                err = boltprotocol::deserialize_ignored_message(reader);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    if (error_handler) error_handler(err, "Async Static: Failed to deserialize IGNORED summary.");
+                    co_return std::make_pair(err, default_summary_on_error);
+                }
+                if (error_handler) error_handler(boltprotocol::BoltError::UNKNOWN_ERROR, "Async Static: Request was ignored by the server.");
+                co_return std::make_pair(boltprotocol::BoltError::UNKNOWN_ERROR, default_summary_on_error);
             } else {
                 std::string unexpected_tag_msg = "Async Static: Unexpected summary tag " + std::to_string(static_cast<int>(tag));
                 if (error_handler) error_handler(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, unexpected_tag_msg);
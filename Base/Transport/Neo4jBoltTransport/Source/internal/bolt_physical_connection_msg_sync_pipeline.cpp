@@ -0,0 +1,114 @@
+#include <vector>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_reader.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/internal/bolt_physical_connection.h"
+
+namespace neo4j_bolt_transport {
+    namespace internal {
+
+        boltprotocol::BoltError BoltPhysicalConnection::send_request_pipelined(const std::vector<uint8_t>& request_payload) {
+            InternalState current_s = current_state_.load(std::memory_order_relaxed);
+            // The first request of a pipeline needs an idle connection; later ones ride on the
+            // AWAITING_SUMMARY state set by the first. Once the server has reported a failure every
+            // further request would only be IGNORED, so refuse to queue more.
+            bool state_ok = pending_pipelined_responses_ == 0 ? current_s == InternalState::READY : current_s == InternalState::AWAITING_SUMMARY;
+            if (!state_ok) {
+                if (logger_) logger_->warn("[ConnMsgSyncPipeline {}] send_request_pipelined called in invalid state: {} (pending: {})", id_, _get_current_state_as_string(), pending_pipelined_responses_);
+                return last_error_code_ != boltprotocol::BoltError::SUCCESS ? last_error_code_ : boltprotocol::BoltError::NETWORK_ERROR;
+            }
+            mark_as_used();
+
+            boltprotocol::BoltError err = _send_chunked_payload_sync(request_payload);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                // _send_chunked_payload_sync calls _mark_as_defunct_internal
+                return last_error_code_;
+            }
+
+            ++pending_pipelined_responses_;
+            current_state_.store(InternalState::AWAITING_SUMMARY, std::memory_order_relaxed);
+            return boltprotocol::BoltError::SUCCESS;
+        }
+
+        boltprotocol::BoltError BoltPhysicalConnection::receive_pipelined_summary(boltprotocol::SuccessMessageParams& out_summary, boltprotocol::FailureMessageParams& out_failure) {
+            out_summary.metadata.clear();
+            out_failure.metadata.clear();
+
+            if (pending_pipelined_responses_ == 0) {
+                if (logger_) logger_->warn("[ConnMsgSyncPipeline {}] receive_pipelined_summary called with no pipelined request outstanding.", id_);
+                return boltprotocol::BoltError::INVALID_ARGUMENT;
+            }
+            if (current_state_.load(std::memory_order_relaxed) == InternalState::DEFUNCT) {
+                return last_error_code_ != boltprotocol::BoltError::SUCCESS ? last_error_code_ : boltprotocol::BoltError::NETWORK_ERROR;
+            }
+
+            std::vector<uint8_t> response_payload;
+            while (true) {  // Loop to skip NOOPs
+                boltprotocol::BoltError err = _receive_chunked_payload_sync(response_payload);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    // _receive_chunked_payload_sync calls _mark_as_defunct_internal
+                    return last_error_code_;
+                }
+                if (!response_payload.empty()) break;
+                if (logger_) logger_->trace("[ConnMsgSyncPipeline {}] Received NOOP while awaiting pipelined summary.", id_);
+            }
+            --pending_pipelined_responses_;
+
+            boltprotocol::MessageTag tag;
+            boltprotocol::BoltError err = _peek_message_tag(response_payload, tag);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                _mark_as_defunct_internal(err, "Failed to peek tag for pipelined summary.");
+                return last_error_code_;
+            }
+
+            boltprotocol::PackStreamReader reader(response_payload);
+            if (tag == boltprotocol::MessageTag::SUCCESS) {
+                err = boltprotocol::deserialize_success_message(reader, out_summary);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    _mark_as_defunct_internal(err, "Failed to deserialize pipelined SUCCESS summary.");
+                    return last_error_code_;
+                }
+                if (pending_pipelined_responses_ == 0) {
+                    InternalState expected_awaiting = InternalState::AWAITING_SUMMARY;
+                    current_state_.compare_exchange_strong(expected_awaiting, InternalState::READY, std::memory_order_acq_rel, std::memory_order_relaxed);
+                }
+                return boltprotocol::BoltError::SUCCESS;
+
+            } else if (tag == boltprotocol::MessageTag::FAILURE) {
+                err = boltprotocol::deserialize_failure_message(reader, out_failure);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    _mark_as_defunct_internal(err, "Failed to deserialize pipelined FAILURE summary.");
+                    return last_error_code_;
+                }
+                // The remaining pipelined replies will be IGNORED; the caller drains them before RESET.
+                return _classify_and_set_server_failure(out_failure);
+
+            } else if (tag == boltprotocol::MessageTag::IGNORED) {
+                err = boltprotocol::deserialize_ignored_message(reader);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    _mark_as_defunct_internal(err, "Failed to deserialize pipelined IGNORED summary.");
+                    return last_error_code_;
+                }
+                out_failure.metadata["code"] = boltprotocol::Value("Neo.ClientError.Request.Ignored");
+                out_failure.metadata["message"] = boltprotocol::Value("Request was ignored by the server.");
+                if (current_state_.load(std::memory_order_relaxed) != InternalState::DEFUNCT) {
+                    current_state_.store(InternalState::FAILED_SERVER_REPORTED, std::memory_order_relaxed);
+                }
+                if (last_error_code_ == boltprotocol::BoltError::SUCCESS) {
+                    last_error_code_ = boltprotocol::BoltError::UNKNOWN_ERROR;
+                    last_error_message_ = "Pipelined operation ignored by server.";
+                }
+                return boltprotocol::BoltError::UNKNOWN_ERROR;
+            } else {
+                _mark_as_defunct_internal(boltprotocol::BoltError::INVALID_MESSAGE_FORMAT, "Unexpected message tag for pipelined summary: " + std::to_string(static_cast<int>(tag)));
+                return last_error_code_;
+            }
+        }
+
+        size_t BoltPhysicalConnection::get_pending_pipelined_responses() const {
+            return pending_pipelined_responses_;
+        }
+
+    }  // namespace internal
+}  // namespace neo4j_bolt_transport
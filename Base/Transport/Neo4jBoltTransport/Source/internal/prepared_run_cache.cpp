@@ -0,0 +1,111 @@
+#include "neo4j_bolt_transport/internal/prepared_run_cache.h"
+
+#include <utility>
+
+#include "boltprotocol/packstream_writer.h"
+
+namespace neo4j_bolt_transport {
+    namespace internal {
+
+        namespace {
+            // The extra map is only cached for the inputs that can be compared cheaply and exactly.
+            // tx_metadata and custom fields may hold nested values, so RUNs carrying them are encoded directly.
+            bool run_extra_is_cacheable(const boltprotocol::RunMessageParams& p) {
+                return (!p.tx_metadata.has_value() || p.tx_metadata->empty()) && p.other_extra_fields.empty();
+            }
+
+            bool run_extra_inputs_equal(const boltprotocol::RunMessageParams& a, const boltprotocol::RunMessageParams& b) {
+                return a.bookmarks == b.bookmarks && a.tx_timeout == b.tx_timeout && a.mode == b.mode && a.db == b.db && a.imp_user == b.imp_user && a.notifications_min_severity == b.notifications_min_severity &&
+                       a.notifications_disabled_categories == b.notifications_disabled_categories;
+            }
+
+            // Copies only what run_extra_inputs_equal compares; the query and parameters may be large.
+            void copy_run_extra_inputs(const boltprotocol::RunMessageParams& from, boltprotocol::RunMessageParams& to) {
+                to.bookmarks = from.bookmarks;
+                to.tx_timeout = from.tx_timeout;
+                to.mode = from.mode;
+                to.db = from.db;
+                to.imp_user = from.imp_user;
+                to.notifications_min_severity = from.notifications_min_severity;
+                to.notifications_disabled_categories = from.notifications_disabled_categories;
+            }
+        }  // namespace
+
+        boltprotocol::BoltError PreparedRunCache::serialize(const std::string& cypher,
+                                                            const std::map<std::string, boltprotocol::Value>& parameters,
+                                                            const boltprotocol::RunMessageParams& extra_source,
+                                                            const boltprotocol::versions::Version& bolt_version,
+                                                            std::vector<uint8_t>& out_payload) {
+            if (capacity_ == 0) {
+                boltprotocol::RunMessageParams run_p = extra_source;
+                run_p.cypher_query = cypher;
+                run_p.parameters = parameters;
+                boltprotocol::PackStreamWriter writer(out_payload);
+                return boltprotocol::serialize_run_message(run_p, writer, bolt_version);
+            }
+
+            boltprotocol::BoltError err = boltprotocol::BoltError::SUCCESS;
+            std::vector<uint8_t> uncached_extra_bytes;
+            const std::vector<uint8_t>* extra_bytes = _lookup_extra_map(extra_source, bolt_version, uncached_extra_bytes, err);
+            if (!extra_bytes) return err;
+            const boltprotocol::PreparedRunTemplate* run_template = _lookup_template(cypher, parameters, err);
+            if (!run_template) return err;
+            return boltprotocol::serialize_run_message_prepared(*run_template, parameters, *extra_bytes, out_payload);
+        }
+
+        const boltprotocol::PreparedRunTemplate* PreparedRunCache::_lookup_template(const std::string& cypher, const std::map<std::string, boltprotocol::Value>& parameters, boltprotocol::BoltError& out_err) {
+            auto it = index_.find(std::string_view(cypher));
+            if (it != index_.end()) {
+                TemplateList::iterator node = it->second;
+                if (node != lru_.begin()) {
+                    lru_.splice(lru_.begin(), lru_, node);
+                }
+                if (boltprotocol::run_template_matches(*node, parameters)) {
+                    return &*node;
+                }
+                // Same query, different parameter names: re-encode in place. The key views the old
+                // query string, so it is re-inserted against the new one.
+                boltprotocol::PreparedRunTemplate fresh_template;
+                out_err = boltprotocol::prepare_run_template(cypher, parameters, fresh_template);
+                if (out_err != boltprotocol::BoltError::SUCCESS) return nullptr;
+                index_.erase(it);
+                *node = std::move(fresh_template);
+                index_.emplace(std::string_view(node->cypher_query), node);
+                return &*node;
+            }
+
+            boltprotocol::PreparedRunTemplate fresh_template;
+            out_err = boltprotocol::prepare_run_template(cypher, parameters, fresh_template);
+            if (out_err != boltprotocol::BoltError::SUCCESS) return nullptr;
+            if (lru_.size() >= capacity_) {
+                index_.erase(std::string_view(lru_.back().cypher_query));
+                lru_.pop_back();
+            }
+            lru_.push_front(std::move(fresh_template));
+            index_.emplace(std::string_view(lru_.front().cypher_query), lru_.begin());
+            return &lru_.front();
+        }
+
+        const std::vector<uint8_t>* PreparedRunCache::_lookup_extra_map(const boltprotocol::RunMessageParams& extra_source, const boltprotocol::versions::Version& bolt_version, std::vector<uint8_t>& scratch, boltprotocol::BoltError& out_err) {
+            if (!run_extra_is_cacheable(extra_source)) {
+                boltprotocol::PackStreamWriter extra_writer(scratch);
+                out_err = boltprotocol::serialize_run_extra_map(extra_source, extra_writer, bolt_version);
+                return out_err == boltprotocol::BoltError::SUCCESS ? &scratch : nullptr;
+            }
+            if (!cached_extra_bytes_.empty() && cached_extra_version_ == bolt_version && run_extra_inputs_equal(cached_extra_source_, extra_source)) {
+                return &cached_extra_bytes_;
+            }
+            cached_extra_bytes_.clear();
+            boltprotocol::PackStreamWriter extra_writer(cached_extra_bytes_);
+            out_err = boltprotocol::serialize_run_extra_map(extra_source, extra_writer, bolt_version);
+            if (out_err != boltprotocol::BoltError::SUCCESS) {
+                cached_extra_bytes_.clear();
+                return nullptr;
+            }
+            copy_run_extra_inputs(extra_source, cached_extra_source_);
+            cached_extra_version_ = bolt_version;
+            return &cached_extra_bytes_;
+        }
+
+    }  // namespace internal
+}  // namespace neo4j_bolt_transport
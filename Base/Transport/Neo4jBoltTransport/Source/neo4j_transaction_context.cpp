@@ -104,4 +104,12 @@ namespace neo4j_bolt_transport {
         return err_pair;
     }
 
+    std::pair<std::pair<boltprotocol::BoltError, std::string>, BulkWriteResult> TransactionContext::run_bulk_write(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options) {
+        if (!owner_session_.is_in_transaction()) {
+            return {{boltprotocol::BoltError::INVALID_ARGUMENT, "TransactionContext::run_bulk_write called, but SessionHandle is not in an active explicit transaction."}, BulkWriteResult{}};
+        }
+        // Inside a transaction the session pipelines the batches without committing in between.
+        return owner_session_.run_bulk_write(row_cypher, source, options);
+    }
+
 }  // namespace neo4j_bolt_transport
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_writer.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/neo4j_bolt_transport.h"
+#include "neo4j_bolt_transport/session_handle.h"
+
+namespace neo4j_bolt_transport {
+
+    std::pair<std::pair<boltprotocol::BoltError, std::string>, BulkWriteResult> SessionHandle::run_bulk_write(const std::string& row_cypher, const BulkRowSource& source, const BulkWriteOptions& options) {
+        BulkWriteResult result;
+
+        std::pair<boltprotocol::BoltError, std::string> conn_check_pair;
+        internal::BoltPhysicalConnection* conn = _get_valid_connection_for_operation(conn_check_pair, "run_bulk_write");
+        if (!conn) {
+            return {conn_check_pair, result};
+        }
+        auto logger = conn->get_logger();
+
+        if (!source || row_cypher.empty() || options.rows_parameter.empty() || options.max_batch_bytes == 0) {
+            return {{boltprotocol::BoltError::INVALID_ARGUMENT, "run_bulk_write requires a row source, a statement, a rows parameter name and a non-zero byte budget."}, result};
+        }
+
+        const bool caller_tx = in_explicit_transaction_;
+        const bool grouped_commits = !caller_tx && options.batches_per_commit > 0;
+        const size_t max_in_flight = std::max<size_t>(1, options.max_batches_in_flight);
+        const std::string batch_cypher = internal::make_unwind_cypher(row_cypher, options.rows_parameter);
+
+        std::optional<std::chrono::milliseconds> auto_commit_timeout;
+        if (transport_manager_ && transport_manager_->get_config().explicit_transaction_timeout_default_ms > 0) {
+            auto_commit_timeout = std::chrono::milliseconds(transport_manager_->get_config().explicit_transaction_timeout_default_ms);
+        }
+
+        // Row counts of the batches whose RUN/DISCARD replies are still outstanding, oldest first.
+        std::deque<uint64_t> in_flight_rows;
+        bool own_tx_open = false;
+        size_t batches_in_current_tx = 0;
+
+        // Replies after a failure are IGNORED by the server but still have to be read off the wire
+        // before anything else can use the connection. Only a broken connection invalidates the
+        // session; after a server FAILURE a RESET brings the connection back to READY.
+        auto fail = [&](boltprotocol::BoltError err, const std::string& msg) -> std::pair<std::pair<boltprotocol::BoltError, std::string>, BulkWriteResult> {
+            boltprotocol::SuccessMessageParams drained_success;
+            boltprotocol::FailureMessageParams drained_failure;
+            while (conn->get_pending_pipelined_responses() > 0 && !conn->is_defunct()) {
+                conn->receive_pipelined_summary(drained_success, drained_failure);
+            }
+            if (logger) logger->warn("[SessionBulk {}] Bulk write failed after {} of {} rows acknowledged: {}", conn->get_id(), result.rows_acknowledged, result.rows_submitted, msg);
+            if (conn->is_defunct()) {
+                in_explicit_transaction_ = false;
+                current_transaction_query_id_.reset();
+                _invalidate_session_due_to_connection_error(err, msg);
+            } else if (!conn->is_ready_for_queries()) {
+                // RESET also ends the transaction, whether ours or the caller's; the server would
+                // have refused to commit it after the failure anyway.
+                boltprotocol::BoltError reset_err = conn->perform_reset();
+                in_explicit_transaction_ = false;
+                current_transaction_query_id_.reset();
+                if (reset_err != boltprotocol::BoltError::SUCCESS) {
+                    _invalidate_session_due_to_connection_error(reset_err, "RESET after bulk write failure: " + conn->get_last_error_message());
+                }
+            } else if (own_tx_open) {
+                // Failed locally before anything reached the server; our transaction is still open.
+                rollback_transaction();
+            }
+            return {{err, msg}, result};
+        };
+
+        // Collects the RUN and DISCARD summaries of the oldest in-flight batch.
+        auto await_oldest_batch = [&]() -> std::pair<boltprotocol::BoltError, std::string> {
+            boltprotocol::SuccessMessageParams summary_raw;
+            boltprotocol::FailureMessageParams failure_raw;
+            for (int reply = 0; reply < 2; ++reply) {
+                boltprotocol::BoltError err = conn->receive_pipelined_summary(summary_raw, failure_raw);
+                if (err != boltprotocol::BoltError::SUCCESS) {
+                    std::string detail = failure_raw.metadata.empty() ? conn->get_last_error_message() : error::format_server_failure(failure_raw);
+                    return {err, error::format_error_message(reply == 0 ? "Bulk write RUN" : "Bulk write DISCARD", err, detail)};
+                }
+            }
+            if (!caller_tx && !grouped_commits) {
+                auto it_bookmark = summary_raw.metadata.find("bookmark");
+                if (it_bookmark != summary_raw.metadata.end() && std::holds_alternative<std::string>(it_bookmark->second)) {
+                    update_bookmarks({std::get<std::string>(it_bookmark->second)});
+                }
+            }
+            result.rows_acknowledged += in_flight_rows.front();
+            ++result.batches_acknowledged;
+            in_flight_rows.pop_front();
+            return {boltprotocol::BoltError::SUCCESS, ""};
+        };
+
+        auto drain_in_flight = [&]() -> std::pair<boltprotocol::BoltError, std::string> {
+            while (!in_flight_rows.empty()) {
+                auto ack = await_oldest_batch();
+                if (ack.first != boltprotocol::BoltError::SUCCESS) return ack;
+            }
+            return {boltprotocol::BoltError::SUCCESS, ""};
+        };
+
+        internal::BulkBatchBuilder builder(options);
+        std::vector<uint8_t> run_payload_bytes;
+        std::vector<uint8_t> discard_payload_bytes;
+        {
+            boltprotocol::DiscardMessageParams discard_p;
+            discard_p.n = -1;
+            boltprotocol::PackStreamWriter discard_writer(discard_payload_bytes);
+            boltprotocol::BoltError err = boltprotocol::serialize_discard_message(discard_p, discard_writer);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                return fail(err, error::format_error_message("Bulk write DISCARD serialization", err));
+            }
+        }
+
+        while (true) {
+            size_t batch_rows = builder.next_batch(source);
+            if (batch_rows == 0) {
+                if (builder.error() != boltprotocol::BoltError::SUCCESS) {
+                    return fail(builder.error(), error::format_error_message("Bulk write row encoding", builder.error()));
+                }
+                break;
+            }
+            size_t batch_bytes = builder.current_batch_bytes();
+
+            if (grouped_commits && !own_tx_open) {
+                auto begin_result = begin_transaction();
+                if (begin_result.first != boltprotocol::BoltError::SUCCESS) {
+                    return {begin_result, result};
+                }
+                own_tx_open = true;
+            }
+
+            boltprotocol::RunMessageParams run_p;
+            if (!in_explicit_transaction_) {
+                _fill_auto_commit_run_context(run_p, conn->get_bolt_version(), std::nullopt, auto_commit_timeout);
+            }
+            std::map<std::string, boltprotocol::Value> batch_parameters = builder.take_parameters();
+
+            run_payload_bytes.clear();
+            boltprotocol::BoltError err = _serialize_run_cached(batch_cypher, batch_parameters, run_p, conn->get_bolt_version(), run_payload_bytes);
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                return fail(err, error::format_error_message("Bulk write RUN serialization", err));
+            }
+
+            err = conn->send_request_pipelined(run_payload_bytes);
+            if (err == boltprotocol::BoltError::SUCCESS) {
+                err = conn->send_request_pipelined(discard_payload_bytes);
+            }
+            if (err != boltprotocol::BoltError::SUCCESS) {
+                return fail(err, error::format_error_message("Bulk write send", err, conn->get_last_error_message()));
+            }
+            in_flight_rows.push_back(batch_rows);
+            result.rows_submitted += batch_rows;
+            ++result.batches_submitted;
+            ++batches_in_current_tx;
+            if (logger) logger->trace("[SessionBulk {}] Batch {} queued: {} rows, {} bytes, {} in flight.", conn->get_id(), result.batches_submitted, batch_rows, batch_bytes, in_flight_rows.size());
+
+            while (in_flight_rows.size() >= max_in_flight) {
+                auto ack = await_oldest_batch();
+                if (ack.first != boltprotocol::BoltError::SUCCESS) return fail(ack.first, ack.second);
+            }
+
+            if (grouped_commits && batches_in_current_tx >= options.batches_per_commit) {
+                auto drained = drain_in_flight();
+                if (drained.first != boltprotocol::BoltError::SUCCESS) return fail(drained.first, drained.second);
+                own_tx_open = false;
+                auto commit_result = commit_transaction();
+                if (commit_result.first != boltprotocol::BoltError::SUCCESS) {
+                    return {commit_result, result};
+                }
+                ++result.transactions_committed;
+                batches_in_current_tx = 0;
+            }
+        }
+
+        auto drained = drain_in_flight();
+        if (drained.first != boltprotocol::BoltError::SUCCESS) return fail(drained.first, drained.second);
+        if (own_tx_open) {
+            own_tx_open = false;
+            auto commit_result = commit_transaction();
+            if (commit_result.first != boltprotocol::BoltError::SUCCESS) {
+                return {commit_result, result};
+            }
+            ++result.transactions_committed;
+        }
+
+        if (logger) logger->debug("[SessionBulk {}] Bulk write finished: {} rows in {} batches, {} commits.", conn->get_id(), result.rows_acknowledged, result.batches_acknowledged, result.transactions_committed);
+        return {{boltprotocol::BoltError::SUCCESS, ""}, result};
+    }
+
+}  // namespace neo4j_bolt_transport
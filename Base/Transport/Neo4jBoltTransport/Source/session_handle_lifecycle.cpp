@@ -10,7 +10,7 @@
 namespace neo4j_bolt_transport {
 
     SessionHandle::SessionHandle(Neo4jBoltTransport* transport_mgr, internal::BoltPhysicalConnection::PooledConnection conn_ptr, config::SessionParameters params_val)
-        : transport_manager_(transport_mgr), connection_(std::move(conn_ptr)), session_params_(std::move(params_val)), current_bookmarks_(session_params_.initial_bookmarks) {  // 从会话参数初始化书签
+        : transport_manager_(transport_mgr), connection_(std::move(conn_ptr)), session_params_(std::move(params_val)), current_bookmarks_(session_params_.initial_bookmarks), prepared_run_cache_(session_params_.prepared_query_cache_size) {  // 从会话参数初始化书签
 
         std::shared_ptr<spdlog::logger> drv_logger = nullptr;
         if (transport_manager_ && transport_manager_->get_config().logger) {  // 安全访问 logger
@@ -64,7 +64,8 @@ namespace neo4j_bolt_transport {
           current_transaction_query_id_(other.current_transaction_query_id_),
           current_bookmarks_(std::move(other.current_bookmarks_)),
           is_closed_(other.is_closed_),
-          connection_is_valid_(other.connection_is_valid_) {
+          connection_is_valid_(other.connection_is_valid_),
+          prepared_run_cache_(std::move(other.prepared_run_cache_)) {
         std::shared_ptr<spdlog::logger> logger = nullptr;
         if (connection_ && connection_->get_logger())
             logger = connection_->get_logger();
@@ -97,6 +98,7 @@ namespace neo4j_bolt_transport {
             current_bookmarks_ = std::move(other.current_bookmarks_);
             is_closed_ = other.is_closed_;
             connection_is_valid_ = other.connection_is_valid_;
+            prepared_run_cache_ = std::move(other.prepared_run_cache_);
 
             other.transport_manager_ = nullptr;  // other 现在无效
             other.is_closed_ = true;
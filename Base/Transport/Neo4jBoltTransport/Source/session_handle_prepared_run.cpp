@@ -0,0 +1,13 @@
+#include "neo4j_bolt_transport/session_handle.h"
+
+namespace neo4j_bolt_transport {
+
+    boltprotocol::BoltError SessionHandle::_serialize_run_cached(const std::string& cypher,
+                                                                 const std::map<std::string, boltprotocol::Value>& parameters,
+                                                                 const boltprotocol::RunMessageParams& extra_source,
+                                                                 const boltprotocol::versions::Version& bolt_version,
+                                                                 std::vector<uint8_t>& out_payload) {
+        return prepared_run_cache_.serialize(cypher, parameters, extra_source, bolt_version, out_payload);
+    }
+
+}  // namespace neo4j_bolt_transport
@@ -0,0 +1,118 @@
+#include <utility>
+
+#include "boltprotocol/message_serialization.h"
+#include "boltprotocol/packstream_reader.h"
+#include "neo4j_bolt_transport/error/neo4j_error_util.h"
+#include "neo4j_bolt_transport/neo4j_bolt_transport.h"
+#include "neo4j_bolt_transport/session_handle.h"
+
+namespace neo4j_bolt_transport {
+
+    std::pair<std::pair<boltprotocol::BoltError, std::string>, ResultSummary> SessionHandle::run_query_stream(const std::string& cypher,
+                                                                                                              const std::map<std::string, boltprotocol::Value>& parameters,
+                                                                                                              const RecordSink& sink,
+                                                                                                              const std::optional<TransactionConfigOverrides>& tx_config_overrides) {
+        std::shared_ptr<spdlog::logger> logger = nullptr;
+        std::string srv_addr_cache = "unknown_server:0";
+        boltprotocol::versions::Version bolt_ver_cache(0, 0);
+        bool utc_patch_cache = false;
+
+        std::pair<boltprotocol::BoltError, std::string> conn_check_pair;
+        internal::BoltPhysicalConnection* conn = _get_valid_connection_for_operation(conn_check_pair, "run_query_stream (initial check)");
+        if (conn) {
+            logger = conn->get_logger();
+            srv_addr_cache = conn->get_config().target_host + ":" + std::to_string(conn->get_config().target_port);
+            bolt_ver_cache = conn->get_bolt_version();
+            utc_patch_cache = conn->is_utc_patch_active();
+        } else if (transport_manager_ && transport_manager_->get_config().logger) {
+            logger = transport_manager_->get_config().logger;
+        }
+
+        auto make_summary = [&](boltprotocol::SuccessMessageParams&& raw) {
+            return ResultSummary(std::move(raw), bolt_ver_cache, utc_patch_cache, srv_addr_cache, session_params_.database_name);
+        };
+
+        if (!conn) {
+            if (logger) logger->warn("[SessionExecSink] run_query_stream: Connection unavailable. Error: {}, Msg: {}", static_cast<int>(conn_check_pair.first), conn_check_pair.second);
+            return {conn_check_pair, make_summary({})};
+        }
+        if (!sink) {
+            return {{boltprotocol::BoltError::INVALID_ARGUMENT, "run_query_stream requires a record sink."}, make_summary({})};
+        }
+
+        boltprotocol::SuccessMessageParams run_summary_raw;
+        boltprotocol::FailureMessageParams run_failure_details_raw;
+        std::pair<boltprotocol::BoltError, std::string> run_result;
+        std::optional<int64_t> qid_for_pull;
+
+        if (is_in_transaction()) {
+            run_result = _prepare_explicit_tx_run(cypher, parameters, run_summary_raw, run_failure_details_raw);
+            qid_for_pull = current_transaction_query_id_;
+        } else {
+            std::optional<std::map<std::string, boltprotocol::Value>> metadata_to_pass;
+            std::optional<std::chrono::milliseconds> timeout_to_pass;
+            if (tx_config_overrides.has_value()) {
+                metadata_to_pass = tx_config_overrides->metadata;
+                timeout_to_pass = tx_config_overrides->timeout;
+            } else if (transport_manager_ && transport_manager_->get_config().explicit_transaction_timeout_default_ms > 0) {
+                timeout_to_pass = std::chrono::milliseconds(transport_manager_->get_config().explicit_transaction_timeout_default_ms);
+            }
+            run_result = _prepare_auto_commit_run(cypher, parameters, metadata_to_pass, timeout_to_pass, run_summary_raw, run_failure_details_raw);
+            auto it_qid = run_summary_raw.metadata.find("qid");
+            if (it_qid != run_summary_raw.metadata.end() && std::holds_alternative<int64_t>(it_qid->second)) {
+                qid_for_pull = std::get<int64_t>(it_qid->second);
+            }
+        }
+        if (run_result.first != boltprotocol::BoltError::SUCCESS) {
+            if (logger) logger->warn("[SessionExecSink] run_query_stream: RUN failed. Error: {}, Msg: {}", static_cast<int>(run_result.first), run_result.second);
+            return {run_result, make_summary(std::move(run_summary_raw))};
+        }
+
+        // Field names are resolved once and shared by every view handed to the sink.
+        std::vector<std::string> field_names;
+        auto it_fields = run_summary_raw.metadata.find("fields");
+        if (it_fields != run_summary_raw.metadata.end() && std::holds_alternative<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second)) {
+            const auto& list_ptr = std::get<std::shared_ptr<boltprotocol::BoltList>>(it_fields->second);
+            if (list_ptr) {
+                field_names.reserve(list_ptr->elements.size());
+                for (const auto& field_val : list_ptr->elements) {
+                    if (std::holds_alternative<std::string>(field_val)) {
+                        field_names.push_back(std::get<std::string>(field_val));
+                    }
+                }
+            }
+        }
+
+        int64_t fetch_n = session_params_.default_fetch_size > 0 ? session_params_.default_fetch_size : 1000;
+        if (session_params_.default_fetch_size == -1) fetch_n = -1;
+
+        uint64_t records_delivered = 0;
+        boltprotocol::RecordMessageParams reusable_record;
+        auto record_processor = [&](boltprotocol::MessageTag /*tag*/, const std::vector<uint8_t>& rec_payload, internal::BoltPhysicalConnection& /*connection_ref*/) {
+            boltprotocol::PackStreamReader reader(rec_payload);
+            if (boltprotocol::deserialize_record_message(reader, reusable_record) != boltprotocol::BoltError::SUCCESS) {
+                if (logger) logger->error("[SessionExecSink] Failed to deserialize RECORD message during PULL.");
+                return boltprotocol::BoltError::DESERIALIZATION_ERROR;
+            }
+            ++records_delivered;
+            return sink(BoltRecordView(reusable_record.fields, field_names));
+        };
+
+        boltprotocol::SuccessMessageParams pull_summary_raw;
+        bool server_has_more = true;
+        while (server_has_more) {
+            pull_summary_raw.metadata.clear();
+            auto pull_result = _stream_pull_with_handler(qid_for_pull, fetch_n, record_processor, pull_summary_raw);
+            if (pull_result.first != boltprotocol::BoltError::SUCCESS) {
+                if (logger) logger->warn("[SessionExecSink] run_query_stream: PULL failed after {} records. Error: {}, Msg: {}", records_delivered, static_cast<int>(pull_result.first), pull_result.second);
+                return {pull_result, make_summary(std::move(pull_summary_raw))};
+            }
+            auto it_has_more = pull_summary_raw.metadata.find("has_more");
+            server_has_more = it_has_more != pull_summary_raw.metadata.end() && std::holds_alternative<bool>(it_has_more->second) && std::get<bool>(it_has_more->second);
+        }
+
+        if (logger) logger->trace("[SessionExecSink] run_query_stream delivered {} records.", records_delivered);
+        return {{boltprotocol::BoltError::SUCCESS, ""}, make_summary(std::move(pull_summary_raw))};
+    }
+
+}  // namespace neo4j_bolt_transport
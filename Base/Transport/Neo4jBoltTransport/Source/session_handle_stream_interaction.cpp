@@ -9,28 +9,16 @@
 
 namespace neo4j_bolt_transport {
 
-    std::pair<boltprotocol::BoltError, std::string> SessionHandle::_prepare_auto_commit_run(const std::string& cypher,
-                                                                                            const std::map<std::string, boltprotocol::Value>& parameters,
-                                                                                            const std::optional<std::map<std::string, boltprotocol::Value>>& tx_metadata,
-                                                                                            const std::optional<std::chrono::milliseconds>& tx_timeout,
-                                                                                            boltprotocol::SuccessMessageParams& out_run_summary_raw,
-                                                                                            boltprotocol::FailureMessageParams& out_failure_details_raw) {
-        std::pair<boltprotocol::BoltError, std::string> conn_err_pair;
-        internal::BoltPhysicalConnection* conn = _get_valid_connection_for_operation(conn_err_pair, "_prepare_auto_commit_run");
-        if (!conn) {
-            return conn_err_pair;
-        }
-        auto logger = conn->get_logger();
-
-        boltprotocol::RunMessageParams run_p;
-        run_p.cypher_query = cypher;
-        run_p.parameters = parameters;
+    void SessionHandle::_fill_auto_commit_run_context(boltprotocol::RunMessageParams& run_p,
+                                                      const boltprotocol::versions::Version& bolt_version,
+                                                      const std::optional<std::map<std::string, boltprotocol::Value>>& tx_metadata,
+                                                      const std::optional<std::chrono::milliseconds>& tx_timeout) const {
         run_p.bookmarks = current_bookmarks_;
         if (session_params_.database_name.has_value()) run_p.db = session_params_.database_name;
         if (session_params_.impersonated_user.has_value()) run_p.imp_user = session_params_.impersonated_user;
 
         // Compare with a constructed Version object for Bolt 5.0
-        if (conn->get_bolt_version() < boltprotocol::versions::Version(5, 0)) {
+        if (bolt_version < boltprotocol::versions::Version(5, 0)) {
             if (session_params_.default_access_mode == config::AccessMode::READ) {
                 run_p.mode = "r";
             }
@@ -42,10 +30,26 @@ namespace neo4j_bolt_transport {
         if (tx_timeout.has_value()) {
             run_p.tx_timeout = static_cast<int64_t>(tx_timeout.value().count());
         }
+    }
+
+    std::pair<boltprotocol::BoltError, std::string> SessionHandle::_prepare_auto_commit_run(const std::string& cypher,
+                                                                                            const std::map<std::string, boltprotocol::Value>& parameters,
+                                                                                            const std::optional<std::map<std::string, boltprotocol::Value>>& tx_metadata,
+                                                                                            const std::optional<std::chrono::milliseconds>& tx_timeout,
+                                                                                            boltprotocol::SuccessMessageParams& out_run_summary_raw,
+                                                                                            boltprotocol::FailureMessageParams& out_failure_details_raw) {
+        std::pair<boltprotocol::BoltError, std::string> conn_err_pair;
+        internal::BoltPhysicalConnection* conn = _get_valid_connection_for_operation(conn_err_pair, "_prepare_auto_commit_run");
+        if (!conn) {
+            return conn_err_pair;
+        }
+        auto logger = conn->get_logger();
+
+        boltprotocol::RunMessageParams run_p;
+        _fill_auto_commit_run_context(run_p, conn->get_bolt_version(), tx_metadata, tx_timeout);
 
         std::vector<uint8_t> run_payload_bytes;
-        boltprotocol::PackStreamWriter run_writer(run_payload_bytes);
-        boltprotocol::BoltError err = boltprotocol::serialize_run_message(run_p, run_writer, conn->get_bolt_version());
+        boltprotocol::BoltError err = _serialize_run_cached(cypher, parameters, run_p, conn->get_bolt_version(), run_payload_bytes);
         if (err != boltprotocol::BoltError::SUCCESS) {
             std::string msg = error::format_error_message("Auto-commit RUN serialization", err);
             _invalidate_session_due_to_connection_error(err, msg);
@@ -87,13 +91,11 @@ namespace neo4j_bolt_transport {
             return {boltprotocol::BoltError::INVALID_ARGUMENT, "Cannot run query in explicit TX mode; not in transaction."};
         }
 
-        boltprotocol::RunMessageParams run_p;
-        run_p.cypher_query = cypher;
-        run_p.parameters = parameters;
+        // Inside a transaction RUN carries no extra fields.
+        const boltprotocol::RunMessageParams run_p;
 
         std::vector<uint8_t> run_payload_bytes;
-        boltprotocol::PackStreamWriter run_w(run_payload_bytes);
-        boltprotocol::BoltError err = boltprotocol::serialize_run_message(run_p, run_w, conn->get_bolt_version());
+        boltprotocol::BoltError err = _serialize_run_cached(cypher, parameters, run_p, conn->get_bolt_version(), run_payload_bytes);
         if (err != boltprotocol::BoltError::SUCCESS) {
             std::string msg = error::format_error_message("Explicit TX RUN serialization", err);
             _invalidate_session_due_to_connection_error(err, msg);
@@ -140,6 +142,32 @@ namespace neo4j_bolt_transport {
         }
         auto logger = conn->get_logger();
 
+        auto record_processor = [&](boltprotocol::MessageTag /*tag*/, const std::vector<uint8_t>& rec_payload, internal::BoltPhysicalConnection& /*connection_ref*/) {
+            boltprotocol::RecordMessageParams rec;
+            boltprotocol::PackStreamReader r(rec_payload);
+            if (boltprotocol::deserialize_record_message(r, rec) == boltprotocol::BoltError::SUCCESS) {
+                out_records.push_back(std::move(rec));
+                return boltprotocol::BoltError::SUCCESS;
+            }
+            if (logger) logger->error("[SessionStream {}] Failed to deserialize RECORD message during PULL.", conn->get_id());
+            return boltprotocol::BoltError::DESERIALIZATION_ERROR;
+        };
+
+        auto result = _stream_pull_with_handler(qid, n, record_processor, out_pull_summary_raw);
+        if (result.first == boltprotocol::BoltError::SUCCESS && logger) {
+            logger->trace("[SessionStream {}] Records received in PULL: {}", conn->get_id(), out_records.size());
+        }
+        return result;
+    }
+
+    std::pair<boltprotocol::BoltError, std::string> SessionHandle::_stream_pull_with_handler(std::optional<int64_t> qid, int64_t n, internal::BoltPhysicalConnection::MessageHandler record_handler, boltprotocol::SuccessMessageParams& out_pull_summary_raw) {
+        std::pair<boltprotocol::BoltError, std::string> conn_err_pair;
+        internal::BoltPhysicalConnection* conn = _get_valid_connection_for_operation(conn_err_pair, "_stream_pull_with_handler");
+        if (!conn) {
+            return conn_err_pair;
+        }
+        auto logger = conn->get_logger();
+
         boltprotocol::PullMessageParams pull_p;
         pull_p.n = n;
         pull_p.qid = qid;
@@ -156,19 +184,7 @@ namespace neo4j_bolt_transport {
         if (logger) logger->trace("[SessionStream {}] Sending PULL (n={}, qid={}).", conn->get_id(), n, qid.has_value() ? std::to_string(qid.value()) : "implicit");
 
         boltprotocol::FailureMessageParams failure_details_raw;
-
-        auto record_processor = [&](boltprotocol::MessageTag /*tag*/, const std::vector<uint8_t>& rec_payload, internal::BoltPhysicalConnection& /*connection_ref*/) {
-            boltprotocol::RecordMessageParams rec;
-            boltprotocol::PackStreamReader r(rec_payload);
-            if (boltprotocol::deserialize_record_message(r, rec) == boltprotocol::BoltError::SUCCESS) {
-                out_records.push_back(std::move(rec));
-                return boltprotocol::BoltError::SUCCESS;
-            }
-            if (logger) logger->error("[SessionStream {}] Failed to deserialize RECORD message during PULL.", conn->get_id());
-            return boltprotocol::BoltError::DESERIALIZATION_ERROR;
-        };
-
-        err = conn->send_request_receive_stream(pull_payload_bytes, record_processor, out_pull_summary_raw, failure_details_raw);
+        err = conn->send_request_receive_stream(pull_payload_bytes, std::move(record_handler), out_pull_summary_raw, failure_details_raw);
 
         if (err != boltprotocol::BoltError::SUCCESS) {
             std::string msg = error::format_error_message("PULL stream processing", err, conn->get_last_error_message());
@@ -193,7 +209,7 @@ namespace neo4j_bolt_transport {
                 if (it_has_more != out_pull_summary_raw.metadata.end() && std::holds_alternative<bool>(it_has_more->second)) {
                     has_more = std::get<bool>(it_has_more->second);
                 }
-                logger->trace("[SessionStream {}] PULL successful. Records received: {}. HasMore: {}", conn->get_id(), out_records.size(), has_more);
+                logger->trace("[SessionStream {}] PULL successful. HasMore: {}", conn->get_id(), has_more);
             }
             return {boltprotocol::BoltError::SUCCESS, ""};
         } else {